@@ -54,7 +54,8 @@ QString training, campaign, campaignScript, campaignTeam; // TODO: Cleaner solut
 HWGame::HWGame(GameUIConfig * config, GameCFGWidget * gamecfg, QString ammo, TeamSelWidget* pTeamSelWidget) :
     TCPBase(true, 0),
     ammostr(ammo),
-    m_pTeamSelWidget(pTeamSelWidget)
+    m_pTeamSelWidget(pTeamSelWidget),
+    m_demoFile(0)
 {
     this->config = config;
     this->gamecfg = gamecfg;
@@ -75,22 +76,31 @@ HWGame::~HWGame()
 
 void HWGame::onClientDisconnect()
 {
+    // the played file wasn't kept in memory, it's only read back in front
+    // of the record by whoever needs all of it
+    QString playedFile;
+    if (m_demoFile)
+    {
+        playedFile = m_demoFile->fileName();
+        m_demoFile->close();
+    }
+
     switch (gameType)
     {
         case gtDemo:
             // for video recording we need demo anyway
-            emit HaveRecord(rtNeither, demo);
+            emit HaveRecord(rtNeither, demo, playedFile);
             break;
         case gtNet:
-            emit HaveRecord(rtDemo, demo);
+            emit HaveRecord(rtDemo, demo, playedFile);
             break;
         default:
             if (gameState == gsInterrupted || gameState == gsHalted)
-                emit HaveRecord(rtSave, demo);
+                emit HaveRecord(rtSave, demo, playedFile);
             else if (gameState == gsFinished)
-                emit HaveRecord(rtDemo, demo);
+                emit HaveRecord(rtDemo, demo, playedFile);
             else
-                emit HaveRecord(rtNeither, demo);
+                emit HaveRecord(rtNeither, demo, playedFile);
     }
     SetGameState(gsStopped);
 }
@@ -359,13 +369,9 @@ void HWGame::FromNetChat(const QString & msg)
 
 void HWGame::onClientRead()
 {
-    quint8 msglen;
-    quint32 bufsize;
-    while (!readbuffer.isEmpty() && ((bufsize = readbuffer.size()) > 0) &&
-            ((msglen = readbuffer.data()[0]) < bufsize))
+    QByteArray msg;
+    while (readbuffer.takeMessage(msg))
     {
-        QByteArray msg = readbuffer.left(msglen + 1);
-        readbuffer.remove(0, msglen + 1);
         ParseMessage(msg);
     }
 
@@ -389,8 +395,7 @@ QStringList HWGame::getArguments()
     QString nick = config->netNick().toUtf8().toBase64();
 
     arguments << "--internal"; //Must be passed as first argument
-    arguments << "--port";
-    arguments << QString("%1").arg(ipc_port);
+    arguments << ipcArguments();
     arguments << "--prefix";
     arguments << datadir->absolutePath();
     arguments << "--user-prefix";
@@ -443,15 +448,19 @@ QStringList HWGame::getArguments()
 void HWGame::PlayDemo(const QString & demofilename, bool isSave)
 {
     gameType = isSave ? gtSave : gtDemo;
-    QFile demofile(demofilename);
-    if (!demofile.open(QIODevice::ReadOnly))
+    delete m_demoFile;
+    m_demoFile = new QFile(demofilename, this);
+    if (!m_demoFile->open(QIODevice::ReadOnly))
     {
         emit ErrorMessage(tr("Cannot open demofile %1").arg(demofilename));
+        delete m_demoFile;
+        m_demoFile = 0;
         return ;
     }
 
-    // read demo
-    toSendBuf = demofile.readAll();
+    // the demo is read in chunks while the engine consumes it
+    toSendBuf.clear();
+    streamToClient(m_demoFile);
 
     // run engine
     demo.clear();
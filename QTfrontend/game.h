@@ -20,6 +20,7 @@
 #define GAME_H
 
 #include <QString>
+#include <QFile>
 #include "team.h"
 #include "namegen.h"
 
@@ -96,7 +97,8 @@ class HWGame : public TCPBase
         void SendTeamMessage(const QString & msg);
         void GameStateChanged(GameState gameState);
         void GameStats(char type, const QString & info);
-        void HaveRecord(RecordType type, const QByteArray & record);
+        // record doesn't include the demo or save file played, if any
+        void HaveRecord(RecordType type, const QByteArray & record, const QString & playedFile);
         void ErrorMessage(const QString &);
         void CampStateChanged(int);
         void SendConsoleCommand(const QString & command);
@@ -113,6 +115,7 @@ class HWGame : public TCPBase
         TeamSelWidget* m_pTeamSelWidget;
         GameType gameType;
         QByteArray m_netSendBuffer;
+        QFile * m_demoFile;
 
         void commonConfig();
         void SendConfig();
@@ -1676,16 +1676,25 @@ void HWForm::CreateGame(GameCFGWidget * gamecfg, TeamSelWidget* pTeamSelWidget,
     connect(game, SIGNAL(GameStateChanged(GameState)), this, SLOT(GameStateChanged(GameState)));
     connect(game, SIGNAL(GameStats(char, const QString &)), ui.pageGameStats, SLOT(GameStats(char, const QString &)));
     connect(game, SIGNAL(ErrorMessage(const QString &)), this, SLOT(ShowFatalErrorMessage(const QString &)), Qt::QueuedConnection);
-    connect(game, SIGNAL(HaveRecord(RecordType, const QByteArray &)), this, SLOT(GetRecord(RecordType, const QByteArray &)));
+    connect(game, SIGNAL(HaveRecord(RecordType, const QByteArray &, const QString &)), this, SLOT(GetRecord(RecordType, const QByteArray &, const QString &)));
     m_lastDemo = QByteArray();
 }
 
-void HWForm::GetRecord(RecordType type, const QByteArray & record)
+void HWForm::GetRecord(RecordType type, const QByteArray & record, const QString & playedFile)
 {
+    // only read the demo or save played back in if the record is used
+    QByteArray fullRecord = record;
+    if (!playedFile.isEmpty() && ((type != rtNeither) || ui.pageVideos->haveVideosToEncode()))
+    {
+        QFile played(playedFile);
+        if (played.open(QIODevice::ReadOnly))
+            fullRecord.prepend(played.readAll());
+    }
+
     if (type != rtNeither)
     {
         QString filename;
-        QByteArray demo = record;
+        QByteArray demo = fullRecord;
         QString recordFileName =
             config->appendDateTimeToRecordName() ?
             QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm") :
@@ -1718,7 +1727,7 @@ void HWForm::GetRecord(RecordType type, const QByteArray & record)
         }
     }
 
-    ui.pageVideos->startEncoding(record);
+    ui.pageVideos->startEncoding(fullRecord);
 }
 
 void HWForm::startTraining(const QString & scriptName)
@@ -121,7 +121,7 @@ class HWForm : public QMainWindow
         void GameStateChanged(GameState gameState);
         void ForcedDisconnect(const QString & reason);
         void ShowFatalErrorMessage(const QString &);
-        void GetRecord(RecordType type, const QByteArray & record);
+        void GetRecord(RecordType type, const QByteArray & record, const QString & playedFile);
         void CreateNetGame();
         void UpdateWeapons();
         void onFrontendFullscreen(bool value);
@@ -39,6 +39,16 @@ bool PlayersListModel::setData(const QModelIndex &index, const QVariant &value,
     if(!index.isValid() || index.row() < 0 || index.row() >= rowCount() || index.column() != 0)
         return false;
 
+    if(role == Qt::DisplayRole)
+    {
+        QString oldNick = m_data.at(index.row()).value(Qt::DisplayRole).toString();
+
+        if(m_nicknameRows.value(oldNick, -1) == index.row())
+            m_nicknameRows.remove(oldNick);
+
+        m_nicknameRows.insert(value.toString(), index.row());
+    }
+
     m_data[index.row()].insert(role, value);
 
     emit dataChanged(index, index);
@@ -63,6 +73,8 @@ bool PlayersListModel::insertRows(int row, int count, const QModelIndex &parent)
     for(int i = 0; i < count; ++i)
         m_data.insert(row, DataEntry());
 
+    reindexRows(row + count);
+
     endInsertRows();
 
     return true;
@@ -76,8 +88,17 @@ bool PlayersListModel::removeRows(int row, int count, const QModelIndex &parent)
 
     beginRemoveRows(parent, row, row + count - 1);
 
-    for(int i = 0; i < count; ++i)
-        m_data.removeAt(row);
+    for(int i = row; i < row + count; ++i)
+    {
+        QString nick = m_data.at(i).value(Qt::DisplayRole).toString();
+
+        if(m_nicknameRows.value(nick, -1) == i)
+            m_nicknameRows.remove(nick);
+    }
+
+    m_data.erase(m_data.begin() + row, m_data.begin() + row + count);
+
+    reindexRows(row);
 
     endRemoveRows();
 
@@ -86,24 +107,63 @@ bool PlayersListModel::removeRows(int row, int count, const QModelIndex &parent)
 
 QModelIndex PlayersListModel::nicknameIndex(const QString & nickname)
 {
-    QModelIndexList mil = match(index(0), Qt::DisplayRole, nickname, 1, Qt::MatchExactly);
+    int row = m_nicknameRows.value(nickname, -1);
 
-    if(mil.size() > 0)
-        return mil[0];
+    if(row >= 0)
+        return index(row);
     else
         return QModelIndex();
 }
 
+// rows from 'from' on have moved, point their nicknames at the new positions
+void PlayersListModel::reindexRows(int from)
+{
+    for(int i = from; i < m_data.size(); ++i)
+    {
+        QString nick = m_data.at(i).value(Qt::DisplayRole).toString();
+
+        if(!nick.isEmpty())
+            m_nicknameRows.insert(nick, i);
+    }
+}
+
+void PlayersListModel::emitRowsChanged(int first, int last)
+{
+    if(first <= last)
+        emit dataChanged(index(first), index(last));
+}
+
 void PlayersListModel::addPlayer(const QString & nickname, bool notify)
 {
-    insertRow(rowCount());
+    addPlayers(QStringList() << nickname, notify);
+}
 
-    QModelIndex mi = index(rowCount() - 1);
-    setData(mi, nickname);
 
-    checkFriendIgnore(mi);
+void PlayersListModel::addPlayers(const QStringList & nicknames, bool notify)
+{
+    if(nicknames.isEmpty())
+        return;
+
+    int first = m_data.size();
+
+    // all rows are filled before endInsertRows(), so the sorting proxies
+    // see one insertion and no further dataChanged for them
+    beginInsertRows(QModelIndex(), first, first + nicknames.size() - 1);
+
+    foreach(const QString & nick, nicknames)
+    {
+        DataEntry entry;
+        entry.insert(Qt::DisplayRole, nick);
+        checkFriendIgnore(entry);
 
-    emit nickAddedLobby(nickname, notify);
+        m_nicknameRows.insert(nick, m_data.size());
+        m_data.append(entry);
+    }
+
+    endInsertRows();
+
+    foreach(const QString & nick, nicknames)
+        emit nickAddedLobby(nick, notify);
 }
 
 
@@ -121,21 +181,84 @@ void PlayersListModel::removePlayer(const QString & nickname, const QString &msg
 }
 
 
+void PlayersListModel::removePlayers(const QStringList & nicknames)
+{
+    QSet<int> rowSet;
+
+    foreach(const QString & nick, nicknames)
+    {
+        emit nickRemovedLobby(nick);
+
+        int row = m_nicknameRows.value(nick, -1);
+        if(row >= 0)
+            rowSet.insert(row);
+    }
+
+    QList<int> rows = rowSet.toList();
+    qSort(rows);
+
+    // remove from the bottom up, one call per run of adjacent rows
+    int i = rows.size() - 1;
+    while(i >= 0)
+    {
+        int last = rows[i];
+        int first = last;
+
+        while(i > 0 && rows[i - 1] == first - 1)
+            first = rows[--i];
+
+        removeRows(first, last - first + 1);
+        --i;
+    }
+}
+
+
 void PlayersListModel::playerJoinedRoom(const QString & nickname, bool notify)
 {
     QModelIndex mi = nicknameIndex(nickname);
 
     if(mi.isValid())
     {
-        setData(mi, true, RoomFilterRole);
-        updateIcon(mi);
-        updateSortData(mi);
+        DataEntry & entry = m_data[mi.row()];
+        entry.insert(RoomFilterRole, true);
+        updateIcon(entry);
+        updateSortData(entry);
+
+        emit dataChanged(mi, mi);
     }
 
     emit nickAdded(nickname, notify);
 }
 
 
+void PlayersListModel::playersJoinedRoom(const QStringList & nicknames, bool notify)
+{
+    int first = m_data.size(), last = -1;
+
+    foreach(const QString & nick, nicknames)
+    {
+        int row = m_nicknameRows.value(nick, -1);
+
+        if(row >= 0)
+        {
+            DataEntry & entry = m_data[row];
+            entry.insert(RoomFilterRole, true);
+            updateIcon(entry);
+            updateSortData(entry);
+
+            first = qMin(first, row);
+            last = qMax(last, row);
+        }
+    }
+
+    emitRowsChanged(first, last);
+
+    // never notify about ourselves
+    foreach(const QString & nick, nicknames)
+        emit nickAdded(nick, notify && (nick != m_nickname));
+}
+
+
 void PlayersListModel::playerLeftRoom(const QString & nickname)
 {
     emit nickRemoved(nickname);
@@ -144,57 +267,74 @@ void PlayersListModel::playerLeftRoom(const QString & nickname)
 
     if(mi.isValid())
     {
-        setData(mi, false, RoomFilterRole);
-        setData(mi, false, RoomAdmin);
-        setData(mi, false, Ready);
-        setData(mi, false, InGame);
-        updateIcon(mi);
+        DataEntry & entry = m_data[mi.row()];
+        entry.insert(RoomFilterRole, false);
+        entry.insert(RoomAdmin, false);
+        entry.insert(Ready, false);
+        entry.insert(InGame, false);
+        updateIcon(entry);
+
+        emit dataChanged(mi, mi);
     }
 }
 
 
 void PlayersListModel::setFlag(const QString &nickname, StateFlag flagType, bool isSet)
 {
-    if(flagType == Friend)
-    {
-        if(isSet)
-            m_friendsSet.insert(nickname.toLower());
-        else
-            m_friendsSet.remove(nickname.toLower());
+    setFlag(QStringList() << nickname, flagType, isSet);
+}
 
-        saveSet(m_friendsSet, "friends");
-    }
-    else if(flagType == Ignore)
+
+void PlayersListModel::setFlag(const QStringList & nicknames, StateFlag flagType, bool isSet)
+{
+    if(flagType == Friend || flagType == Ignore)
     {
-        if(isSet)
-            m_ignoredSet.insert(nickname.toLower());
-        else
-            m_ignoredSet.remove(nickname.toLower());
+        QSet<QString> & set = (flagType == Friend) ? m_friendsSet : m_ignoredSet;
 
-        saveSet(m_ignoredSet, "ignore");
+        foreach(const QString & nick, nicknames)
+            if(isSet)
+                set.insert(nick.toLower());
+            else
+                set.remove(nick.toLower());
+
+        saveSet(set, (flagType == Friend) ? "friends" : "ignore");
     }
 
-    QModelIndex mi = nicknameIndex(nickname);
+    bool affectsSorting = flagType == Friend || flagType == ServerAdmin
+            || flagType == Ignore || flagType == RoomAdmin;
 
-    if(mi.isValid())
+    int first = m_data.size(), last = -1;
+
+    foreach(const QString & nick, nicknames)
     {
-        setData(mi, isSet, flagType);
+        int row = m_nicknameRows.value(nick, -1);
+
+        if(row < 0)
+            continue;
+
+        DataEntry & entry = m_data[row];
+        entry.insert(flagType, isSet);
 
-        if(flagType == Friend || flagType == ServerAdmin
-                || flagType == Ignore || flagType == RoomAdmin)
-            updateSortData(mi);
+        if(affectsSorting)
+            updateSortData(entry);
 
-        updateIcon(mi);
+        updateIcon(entry);
+
+        first = qMin(first, row);
+        last = qMax(last, row);
     }
+
+    // a single dataChanged per batch, so the proxies re-sort only once
+    emitRowsChanged(first, last);
 }
 
 
 bool PlayersListModel::isFlagSet(const QString & nickname, StateFlag flagType)
 {
-    QModelIndex mi = nicknameIndex(nickname);
+    int row = m_nicknameRows.value(nickname, -1);
 
-    if(mi.isValid())
-        return mi.data(flagType).toBool();
+    if(row >= 0)
+        return m_data.at(row).value(flagType).toBool();
     else if(flagType == Friend)
         return isFriend(nickname);
     else if(flagType == Ignore)
@@ -205,39 +345,46 @@ bool PlayersListModel::isFlagSet(const QString & nickname, StateFlag flagType)
 
 void PlayersListModel::resetRoomFlags()
 {
-    for(int i = rowCount() - 1; i >= 0; --i)
+    int first = m_data.size(), last = -1;
+
+    for(int i = m_data.size() - 1; i >= 0; --i)
     {
-        QModelIndex mi = index(i);
+        DataEntry & entry = m_data[i];
 
-        if(mi.data(RoomFilterRole).toBool())
+        if(entry.value(RoomFilterRole).toBool())
         {
-            setData(mi, false, RoomFilterRole);
-            setData(mi, false, RoomAdmin);
-            setData(mi, false, Ready);
-            setData(mi, false, InGame);
+            entry.insert(RoomFilterRole, false);
+            entry.insert(RoomAdmin, false);
+            entry.insert(Ready, false);
+            entry.insert(InGame, false);
 
-            updateSortData(mi);
-            updateIcon(mi);
+            updateSortData(entry);
+            updateIcon(entry);
+
+            first = qMin(first, i);
+            last = qMax(last, i);
         }
     }
+
+    emitRowsChanged(first, last);
 }
 
-void PlayersListModel::updateIcon(const QModelIndex & index)
+void PlayersListModel::updateIcon(DataEntry & entry)
 {
     quint32 iconNum = 0;
 
     QList<bool> flags;
     flags
-        << index.data(Ready).toBool()
-        << index.data(ServerAdmin).toBool()
-        << index.data(RoomAdmin).toBool()
-        << index.data(Registered).toBool()
-        << index.data(Friend).toBool()
-        << index.data(Ignore).toBool()
-        << index.data(InGame).toBool()
-        << index.data(RoomFilterRole).toBool()
-        << index.data(InRoom).toBool()
-        << index.data(Contributor).toBool()
+        << entry.value(Ready).toBool()
+        << entry.value(ServerAdmin).toBool()
+        << entry.value(RoomAdmin).toBool()
+        << entry.value(Registered).toBool()
+        << entry.value(Friend).toBool()
+        << entry.value(Ignore).toBool()
+        << entry.value(InGame).toBool()
+        << entry.value(RoomFilterRole).toBool()
+        << entry.value(InRoom).toBool()
+        << entry.value(Contributor).toBool()
         ;
 
     for(int i = flags.size() - 1; i >= 0; --i)
@@ -246,7 +393,7 @@ void PlayersListModel::updateIcon(const QModelIndex & index)
 
     if(m_icons().contains(iconNum))
     {
-        setData(index, m_icons().value(iconNum), Qt::DecorationRole);
+        entry.insert(Qt::DecorationRole, m_icons().value(iconNum));
     }
     else
     {
@@ -255,66 +402,66 @@ void PlayersListModel::updateIcon(const QModelIndex & index)
 
         QPainter painter(&result);
 
-        if(index.data(RoomFilterRole).toBool())
+        if(entry.value(RoomFilterRole).toBool())
         {
-            if(index.data(InGame).toBool())
+            if(entry.value(InGame).toBool())
             {
                 painter.drawPixmap(0, 0, 16, 16, QPixmap(":/res/chat/ingame.png"));
             }
             else
             {
-                if(index.data(Ready).toBool())
+                if(entry.value(Ready).toBool())
                     painter.drawPixmap(0, 0, 16, 16, QPixmap(":/res/chat/lamp.png"));
                 else
                     painter.drawPixmap(0, 0, 16, 16, QPixmap(":/res/chat/lamp_off.png"));
             }
         } else
         { // we're in lobby
-            if(!index.data(InRoom).toBool())
+            if(!entry.value(InRoom).toBool())
                 painter.drawPixmap(0, 0, 16, 16, QPixmap(":/res/Flake.png"));
         }
 
         QString mainIconName(":/res/chat/");
 
-        if(index.data(ServerAdmin).toBool())
+        if(entry.value(ServerAdmin).toBool())
             mainIconName += "serveradmin";
         else
         {
-            if(index.data(RoomAdmin).toBool())
+            if(entry.value(RoomAdmin).toBool())
                 mainIconName += "roomadmin";
             else
                 mainIconName += "hedgehog";
 
-            if(index.data(Contributor).toBool())
+            if(entry.value(Contributor).toBool())
                 mainIconName += "contributor";
         }
 
-        if(!index.data(Registered).toBool())
+        if(!entry.value(Registered).toBool())
             mainIconName += "_gray";
 
         painter.drawPixmap(8, 0, 16, 16, QPixmap(mainIconName + ".png"));
 
-        if(index.data(Ignore).toBool())
+        if(entry.value(Ignore).toBool())
             painter.drawPixmap(8, 0, 16, 16, QPixmap(":/res/chat/ignore.png"));
         else
-        if(index.data(Friend).toBool())
+        if(entry.value(Friend).toBool())
             painter.drawPixmap(8, 0, 16, 16, QPixmap(":/res/chat/friend.png"));
 
         painter.end();
 
         QIcon icon(result);
 
-        setData(index, icon, Qt::DecorationRole);
+        entry.insert(Qt::DecorationRole, icon);
         m_icons().insert(iconNum, icon);
     }
 
-    if(index.data(Ignore).toBool())
-        setData(index, Qt::gray, Qt::ForegroundRole);
+    if(entry.value(Ignore).toBool())
+        entry.insert(Qt::ForegroundRole, QColor(Qt::gray));
     else
-    if(index.data(Friend).toBool())
-        setData(index, Qt::green, Qt::ForegroundRole);
+    if(entry.value(Friend).toBool())
+        entry.insert(Qt::ForegroundRole, QColor(Qt::green));
     else
-        setData(index, QBrush(QColor(0xff, 0xcc, 0x00)), Qt::ForegroundRole);
+        entry.insert(Qt::ForegroundRole, QBrush(QColor(0xff, 0xcc, 0x00)));
 }
 
 
@@ -326,23 +473,25 @@ QHash<quint32, QIcon> & PlayersListModel::m_icons()
 }
 
 
-void PlayersListModel::updateSortData(const QModelIndex & index)
+void PlayersListModel::updateSortData(DataEntry & entry)
 {
+    QString nick = entry.value(Qt::DisplayRole).toString();
+
     QString result = QString("%1%2%3%4%5%6")
             // room admins go first, then server admins, then friends
-            .arg(1 - index.data(RoomAdmin).toInt())
-            .arg(1 - index.data(ServerAdmin).toInt())
-            .arg(1 - index.data(Friend).toInt())
+            .arg(1 - entry.value(RoomAdmin).toInt())
+            .arg(1 - entry.value(ServerAdmin).toInt())
+            .arg(1 - entry.value(Friend).toInt())
             // ignored at bottom
-            .arg(index.data(Ignore).toInt())
+            .arg(entry.value(Ignore).toInt())
             // keep nicknames starting from non-letter character at bottom within group
             // assume there are no empty nicks in list
-            .arg(index.data(Qt::DisplayRole).toString().at(0).isLetter() ? 0 : 1)
+            .arg(nick.at(0).isLetter() ? 0 : 1)
             // sort ignoring case
-            .arg(index.data(Qt::DisplayRole).toString().toLower())
+            .arg(nick.toLower())
             ;
 
-    setData(index, result, SortRole);
+    entry.insert(SortRole, result);
 }
 
 
@@ -353,8 +502,10 @@ void PlayersListModel::setNickname(const QString &nickname)
     loadSet(m_friendsSet, "friends");
     loadSet(m_ignoredSet, "ignore");
 
-    for(int i = rowCount() - 1; i >= 0; --i)
-        checkFriendIgnore(index(i));
+    for(int i = m_data.size() - 1; i >= 0; --i)
+        checkFriendIgnore(m_data[i]);
+
+    emitRowsChanged(0, m_data.size() - 1);
 }
 
 bool PlayersListModel::isFriend(const QString & nickname)
@@ -367,13 +518,15 @@ bool PlayersListModel::isIgnored(const QString & nickname)
     return m_ignoredSet.contains(nickname.toLower());
 }
 
-void PlayersListModel::checkFriendIgnore(const QModelIndex &mi)
+void PlayersListModel::checkFriendIgnore(DataEntry & entry)
 {
-    setData(mi, isFriend(mi.data().toString()), Friend);
-    setData(mi, isIgnored(mi.data().toString()), Ignore);
+    QString nick = entry.value(Qt::DisplayRole).toString();
+
+    entry.insert(Friend, isFriend(nick));
+    entry.insert(Ignore, isIgnored(nick));
 
-    updateIcon(mi);
-    updateSortData(mi);
+    updateIcon(entry);
+    updateSortData(entry);
 }
 
 void PlayersListModel::loadSet(QSet<QString> & set, const QString & suffix)
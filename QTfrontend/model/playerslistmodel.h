@@ -6,6 +6,7 @@
 #include <QIcon>
 #include <QModelIndex>
 #include <QSet>
+#include <QStringList>
 #include <QFont>
 
 class PlayersListModel : public QAbstractListModel
@@ -39,6 +40,7 @@ public:
     QVariant data(const QModelIndex &index, int role) const;
     bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::DisplayRole);
     void setFlag(const QString & nickname, StateFlag flagType, bool isSet);
+    void setFlag(const QStringList & nicknames, StateFlag flagType, bool isSet);
     bool isFlagSet(const QString & nickname, StateFlag flagType);
 
     bool insertRow(int row, const QModelIndex &parent = QModelIndex());
@@ -49,8 +51,11 @@ public:
 
 public slots:
     void addPlayer(const QString & nickname, bool notify);
+    void addPlayers(const QStringList & nicknames, bool notify);
     void removePlayer(const QString & nickname, const QString & msg = QString());
+    void removePlayers(const QStringList & nicknames);
     void playerJoinedRoom(const QString & nickname, bool notify);
+    void playersJoinedRoom(const QStringList & nicknames, bool notify);
     void playerLeftRoom(const QString & nickname);
     void resetRoomFlags();
     void setNickname(const QString & nickname);
@@ -66,15 +71,18 @@ private:
     QHash<quint32, QIcon> & m_icons();
     typedef QHash<int, QVariant> DataEntry;
     QList<DataEntry> m_data;
+    QHash<QString, int> m_nicknameRows;
     QSet<QString> m_friendsSet, m_ignoredSet;
     QString m_nickname;
     QFont m_fontInRoom;
 
-    void updateIcon(const QModelIndex & index);
-    void updateSortData(const QModelIndex & index);
+    void reindexRows(int from);
+    void emitRowsChanged(int first, int last);
+    void updateIcon(DataEntry & entry);
+    void updateSortData(DataEntry & entry);
     void loadSet(QSet<QString> & set, const QString & suffix);
     void saveSet(const QSet<QString> & set, const QString & suffix);
-    void checkFriendIgnore(const QModelIndex & mi);
+    void checkFriendIgnore(DataEntry & entry);
     bool isFriend(const QString & nickname);
     bool isIgnored(const QString & nickname);
 };
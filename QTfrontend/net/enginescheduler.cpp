@@ -0,0 +1,128 @@
+/*
+ * Hedgewars, a free turn based strategy game
+ * Copyright (c) 2004-2014 Andrey Korotaev <unC0Rr@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <QThread>
+
+#include "enginescheduler.h"
+#include "tcpBase.h"
+
+HWEngineScheduler & HWEngineScheduler::instance()
+{
+    static HWEngineScheduler scheduler;
+    return scheduler;
+}
+
+HWEngineScheduler::HWEngineScheduler() :
+    m_connecting(0)
+{
+#ifdef HWLIBRARY
+    // engine lives in our process and can't run twice
+    m_totalLimit = 1;
+    for (int i = 0; i < ejKindsCount; ++i)
+        m_limits[i] = 1;
+#else
+    int cores = qMax(1, QThread::idealThreadCount());
+
+    m_totalLimit = qMax(2, cores);
+    m_limits[ejPreview] = qMax(2, cores / 4);
+    m_limits[ejGame] = 1;
+    // encoding is memory expensive, leave room for the interactive jobs
+    m_limits[ejRecord] = qBound(1, cores / 2, 4);
+#endif
+}
+
+int HWEngineScheduler::limit(EngineJobKind kind) const
+{
+    return m_limits[kind];
+}
+
+int HWEngineScheduler::runningCount(EngineJobKind kind) const
+{
+    int count = 0;
+    foreach(TCPBase * job, m_running)
+        if (job->jobKind() == kind)
+            ++count;
+    return count;
+}
+
+void HWEngineScheduler::schedule(TCPBase * job, bool supersede)
+{
+    if (supersede)
+    {
+        QList<TCPBase *> superseded;
+        foreach(TCPBase * p, m_pending)
+            if (p->couldBeRemoved()
+                && (p->jobKind() == job->jobKind())
+                && (p->parent() == job->parent()))
+                superseded.append(p);
+
+        foreach(TCPBase * p, superseded)
+            cancel(p);
+    }
+
+    // keep pending jobs sorted by priority, first come first served within a kind
+    int i = m_pending.size();
+    while ((i > 0) && (m_pending[i - 1]->jobKind() > job->jobKind()))
+        --i;
+    m_pending.insert(i, job);
+
+    dispatch();
+}
+
+void HWEngineScheduler::cancel(TCPBase * job)
+{
+    if (m_pending.removeOne(job))
+        delete job;
+}
+
+void HWEngineScheduler::jobConnected(TCPBase * job)
+{
+    if (m_connecting == job)
+        m_connecting = 0;
+
+    dispatch();
+}
+
+void HWEngineScheduler::jobFinished(TCPBase * job)
+{
+    m_pending.removeOne(job);
+    m_running.removeOne(job);
+    if (m_connecting == job)
+        m_connecting = 0;
+
+    dispatch();
+}
+
+void HWEngineScheduler::dispatch()
+{
+    if (m_connecting || (m_running.size() >= m_totalLimit))
+        return;
+
+    for (int i = 0; i < m_pending.size(); ++i)
+    {
+        TCPBase * job = m_pending[i];
+        if (runningCount(job->jobKind()) < m_limits[job->jobKind()])
+        {
+            m_pending.removeAt(i);
+            m_running.append(job);
+            m_connecting = job;
+            job->RealStart();
+            return;
+        }
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ * Hedgewars, a free turn based strategy game
+ * Copyright (c) 2004-2014 Andrey Korotaev <unC0Rr@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _ENGINESCHEDULER_H
+#define _ENGINESCHEDULER_H
+
+#include <QList>
+
+class TCPBase;
+
+// kinds of engine jobs, in order of priority
+enum EngineJobKind
+{
+    ejPreview = 0, // map previews, user is waiting for them
+    ejGame    = 1, // games and demos
+    ejRecord  = 2, // video encoding in background
+    ejKindsCount
+};
+
+/**
+ * @brief Decides when engine instances are started.
+ *
+ * Each kind of job has its own concurrency limit derived from the number
+ * of cores, pending jobs are started in priority order. Only one engine is
+ * started at a time since the IPC server can't tell connections apart.
+ */
+class HWEngineScheduler
+{
+    public:
+        static HWEngineScheduler & instance();
+
+        /**
+         * @brief Queues the job for start.
+         * @param supersede drop pending removable jobs of the same kind and parent
+         */
+        void schedule(TCPBase * job, bool supersede);
+        /// removes a job which didn't start yet and deletes it
+        void cancel(TCPBase * job);
+
+        void jobConnected(TCPBase * job);
+        void jobFinished(TCPBase * job);
+
+        int limit(EngineJobKind kind) const;
+
+    private:
+        HWEngineScheduler();
+
+        QList<TCPBase *> m_pending;
+        QList<TCPBase *> m_running;
+        TCPBase * m_connecting;
+        int m_limits[ejKindsCount];
+        int m_totalLimit;
+
+        int runningCount(EngineJobKind kind) const;
+        void dispatch();
+};
+
+#endif // _ENGINESCHEDULER_H
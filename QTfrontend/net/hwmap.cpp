@@ -21,11 +21,12 @@
 #include <QBitmap>
 #include <QLinearGradient>
 
-#include "hwconsts.h"
 #include "hwmap.h"
+#include "previewworker.h"
+#include "proto.h"
 
 HWMap::HWMap(QObject * parent) :
-    TCPBase(false, parent)
+    QObject(parent)
 {
     templateFilter = 0;
     m_mapgen = MAPGEN_REGULAR;
@@ -37,11 +38,6 @@ HWMap::~HWMap()
 {
 }
 
-bool HWMap::couldBeRemoved()
-{
-    return !m_hasStarted;
-}
-
 void HWMap::getImage(const QString & seed, int filter, MapGenerator mapgen, int maze_size, const QByteArray & drawMapData, QString & script, int feature_size)
 {
     m_seed = seed;
@@ -51,32 +47,18 @@ void HWMap::getImage(const QString & seed, int filter, MapGenerator mapgen, int
     m_maze_size = maze_size; // TODO replace with feature_size
     m_feature_size = feature_size;
     if(mapgen == MAPGEN_DRAWN) m_drawMapData = drawMapData;
-    Start(true);
+    HWPreviewWorker::instance()->request(this);
 }
 
-QStringList HWMap::getArguments()
+void HWMap::setPreviewData(const QByteArray & data)
 {
-    QStringList arguments;
-    arguments << "--internal";
-    arguments << "--port";
-    arguments << QString("%1").arg(ipc_port);
-    arguments << "--user-prefix";
-    arguments << cfgdir->absolutePath();
-    arguments << "--prefix";
-    arguments << datadir->absolutePath();
-    arguments << "--landpreview";
-    return arguments;
-}
-
-void HWMap::onClientDisconnect()
-{    
     QLinearGradient linearGrad(QPoint(128, 0), QPoint(128, 128));
     linearGrad.setColorAt(1, QColor(0, 0, 192));
     linearGrad.setColorAt(0, QColor(66, 115, 225));
 
-    if (readbuffer.size() == 128 * 32 + 1)
+    if (data.size() == 128 * 32 + 1)
     {
-        quint8 *buf = (quint8*) readbuffer.constData();
+        quint8 *buf = (quint8*) data.constData();
         QImage im(buf, 256, 128, QImage::Format_Mono);
         im.setNumColors(2);
 
@@ -93,14 +75,14 @@ void HWMap::onClientDisconnect()
 
         emit HHLimitReceived(buf[128 * 32]);
         emit ImageReceived(px);
-    } else if (readbuffer.size() == 128 * 256 + 1)
+    } else if (data.size() == 128 * 256 + 1)
     {
         QVector<QRgb> colorTable;
         colorTable.resize(256);
         for(int i = 0; i < 256; ++i)
             colorTable[i] = qRgba(255, 255, 0, i);
 
-        const quint8 *buf = (const quint8*) readbuffer.constData();
+        const quint8 *buf = (const quint8*) data.constData();
         QImage im(buf, 256, 128, QImage::Format_Indexed8);
         im.setColorTable(colorTable);
 
@@ -116,22 +98,24 @@ void HWMap::onClientDisconnect()
     }
 }
 
-void HWMap::SendToClientFirst()
+QByteArray HWMap::previewRequest() const
 {
-    SendIPC(QString("eseed %1").arg(m_seed).toUtf8());
-    SendIPC(QString("e$template_filter %1").arg(templateFilter).toUtf8());
-    SendIPC(QString("e$mapgen %1").arg(m_mapgen).toUtf8());
-    SendIPC(QString("e$feature_size %1").arg(m_feature_size).toUtf8());
+    QByteArray buf;
+
+    HWProto::addStringToBuffer(buf, QString("eseed %1").arg(m_seed));
+    HWProto::addStringToBuffer(buf, QString("e$template_filter %1").arg(templateFilter));
+    HWProto::addStringToBuffer(buf, QString("e$mapgen %1").arg(m_mapgen));
+    HWProto::addStringToBuffer(buf, QString("e$feature_size %1").arg(m_feature_size));
     if (!m_script.isEmpty())
     {
-        SendIPC(QString("escript Scripts/Multiplayer/%1.lua").arg(m_script).toUtf8());
+        HWProto::addStringToBuffer(buf, QString("escript Scripts/Multiplayer/%1.lua").arg(m_script));
     }
 
     switch (m_mapgen)
     {
         case MAPGEN_MAZE:
         case MAPGEN_PERLIN:
-            SendIPC(QString("e$maze_size %1").arg(m_maze_size).toUtf8());
+            HWProto::addStringToBuffer(buf, QString("e$maze_size %1").arg(m_maze_size));
             break;
 
         case MAPGEN_DRAWN:
@@ -141,7 +125,7 @@ void HWMap::SendToClientFirst()
             {
                 QByteArray tmp = data;
                 tmp.truncate(200);
-                SendIPC("edraw " + tmp);
+                HWProto::addByteArrayToBuffer(buf, "edraw " + tmp);
                 data.remove(0, 200);
             }
             break;
@@ -150,5 +134,7 @@ void HWMap::SendToClientFirst()
             ;
     }
 
-    SendIPC("!");
+    HWProto::addStringToBuffer(buf, "!");
+
+    return buf;
 }
@@ -20,12 +20,11 @@
 #ifndef _HWMAP_INCLUDED
 #define _HWMAP_INCLUDED
 
+#include <QObject>
 #include <QByteArray>
 #include <QString>
 #include <QPixmap>
 
-#include "tcpBase.h"
-
 enum MapGenerator
 {
     MAPGEN_REGULAR = 0,
@@ -35,7 +34,13 @@ enum MapGenerator
     MAPGEN_MAP = 4
 };
 
-class HWMap : public TCPBase
+/**
+ * @brief A single map preview request.
+ *
+ * Requests are served by the shared HWPreviewWorker engine; the object
+ * deletes itself once the preview was delivered or the request was dropped.
+ */
+class HWMap : public QObject
 {
         Q_OBJECT
 
@@ -43,12 +48,10 @@ class HWMap : public TCPBase
         HWMap(QObject *parent = 0);
         virtual ~HWMap();
         void getImage(const QString & seed, int templateFilter, MapGenerator mapgen, int maze_size, const QByteArray & drawMapData, QString & script, int feature_size);
-        bool couldBeRemoved();
 
-    protected:
-        virtual QStringList getArguments();
-        virtual void onClientDisconnect();
-        virtual void SendToClientFirst();
+        // engine commands describing this map, terminated with a ping
+        QByteArray previewRequest() const;
+        void setPreviewData(const QByteArray & data);
 
     signals:
         void ImageReceived(const QPixmap & newImage);
@@ -12,6 +12,7 @@ public:
 
     void optimizeMap(const Paths & paths);
     bool couldBeRemoved();
+    EngineJobKind jobKind();
     
 signals:    
     void optimizedMap(const Paths & paths);
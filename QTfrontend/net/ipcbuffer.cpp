@@ -0,0 +1,88 @@
+/*
+ * Hedgewars, a free turn based strategy game
+ * Copyright (c) 2004-2014 Andrey Korotaev <unC0Rr@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "ipcbuffer.h"
+
+IPCReadBuffer::IPCReadBuffer() :
+    m_offset(0)
+{
+}
+
+void IPCReadBuffer::append(const QByteArray & data)
+{
+    if (m_offset > 0)
+    {
+        // usually everything was consumed, otherwise only the tail
+        // of one incomplete message is left to move
+        if (m_offset >= m_buffer.size())
+            m_buffer.clear();
+        else
+            m_buffer.remove(0, m_offset);
+        m_offset = 0;
+    }
+
+    m_buffer.append(data);
+}
+
+void IPCReadBuffer::clear()
+{
+    m_buffer.clear();
+    m_offset = 0;
+}
+
+bool IPCReadBuffer::takeMessage(QByteArray & msg)
+{
+    int avail = m_buffer.size() - m_offset;
+    if (avail <= 0)
+        return false;
+
+    quint8 msglen = m_buffer.constData()[m_offset];
+    if (msglen >= avail)
+        return false;
+
+    msg = QByteArray::fromRawData(m_buffer.constData() + m_offset, msglen + 1);
+    m_offset += msglen + 1;
+
+    return true;
+}
+
+bool IPCReadBuffer::takeBlock(int size, QByteArray & block)
+{
+    if (m_buffer.size() - m_offset < size)
+        return false;
+
+    block = QByteArray::fromRawData(m_buffer.constData() + m_offset, size);
+    m_offset += size;
+
+    return true;
+}
+
+int IPCReadBuffer::size() const
+{
+    return m_buffer.size() - m_offset;
+}
+
+bool IPCReadBuffer::isEmpty() const
+{
+    return size() == 0;
+}
+
+const char * IPCReadBuffer::constData() const
+{
+    return m_buffer.constData() + m_offset;
+}
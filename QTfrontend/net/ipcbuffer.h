@@ -0,0 +1,67 @@
+/*
+ * Hedgewars, a free turn based strategy game
+ * Copyright (c) 2004-2014 Andrey Korotaev <unC0Rr@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _IPCBUFFER_H
+#define _IPCBUFFER_H
+
+#include <QByteArray>
+
+/**
+ * @brief Receive buffer for the engine IPC stream.
+ *
+ * Incoming data is appended at the end and consumed by moving a read offset
+ * forward, so taking a message never shifts the rest of the buffer.
+ * Consumed bytes are dropped in one go on the next append.
+ */
+class IPCReadBuffer
+{
+    public:
+        IPCReadBuffer();
+
+        void append(const QByteArray & data);
+        void clear();
+
+        /**
+         * @brief Takes the next complete length-prefixed message.
+         *
+         * On success msg is set to a view into the buffer (length byte
+         * included) which is only valid until the next append() or clear().
+         * @return false if no complete message is buffered yet
+         */
+        bool takeMessage(QByteArray & msg);
+
+        /**
+         * @brief Takes the next size bytes as a raw block.
+         *
+         * Same view semantics as takeMessage().
+         * @return false if less than size bytes are buffered
+         */
+        bool takeBlock(int size, QByteArray & block);
+
+        /// number of buffered bytes not consumed yet
+        int size() const;
+        bool isEmpty() const;
+        /// pointer to the first unconsumed byte
+        const char * constData() const;
+
+    private:
+        QByteArray m_buffer;
+        int m_offset;
+};
+
+#endif // _IPCBUFFER_H
@@ -0,0 +1,75 @@
+/*
+ * Hedgewars, a free turn based strategy game
+ * Copyright (c) 2004-2014 Andrey Korotaev <unC0Rr@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _NETCOMMANDTABLE_H
+#define _NETCOMMANDTABLE_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief Maps server command names to handler methods.
+ *
+ * Every command carries the number of parameters it accepts (not counting
+ * the command name itself) and free-form flags for the dispatcher, so
+ * handlers may rely on their arguments being present.
+ */
+template <class Handler>
+class NetCommandTable
+{
+    public:
+        typedef void (Handler::*Method)(const QStringList & lst);
+
+        struct Command
+        {
+            Method method;
+            int minParams;
+            int maxParams; ///< -1 for no limit
+            int flags;
+        };
+
+        void add(const QString & name, Method method, int minParams = 0, int maxParams = -1, int flags = 0)
+        {
+            Command cmd;
+            cmd.method = method;
+            cmd.minParams = minParams;
+            cmd.maxParams = maxParams;
+            cmd.flags = flags;
+
+            m_commands.insert(name, cmd);
+        }
+
+        /// @return 0 if the command is not known
+        const Command * find(const QString & name) const
+        {
+            typename QHash<QString, Command>::const_iterator it = m_commands.constFind(name);
+
+            return it == m_commands.constEnd() ? 0 : &it.value();
+        }
+
+        static bool acceptsParams(const Command & cmd, int params)
+        {
+            return params >= cmd.minParams && (cmd.maxParams < 0 || params <= cmd.maxParams);
+        }
+
+    private:
+        QHash<QString, Command> m_commands;
+};
+
+#endif // _NETCOMMANDTABLE_H
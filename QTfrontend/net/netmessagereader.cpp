@@ -0,0 +1,73 @@
+/*
+ * Hedgewars, a free turn based strategy game
+ * Copyright (c) 2004-2014 Andrey Korotaev <unC0Rr@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <QString>
+
+#include "netmessagereader.h"
+
+NetMessageReader::NetMessageReader() :
+    m_offset(0)
+{
+}
+
+void NetMessageReader::append(const QByteArray & data)
+{
+    if (data.isEmpty())
+        return;
+
+    if (m_offset >= m_buffer.size())
+    {
+        m_buffer.clear();
+        m_offset = 0;
+    }
+    else if (m_offset > m_buffer.size() / 2)
+    {
+        m_buffer.remove(0, m_offset);
+        m_offset = 0;
+    }
+
+    m_buffer.append(data);
+}
+
+void NetMessageReader::clear()
+{
+    m_buffer.clear();
+    m_offset = 0;
+}
+
+bool NetMessageReader::takeMessage(QStringList & lines)
+{
+    if (m_offset >= m_buffer.size())
+        return false;
+
+    if (m_buffer.at(m_offset) == '\n')
+    {
+        lines.clear();
+        ++m_offset;
+        return true;
+    }
+
+    int end = m_buffer.indexOf("\n\n", m_offset);
+    if (end < 0)
+        return false;
+
+    lines = QString::fromUtf8(m_buffer.constData() + m_offset, end - m_offset).split('\n');
+    m_offset = end + 2;
+
+    return true;
+}
@@ -0,0 +1,54 @@
+/*
+ * Hedgewars, a free turn based strategy game
+ * Copyright (c) 2004-2014 Andrey Korotaev <unC0Rr@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _NETMESSAGEREADER_H
+#define _NETMESSAGEREADER_H
+
+#include <QByteArray>
+#include <QStringList>
+
+/**
+ * @brief Splits the server byte stream into protocol messages.
+ *
+ * A message is a number of lines terminated by an empty line. Every complete
+ * message is decoded from UTF-8 in one go and then split into its lines.
+ * Consumed data is dropped lazily, so large bursts are not shifted around
+ * once per message.
+ */
+class NetMessageReader
+{
+    public:
+        NetMessageReader();
+
+        void append(const QByteArray & data);
+        void clear();
+
+        /**
+         * @brief Takes the next complete message.
+         *
+         * A lone empty line yields an empty list.
+         * @return false if no complete message is buffered yet
+         */
+        bool takeMessage(QStringList & lines);
+
+    private:
+        QByteArray m_buffer;
+        int m_offset;
+};
+
+#endif // _NETMESSAGEREADER_H
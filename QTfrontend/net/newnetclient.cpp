@@ -25,6 +25,7 @@
 
 #include "hwconsts.h"
 #include "newnetclient.h"
+#include "netcommandtable.h"
 #include "proto.h"
 #include "game.h"
 #include "roomslistmodel.h"
@@ -34,6 +35,11 @@
 
 char delimiter='\n';
 
+// engine messages are collected for this long before going out in one EM
+static const int cEngineMessagesDelay = 20;
+// ... unless this many bytes are waiting already
+static const int cEngineMessagesBatchSize = 4096;
+
 HWNewNet::HWNewNet() :
     isChief(false),
     m_game_connected(false),
@@ -42,6 +48,9 @@ HWNewNet::HWNewNet() :
     m_private_game = false;
     m_nick_registered = false;
 
+    m_traffic = TrafficStats();
+    m_trafficLast = m_traffic;
+
     m_roomsListModel = new RoomsListModel(this);
 
     m_playersModel = new PlayersListModel(this);
@@ -68,6 +77,13 @@ HWNewNet::HWNewNet() :
             SLOT(displayError(QAbstractSocket::SocketError)));
 
     connect(this, SIGNAL(messageProcessed()), this, SLOT(ClientRead()), Qt::QueuedConnection);
+
+    m_engineMessagesTimer.setSingleShot(true);
+    m_engineMessagesTimer.setInterval(cEngineMessagesDelay);
+    connect(&m_engineMessagesTimer, SIGNAL(timeout()), this, SLOT(flushEngineMessages()));
+
+    m_trafficTimer.setInterval(1000);
+    connect(&m_trafficTimer, SIGNAL(timeout()), this, SLOT(updateTrafficRate()));
 }
 
 HWNewNet::~HWNewNet()
@@ -85,6 +101,7 @@ void HWNewNet::Connect(const QString & hostName, quint16 port, const QString & n
     netClientState = Connecting;
     mynick = nick;
     myhost = hostName + QString(":%1").arg(port);
+    m_readBuffer.clear();
     NetSocket.connectToHost(hostName, port);
 }
 
@@ -171,9 +188,35 @@ void HWNewNet::ToggleReady()
 
 void HWNewNet::SendNet(const QByteArray & buf)
 {
-    QString msg = QString(buf.toBase64());
+    // count the length-prefixed engine messages for the statistics
+    for (int i = 0; i < buf.size(); i += quint8(buf.at(i)) + 1)
+        ++m_traffic.engineMessagesSent;
+
+    m_engineMessages.append(buf);
 
-    RawSendNet(QString("EM%1%2").arg(delimiter).arg(msg));
+    if (m_engineMessages.size() >= cEngineMessagesBatchSize)
+        flushEngineMessages();
+    else if (!m_engineMessagesTimer.isActive())
+        m_engineMessagesTimer.start();
+}
+
+void HWNewNet::flushEngineMessages()
+{
+    m_engineMessagesTimer.stop();
+
+    if (m_engineMessages.isEmpty())
+        return;
+
+    // the server splits the decoded payload into single messages itself
+    QByteArray buf("EM");
+    buf.append(delimiter);
+    buf.append(m_engineMessages.toBase64());
+    m_engineMessages.clear();
+
+#ifdef QT_DEBUG
+    qDebug() << "Client: EM," << buf.size() << "bytes";
+#endif
+    writeNet(buf);
 }
 
 void HWNewNet::RawSendNet(const QString & str)
@@ -183,38 +226,77 @@ void HWNewNet::RawSendNet(const QString & str)
 
 void HWNewNet::RawSendNet(const QByteArray & buf)
 {
+    // keep the order of engine messages and other commands
+    flushEngineMessages();
+
     qDebug() << "Client: " << QString(buf).split("\n");
+    writeNet(buf);
+}
+
+void HWNewNet::writeNet(const QByteArray & buf)
+{
     NetSocket.write(buf);
     NetSocket.write("\n\n", 2);
+
+    m_traffic.bytesSent += buf.size() + 2;
+    ++m_traffic.commandsSent;
+}
+
+const HWNewNet::TrafficStats & HWNewNet::trafficStats() const
+{
+    return m_traffic;
+}
+
+void HWNewNet::updateTrafficRate()
+{
+    TrafficStats rate;
+    rate.bytesSent = m_traffic.bytesSent - m_trafficLast.bytesSent;
+    rate.bytesReceived = m_traffic.bytesReceived - m_trafficLast.bytesReceived;
+    rate.commandsSent = m_traffic.commandsSent - m_trafficLast.commandsSent;
+    rate.commandsReceived = m_traffic.commandsReceived - m_trafficLast.commandsReceived;
+    rate.engineMessagesSent = m_traffic.engineMessagesSent - m_trafficLast.engineMessagesSent;
+    rate.engineMessagesReceived = m_traffic.engineMessagesReceived - m_trafficLast.engineMessagesReceived;
+
+    m_trafficLast = m_traffic;
+
+#ifdef QT_DEBUG
+    if (netClientState == InGame)
+        qDebug() << "Net traffic per second: sent" << rate.bytesSent << "bytes,"
+                 << rate.commandsSent << "commands," << rate.engineMessagesSent << "engine messages; received"
+                 << rate.bytesReceived << "bytes," << rate.commandsReceived << "commands,"
+                 << rate.engineMessagesReceived << "engine messages";
+#endif
+
+    emit trafficRate(rate);
 }
 
 void HWNewNet::ClientRead()
 {
-    while (NetSocket.canReadLine())
-    {
-        QString s = QString::fromUtf8(NetSocket.readLine());
-        if (s.endsWith('\n')) s.chop(1);
+    QByteArray data = NetSocket.readAll();
+    m_traffic.bytesReceived += data.size();
+    m_readBuffer.append(data);
 
-        if (s.size() == 0)
-        {
-            ParseCmd(cmdbuf);
-            cmdbuf.clear();
-            emit messageProcessed();
-            return ;
-        }
-        else
-            cmdbuf << s;
+    // one message per call, messageProcessed() brings us back for the next one
+    QStringList lst;
+    if (m_readBuffer.takeMessage(lst))
+    {
+        ParseCmd(lst);
+        emit messageProcessed();
     }
 }
 
 void HWNewNet::OnConnect()
 {
     netClientState = Connected;
+    m_trafficTimer.start();
 }
 
 void HWNewNet::OnDisconnect()
 {
     netClientState = Disconnected;
+    m_trafficTimer.stop();
+    m_engineMessagesTimer.stop();
+    m_engineMessages.clear();
     if(m_game_connected) emit disconnected("");
     m_game_connected = false;
 }
@@ -247,9 +329,62 @@ void HWNewNet::SendPasswordHash(const QString & hash)
     maybeSendPassword();
 }
 
+const NetCommandTable<HWNewNet> & HWNewNet::commands()
+{
+    static const NetCommandTable<HWNewNet> table = createCommandTable();
+
+    return table;
+}
+
+NetCommandTable<HWNewNet> HWNewNet::createCommandTable()
+{
+    NetCommandTable<HWNewNet> table;
+
+    // parameter counts don't include the command name
+    table.add("NICK", &HWNewNet::cmdNick, 1);
+    table.add("PROTO", &HWNewNet::cmdProto);
+    table.add("ERROR", &HWNewNet::cmdError);
+    table.add("WARNING", &HWNewNet::cmdWarning);
+    table.add("CONNECTED", &HWNewNet::cmdConnected);
+    table.add("SERVER_AUTH", &HWNewNet::cmdServerAuth, 1);
+    table.add("PING", &HWNewNet::cmdPing);
+    table.add("ROOMS", &HWNewNet::cmdRooms);
+    table.add("SERVER_MESSAGE", &HWNewNet::cmdServerMessage, 1);
+    table.add("CHAT", &HWNewNet::cmdChat, 2);
+    table.add("INFO", &HWNewNet::cmdInfo, 4);
+    table.add("SERVER_VARS", &HWNewNet::cmdServerVars);
+    table.add("BANLIST", &HWNewNet::cmdBanList);
+    table.add("CLIENT_FLAGS", &HWNewNet::cmdClientFlags, 2);
+    table.add("CF", &HWNewNet::cmdClientFlags, 2);
+    table.add("KICKED", &HWNewNet::cmdKicked);
+    table.add("LOBBY:JOINED", &HWNewNet::cmdLobbyJoined, 1);
+    table.add("ROOM", &HWNewNet::cmdRoom, 2, 11);
+    table.add("LOBBY:LEFT", &HWNewNet::cmdLobbyLeft, 1);
+    table.add("ASKPASSWORD", &HWNewNet::cmdAskPassword, 1);
+    table.add("NOTICE", &HWNewNet::cmdNotice, 1);
+    table.add("BYE", &HWNewNet::cmdBye, 1);
+    table.add("JOINING", &HWNewNet::cmdJoining, 1, 1);
+    table.add("JOINED", &HWNewNet::cmdJoined, 1);
+
+    // these are only accepted while in a room
+    table.add("EM", &HWNewNet::cmdEngineMessage, 1, -1, RoomOnly | Quiet);
+    table.add("ROUND_FINISHED", &HWNewNet::cmdRoundFinished, 0, -1, RoomOnly);
+    table.add("ADD_TEAM", &HWNewNet::cmdAddTeam, 23, 23, RoomOnly);
+    table.add("REMOVE_TEAM", &HWNewNet::cmdRemoveTeam, 1, 1, RoomOnly);
+    table.add("ROOMABANDONED", &HWNewNet::cmdRoomAbandoned, 0, -1, RoomOnly);
+    table.add("RUN_GAME", &HWNewNet::cmdRunGame, 0, -1, RoomOnly);
+    table.add("TEAM_ACCEPTED", &HWNewNet::cmdTeamAccepted, 1, 1, RoomOnly);
+    table.add("CFG", &HWNewNet::cmdConfig, 2, -1, RoomOnly);
+    table.add("HH_NUM", &HWNewNet::cmdHedgehogsNum, 2, 2, RoomOnly);
+    table.add("TEAM_COLOR", &HWNewNet::cmdTeamColor, 2, 2, RoomOnly);
+    table.add("LEFT", &HWNewNet::cmdLeft, 1, -1, RoomOnly);
+
+    return table;
+}
+
 void HWNewNet::ParseCmd(const QStringList & lst)
 {
-    qDebug() << "Server: " << lst;
+    ++m_traffic.commandsReceived;
 
     if(!lst.size())
     {
@@ -257,321 +392,290 @@ void HWNewNet::ParseCmd(const QStringList & lst)
         return;
     }
 
-    if (lst[0] == "NICK")
-    {
-        mynick = lst[1];
-        m_playersModel->setNickname(mynick);
-        m_nick_registered = false;
-        return ;
-    }
+    const NetCommandTable<HWNewNet>::Command * cmd = commands().find(lst[0]);
 
-    if (lst[0] == "PROTO")
-        return ;
+#ifndef QT_DEBUG
+    // formatting every engine message is too expensive during the game
+    if(!cmd || !(cmd->flags & Quiet))
+#endif
+        qDebug() << "Server: " << lst;
 
-    if (lst[0] == "ERROR")
+    if(!cmd || ((cmd->flags & RoomOnly) && netClientState != InRoom && netClientState != InGame))
     {
-        if (lst.size() == 2)
-            emit Error(HWApplication::translate("server", lst[1].toAscii().constData()));
-        else
-            emit Error("Unknown error");
+        qWarning() << "Net: Unknown message or wrong state:" << lst;
         return;
     }
 
-    if (lst[0] == "WARNING")
+    if(!NetCommandTable<HWNewNet>::acceptsParams(*cmd, lst.size() - 1))
     {
-        if (lst.size() == 2)
-            emit Warning(HWApplication::translate("server", lst[1].toAscii().constData()));
-        else
-            emit Warning("Unknown warning");
+        qWarning() << "Net: Bad" << lst[0] << "message";
         return;
     }
 
-    if (lst[0] == "CONNECTED")
-    {
-        if(lst.size() < 3 || lst[2].toInt() < cMinServerVersion)
-        {
-            // TODO: Warn user, disconnect
-            qWarning() << "Server too old";
-            RawSendNet(QString("QUIT%1%2").arg(delimiter).arg("Server too old"));
-            Disconnect();
-            emit disconnected(tr("The server is too old. Disconnecting now."));
-            return;
-        }
+    (this->*(cmd->method))(lst);
+}
 
-        RawSendNet(QString("NICK%1%2").arg(delimiter).arg(mynick));
-        RawSendNet(QString("PROTO%1%2").arg(delimiter).arg(*cProtoVer));
-        netClientState = Connected;
-        m_game_connected = true;
-        emit adminAccess(false);
-        return;
-    }
+void HWNewNet::cmdNick(const QStringList & lst)
+{
+    mynick = lst[1];
+    m_playersModel->setNickname(mynick);
+    m_nick_registered = false;
+}
 
-    if (lst[0] == "SERVER_AUTH")
-    {
-        if(lst.size() < 2)
-        {
-            qWarning("Net: Malformed SERVER_AUTH message");
-            return;
-        }
+void HWNewNet::cmdProto(const QStringList & lst)
+{
+    Q_UNUSED(lst);
+}
 
-        if(lst[1] != m_serverHash)
-        {
-            Error("Server authentication error");
-            Disconnect();
-        } else
-        {
-            // empty m_serverHash variable means no authentication was performed
-            // or server passed authentication
-            m_serverHash.clear();
-        }
+void HWNewNet::cmdError(const QStringList & lst)
+{
+    if (lst.size() == 2)
+        emit Error(HWApplication::translate("server", lst[1].toAscii().constData()));
+    else
+        emit Error("Unknown error");
+}
 
-        return;
-    }
+void HWNewNet::cmdWarning(const QStringList & lst)
+{
+    if (lst.size() == 2)
+        emit Warning(HWApplication::translate("server", lst[1].toAscii().constData()));
+    else
+        emit Warning("Unknown warning");
+}
 
-    if (lst[0] == "PING")
+void HWNewNet::cmdConnected(const QStringList & lst)
+{
+    if(lst.size() < 3 || lst[2].toInt() < cMinServerVersion)
     {
-        if (lst.size() > 1)
-            RawSendNet(QString("PONG%1%2").arg(delimiter).arg(lst[1]));
-        else
-            RawSendNet(QString("PONG"));
+        // TODO: Warn user, disconnect
+        qWarning() << "Server too old";
+        RawSendNet(QString("QUIT%1%2").arg(delimiter).arg("Server too old"));
+        Disconnect();
+        emit disconnected(tr("The server is too old. Disconnecting now."));
         return;
     }
 
-    if (lst[0] == "ROOMS")
+    RawSendNet(QString("NICK%1%2").arg(delimiter).arg(mynick));
+    RawSendNet(QString("PROTO%1%2").arg(delimiter).arg(*cProtoVer));
+    netClientState = Connected;
+    m_game_connected = true;
+    emit adminAccess(false);
+}
+
+void HWNewNet::cmdServerAuth(const QStringList & lst)
+{
+    if(lst[1] != m_serverHash)
     {
-        if(lst.size() % 9 != 1)
-        {
-            qWarning("Net: Malformed ROOMS message");
-            return;
-        }
-        m_roomsListModel->setRoomsList(lst.mid(1));
-        if (m_private_game == false && m_nick_registered == false)
-        {
-            emit NickNotRegistered(mynick);
-        }
-        return;
+        Error("Server authentication error");
+        Disconnect();
+    } else
+    {
+        // empty m_serverHash variable means no authentication was performed
+        // or server passed authentication
+        m_serverHash.clear();
     }
+}
+
+void HWNewNet::cmdPing(const QStringList & lst)
+{
+    if (lst.size() > 1)
+        RawSendNet(QString("PONG%1%2").arg(delimiter).arg(lst[1]));
+    else
+        RawSendNet(QString("PONG"));
+}
 
-    if (lst[0] == "SERVER_MESSAGE")
+void HWNewNet::cmdRooms(const QStringList & lst)
+{
+    if(lst.size() % 9 != 1)
     {
-        if(lst.size() < 2)
-        {
-            qWarning("Net: Empty SERVERMESSAGE message");
-            return;
-        }
-        emit serverMessage(lst[1]);
+        qWarning("Net: Malformed ROOMS message");
         return;
     }
-
-    if (lst[0] == "CHAT")
+    m_roomsListModel->setRoomsList(lst.mid(1));
+    if (m_private_game == false && m_nick_registered == false)
     {
-        if(lst.size() < 3)
-        {
-            qWarning("Net: Empty CHAT message");
-            return;
-        }
+        emit NickNotRegistered(mynick);
+    }
+}
 
-        QString action = HWProto::chatStringToAction(lst[2]);
+void HWNewNet::cmdServerMessage(const QStringList & lst)
+{
+    emit serverMessage(lst[1]);
+}
 
-        if (netClientState == InLobby)
-        {
-            if (action != NULL)
-                emit lobbyChatAction(lst[1], action);
-            else
-                emit lobbyChatMessage(lst[1], lst[2]);
-        }
+void HWNewNet::cmdChat(const QStringList & lst)
+{
+    QString action = HWProto::chatStringToAction(lst[2]);
+
+    if (netClientState == InLobby)
+    {
+        if (action != NULL)
+            emit lobbyChatAction(lst[1], action);
         else
-        {
-            emit chatStringFromNet(HWProto::formatChatMsg(lst[1], lst[2]));
-            if (action != NULL)
-                emit roomChatAction(lst[1], action);
-            else
-                emit roomChatMessage(lst[1], lst[2]);
-        }
-        return;
+            emit lobbyChatMessage(lst[1], lst[2]);
     }
-
-    if (lst[0] == "INFO")
+    else
     {
-        if(lst.size() < 5)
-        {
-            qWarning("Net: Malformed INFO message");
-            return;
-        }
-        emit playerInfo(lst[1], lst[2], lst[3], lst[4]);
-        if (netClientState != InLobby)
-        {
-            QStringList tmp = lst;
-            tmp.removeFirst();
-            emit chatStringFromNet(tmp.join(" ").prepend('\x01'));
-        }
-        return;
+        emit chatStringFromNet(HWProto::formatChatMsg(lst[1], lst[2]));
+        if (action != NULL)
+            emit roomChatAction(lst[1], action);
+        else
+            emit roomChatMessage(lst[1], lst[2]);
     }
+}
 
-    if (lst[0] == "SERVER_VARS")
+void HWNewNet::cmdInfo(const QStringList & lst)
+{
+    emit playerInfo(lst[1], lst[2], lst[3], lst[4]);
+    if (netClientState != InLobby)
     {
         QStringList tmp = lst;
         tmp.removeFirst();
-        while (tmp.size() >= 2)
-        {
-            if(tmp[0] == "MOTD_NEW") emit serverMessageNew(tmp[1]);
-            else if(tmp[0] == "MOTD_OLD") emit serverMessageOld(tmp[1]);
-            else if(tmp[0] == "LATEST_PROTO") emit latestProtocolVar(tmp[1].toInt());
-
-            tmp.removeFirst();
-            tmp.removeFirst();
-        }
-        return;
+        emit chatStringFromNet(tmp.join(" ").prepend('\x01'));
     }
+}
 
-    if (lst[0] == "BANLIST")
+void HWNewNet::cmdServerVars(const QStringList & lst)
+{
+    QStringList tmp = lst;
+    tmp.removeFirst();
+    while (tmp.size() >= 2)
     {
-        QStringList tmp = lst;
+        if(tmp[0] == "MOTD_NEW") emit serverMessageNew(tmp[1]);
+        else if(tmp[0] == "MOTD_OLD") emit serverMessageOld(tmp[1]);
+        else if(tmp[0] == "LATEST_PROTO") emit latestProtocolVar(tmp[1].toInt());
+
+        tmp.removeFirst();
         tmp.removeFirst();
-        emit bansList(tmp);
+    }
+}
+
+void HWNewNet::cmdBanList(const QStringList & lst)
+{
+    emit bansList(lst.mid(1));
+}
+
+void HWNewNet::cmdClientFlags(const QStringList & lst)
+{
+    if(lst[1].size() < 2)
+    {
+        qWarning("Net: Malformed CLIENT_FLAGS message");
         return;
     }
 
-    if (lst[0] == "CLIENT_FLAGS" || lst[0] == "CF")
+    QString flags = lst[1];
+    bool setFlag = flags[0] == '+';
+    const QStringList nicks = lst.mid(2);
+
+    while(flags.size() > 1)
     {
-        if(lst.size() < 3 || lst[1].size() < 2)
+        flags.remove(0, 1);
+        char c = flags[0].toAscii();
+        bool inRoom = (netClientState == InRoom || netClientState == InGame);
+
+        switch(c)
         {
-            qWarning("Net: Malformed CLIENT_FLAGS message");
-            return;
-        }
+            // flag indicating if a player is ready to start a game
+            case 'r':
+                if(inRoom)
+                {
+                    if (nicks.contains(mynick))
+                        emit setMyReadyStatus(setFlag);
+
+                    m_playersModel->setFlag(nicks, PlayersListModel::Ready, setFlag);
+                }
+                    break;
+
+            // flag indicating if a player is a registered user
+            case 'u':
+                    m_playersModel->setFlag(nicks, PlayersListModel::Registered, setFlag);
+                    break;
+            // flag indicating if a player is in room
+            case 'i':
+                    m_playersModel->setFlag(nicks, PlayersListModel::InRoom, setFlag);
+                    break;
+            // flag indicating if a player is contributor
+            case 'c':
+                    m_playersModel->setFlag(nicks, PlayersListModel::Contributor, setFlag);
+                    break;
+            // flag indicating if a player has engine running
+            case 'g':
+                if(inRoom)
+                    m_playersModel->setFlag(nicks, PlayersListModel::InGame, setFlag);
+                    break;
+
+            // flag indicating if a player is the host/master of the room
+            case 'h':
+                if(inRoom)
+                {
+                    if (nicks.contains(mynick))
+                    {
+                        isChief = setFlag;
+                        emit roomMaster(isChief);
+                    }
 
-        QString flags = lst[1];
-        bool setFlag = flags[0] == '+';
-        const QStringList nicks = lst.mid(2);
+                    m_playersModel->setFlag(nicks, PlayersListModel::RoomAdmin, setFlag);
+                }
+                    break;
 
-        while(flags.size() > 1)
-        {
-            flags.remove(0, 1);
-            char c = flags[0].toAscii();
-            bool inRoom = (netClientState == InRoom || netClientState == InGame);
+            // flag indicating if a player is admin (if so -> worship them!)
+            case 'a':
+                    if (nicks.contains(mynick))
+                        emit adminAccess(setFlag);
 
-            switch(c)
-            {
-                // flag indicating if a player is ready to start a game
-                case 'r':
-                    if(inRoom)
-                        foreach (const QString & nick, nicks)
-                        {
-                            if (nick == mynick)
-                            {
-                                emit setMyReadyStatus(setFlag);
-                            }
-                            m_playersModel->setFlag(nick, PlayersListModel::Ready, setFlag);
-                        }
-                        break;
-
-                // flag indicating if a player is a registered user
-                case 'u':
-                        foreach(const QString & nick, nicks)
-                            m_playersModel->setFlag(nick, PlayersListModel::Registered, setFlag);
-                        break;
-                // flag indicating if a player is in room
-                case 'i':
-                        foreach(const QString & nick, nicks)
-                            m_playersModel->setFlag(nick, PlayersListModel::InRoom, setFlag);
-                        break;
-                // flag indicating if a player is contributor
-                case 'c':
-                        foreach(const QString & nick, nicks)
-                            m_playersModel->setFlag(nick, PlayersListModel::Contributor, setFlag);
-                        break;
-                // flag indicating if a player has engine running
-                case 'g':
-                    if(inRoom)
-                        foreach(const QString & nick, nicks)
-                            m_playersModel->setFlag(nick, PlayersListModel::InGame, setFlag);
-                        break;
-
-                // flag indicating if a player is the host/master of the room
-                case 'h':
-                    if(inRoom)
-                        foreach (const QString & nick, nicks)
-                        {
-                            if (nick == mynick)
-                            {
-                                isChief = setFlag;
-                                emit roomMaster(isChief);
-                            }
-
-                            m_playersModel->setFlag(nick, PlayersListModel::RoomAdmin, setFlag);
-                        }
-                        break;
-
-                // flag indicating if a player is admin (if so -> worship them!)
-                case 'a':
-                        foreach (const QString & nick, nicks)
-                        {
-                            if (nick == mynick)
-                                emit adminAccess(setFlag);
-
-                            m_playersModel->setFlag(nick, PlayersListModel::ServerAdmin, setFlag);
-                        }
-                        break;
-
-                default:
-                        qWarning() << "Net: Unknown client-flag: " << c;
-            }
-        }
+                    m_playersModel->setFlag(nicks, PlayersListModel::ServerAdmin, setFlag);
+                    break;
 
-        return;
+            default:
+                    qWarning() << "Net: Unknown client-flag: " << c;
+        }
     }
+}
 
-    if(lst[0] == "KICKED")
-    {
-        netClientState = InLobby;
-        askRoomsList();
-        emit LeftRoom(tr("You got kicked"));
-        m_playersModel->resetRoomFlags();
+void HWNewNet::cmdKicked(const QStringList & lst)
+{
+    Q_UNUSED(lst);
 
-        return;
-    }
+    netClientState = InLobby;
+    askRoomsList();
+    emit LeftRoom(tr("You got kicked"));
+    m_playersModel->resetRoomFlags();
+}
 
-    if(lst[0] == "LOBBY:JOINED")
+void HWNewNet::cmdLobbyJoined(const QStringList & lst)
+{
+    for(int i = 1; i < lst.size(); ++i)
     {
-        if(lst.size() < 2)
-        {
-            qWarning("Net: Bad JOINED message");
-            return;
-        }
-
-        for(int i = 1; i < lst.size(); ++i)
+        if (lst[i] == mynick)
         {
-            if (lst[i] == mynick)
+            // check if server is authenticated or no authentication was performed at all
+            if(!m_serverHash.isEmpty())
             {
-                // check if server is authenticated or no authentication was performed at all
-                if(!m_serverHash.isEmpty())
-                {
-                    Error(tr("Server authentication error"));
-
-                    Disconnect();
-                }
+                Error(tr("Server authentication error"));
 
-                netClientState = InLobby;
-                RawSendNet(QString("LIST"));
-                emit connected();
+                Disconnect();
             }
 
-            m_playersModel->addPlayer(lst[i], false);
+            netClientState = InLobby;
+            RawSendNet(QString("LIST"));
+            emit connected();
         }
-        return;
     }
 
-    if(lst[0] == "ROOM" && lst.size() == 11 && lst[1] == "ADD")
+    m_playersModel->addPlayers(lst.mid(1), false);
+}
+
+void HWNewNet::cmdRoom(const QStringList & lst)
+{
+    if(lst.size() == 11 && lst[1] == "ADD")
     {
         QStringList tmp = lst;
         tmp.removeFirst();
         tmp.removeFirst();
 
         m_roomsListModel->addRoom(tmp);
-        return;
     }
-
-    if(lst[0] == "ROOM" && lst.size() == 12 && lst[1] == "UPD")
+    else if(lst.size() == 12 && lst[1] == "UPD")
     {
         QStringList tmp = lst;
         tmp.removeFirst();
@@ -586,113 +690,83 @@ void HWNewNet::ParseCmd(const QStringList & lst)
             myroom = tmp[1];
             emit roomNameUpdated(myroom);
         }
-
-        return;
     }
-
-    if(lst[0] == "ROOM" && lst.size() == 3 && lst[1] == "DEL")
+    else if(lst.size() == 3 && lst[1] == "DEL")
     {
         m_roomsListModel->removeRoom(lst[2]);
-        return;
     }
+    else
+        qWarning() << "Net: Unknown message or wrong state:" << lst;
+}
 
-    if(lst[0] == "LOBBY:LEFT")
-    {
-        if(lst.size() < 2)
-        {
-            qWarning("Net: Bad LOBBY:LEFT message");
-            return;
-        }
-
-        if (lst.size() < 3)
-            m_playersModel->removePlayer(lst[1]);
-        else
-            m_playersModel->removePlayer(lst[1], lst[2]);
+void HWNewNet::cmdLobbyLeft(const QStringList & lst)
+{
+    if (lst.size() < 3)
+        m_playersModel->removePlayer(lst[1]);
+    else
+        m_playersModel->removePlayer(lst[1], lst[2]);
+}
 
-        return;
-    }
+void HWNewNet::cmdAskPassword(const QStringList & lst)
+{
+    // server should send us salt of at least 16 characters
 
-    if (lst[0] == "ASKPASSWORD")
+    if(lst[1].size() < 16)
     {
-        // server should send us salt of at least 16 characters
-
-        if(lst.size() < 2 || lst[1].size() < 16)
-        {
-            qWarning("Net: Bad ASKPASSWORD message");
-            return;
-        }
-
-        emit NickRegistered(mynick);
-        m_nick_registered = true;
-
-        // store server salt
-        // when this variable is set, it is assumed that server asked us for a password
-        m_serverSalt = lst[1];
-        m_clientSalt = QUuid::createUuid().toString();
-
-        maybeSendPassword();
-
+        qWarning("Net: Bad ASKPASSWORD message");
         return;
     }
 
-    if (lst[0] == "NOTICE")
-    {
-        if(lst.size() < 2)
-        {
-            qWarning("Net: Bad NOTICE message");
-            return;
-        }
+    emit NickRegistered(mynick);
+    m_nick_registered = true;
 
-        bool ok;
-        int n = lst[1].toInt(&ok);
-        if(!ok)
-        {
-            qWarning("Net: Bad NOTICE message");
-            return;
-        }
+    // store server salt
+    // when this variable is set, it is assumed that server asked us for a password
+    m_serverSalt = lst[1];
+    m_clientSalt = QUuid::createUuid().toString();
 
-        handleNotice(n);
+    maybeSendPassword();
+}
 
+void HWNewNet::cmdNotice(const QStringList & lst)
+{
+    bool ok;
+    int n = lst[1].toInt(&ok);
+    if(!ok)
+    {
+        qWarning("Net: Bad NOTICE message");
         return;
     }
 
-    if (lst[0] == "BYE")
+    handleNotice(n);
+}
+
+void HWNewNet::cmdBye(const QStringList & lst)
+{
+    if (lst[1] == "Authentication failed")
     {
-        if (lst.size() < 2)
-        {
-            qWarning("Net: Bad BYE message");
-            return;
-        }
-        if (lst[1] == "Authentication failed")
-        {
-            emit AuthFailed();
-            m_game_connected = false;
-            Disconnect();
-            //omitted 'emit disconnected()', we don't want the error message
-            return;
-        }
+        emit AuthFailed();
         m_game_connected = false;
         Disconnect();
-        emit disconnected(HWApplication::translate("server", lst[1].toAscii().constData()));
+        //omitted 'emit disconnected()', we don't want the error message
         return;
     }
+    m_game_connected = false;
+    Disconnect();
+    emit disconnected(HWApplication::translate("server", lst[1].toAscii().constData()));
+}
 
-    if(lst[0] == "JOINING")
-    {
-        if(lst.size() != 2)
-        {
-            qWarning("Net: Bad JOINING message");
-            return;
-        }
-
-        myroom = lst[1];
-        emit roomNameUpdated(myroom);
-        return;
-    }
+void HWNewNet::cmdJoining(const QStringList & lst)
+{
+    myroom = lst[1];
+    emit roomNameUpdated(myroom);
+}
 
-    if(netClientState == InLobby && lst[0] == "JOINED")
+void HWNewNet::cmdJoined(const QStringList & lst)
+{
+    if(netClientState == InLobby)
     {
-        if(lst.size() < 2 || lst[1] != mynick)
+        if(lst[1] != mynick)
         {
             qWarning("Net: Bad JOINED message");
             return;
@@ -709,164 +783,109 @@ void HWNewNet::ParseCmd(const QStringList & lst)
                     emit configAsked();
             }
 
-            m_playersModel->playerJoinedRoom(lst[i], isChief && (lst[i] != mynick));
-
             emit chatStringFromNet(tr("%1 *** %2 has joined the room").arg('\x03').arg(lst[i]));
         }
-        return;
-    }
 
-    if(netClientState == InRoom || netClientState == InGame)
+        m_playersModel->playersJoinedRoom(lst.mid(1), isChief);
+    }
+    else if(netClientState == InRoom || netClientState == InGame)
     {
-        if (lst[0] == "EM")
-        {
-            if(lst.size() < 2)
-            {
-                qWarning("Net: Bad EM message");
-                return;
-            }
-            for(int i = 1; i < lst.size(); ++i)
-            {
-                QByteArray em = QByteArray::fromBase64(lst[i].toAscii());
-                emit FromNet(em);
-            }
-            return;
-        }
+        for(int i = 1; i < lst.size(); ++i)
+            emit chatStringFromNet(tr("%1 *** %2 has joined the room").arg('\x03').arg(lst[i]));
 
-        if (lst[0] == "ROUND_FINISHED")
-        {
-            emit FromNet(QByteArray("\x01o"));
-            return;
-        }
+        m_playersModel->playersJoinedRoom(lst.mid(1), isChief);
+    }
+    else
+        qWarning() << "Net: Unknown message or wrong state:" << lst;
+}
 
-        if (lst[0] == "ADD_TEAM")
-        {
-            if(lst.size() != 24)
-            {
-                qWarning("Net: Bad ADDTEAM message");
-                return;
-            }
-            QStringList tmp = lst;
-            tmp.removeFirst();
-            HWTeam team(tmp);
-            emit AddNetTeam(team);
-            return;
-        }
+void HWNewNet::cmdEngineMessage(const QStringList & lst)
+{
+    // all parameters go to the engine in one piece
+    QByteArray em;
+    for(int i = 1; i < lst.size(); ++i)
+        em.append(QByteArray::fromBase64(lst[i].toAscii()));
 
-        if (lst[0] == "REMOVE_TEAM")
-        {
-            if(lst.size() != 2)
-            {
-                qWarning("Net: Bad REMOVETEAM message");
-                return;
-            }
-            emit RemoveNetTeam(HWTeam(lst[1]));
-            return;
-        }
+    for (int i = 0; i < em.size(); i += quint8(em.at(i)) + 1)
+        ++m_traffic.engineMessagesReceived;
 
-        if(lst[0] == "ROOMABANDONED")
-        {
-            netClientState = InLobby;
-            m_playersModel->resetRoomFlags();
-            emit LeftRoom(tr("Room destroyed"));
-            return;
-        }
+    emit FromNet(em);
+}
 
-        if (lst[0] == "RUN_GAME")
-        {
-            netClientState = InGame;
-            emit AskForRunGame();
-            return;
-        }
+void HWNewNet::cmdRoundFinished(const QStringList & lst)
+{
+    Q_UNUSED(lst);
 
-        if (lst[0] == "TEAM_ACCEPTED")
-        {
-            if (lst.size() != 2)
-            {
-                qWarning("Net: Bad TEAM_ACCEPTED message");
-                return;
-            }
-            emit TeamAccepted(lst[1]);
-            return;
-        }
+    emit FromNet(QByteArray("\x01o"));
+}
 
-        if (lst[0] == "CFG")
-        {
-            if(lst.size() < 3)
-            {
-                qWarning("Net: Bad CFG message");
-                return;
-            }
-            QStringList tmp = lst;
-            tmp.removeFirst();
-            tmp.removeFirst();
-            if (lst[1] == "SCHEME")
-                emit netSchemeConfig(tmp);
-            else
-                emit paramChanged(lst[1], tmp);
-            return;
-        }
+void HWNewNet::cmdAddTeam(const QStringList & lst)
+{
+    QStringList tmp = lst;
+    tmp.removeFirst();
+    HWTeam team(tmp);
+    emit AddNetTeam(team);
+}
 
-        if (lst[0] == "HH_NUM")
-        {
-            if (lst.size() != 3)
-            {
-                qWarning("Net: Bad TEAM_ACCEPTED message");
-                return;
-            }
-            HWTeam tmptm(lst[1]);
-            tmptm.setNumHedgehogs(lst[2].toUInt());
-            emit hhnumChanged(tmptm);
-            return;
-        }
+void HWNewNet::cmdRemoveTeam(const QStringList & lst)
+{
+    emit RemoveNetTeam(HWTeam(lst[1]));
+}
 
-        if (lst[0] == "TEAM_COLOR")
-        {
-            if (lst.size() != 3)
-            {
-                qWarning("Net: Bad TEAM_COLOR message");
-                return;
-            }
-            HWTeam tmptm(lst[1]);
-            tmptm.setColor(lst[2].toInt());
-            emit teamColorChanged(tmptm);
-            return;
-        }
+void HWNewNet::cmdRoomAbandoned(const QStringList & lst)
+{
+    Q_UNUSED(lst);
 
-        if(lst[0] == "JOINED")
-        {
-            if(lst.size() < 2)
-            {
-                qWarning("Net: Bad JOINED message");
-                return;
-            }
+    netClientState = InLobby;
+    m_playersModel->resetRoomFlags();
+    emit LeftRoom(tr("Room destroyed"));
+}
 
-            for(int i = 1; i < lst.size(); ++i)
-            {
-                emit chatStringFromNet(tr("%1 *** %2 has joined the room").arg('\x03').arg(lst[i]));
-                m_playersModel->playerJoinedRoom(lst[i], isChief && (lst[i] != mynick));
-            }
-            return;
-        }
+void HWNewNet::cmdRunGame(const QStringList & lst)
+{
+    Q_UNUSED(lst);
 
-        if(lst[0] == "LEFT")
-        {
-            if(lst.size() < 2)
-            {
-                qWarning("Net: Bad LEFT message");
-                return;
-            }
+    netClientState = InGame;
+    emit AskForRunGame();
+}
 
-            if (lst.size() < 3)
-                emit chatStringFromNet(tr("%1 *** %2 has left").arg('\x03').arg(lst[1]));
-            else
-                emit chatStringFromNet(tr("%1 *** %2 has left (%3)").arg('\x03').arg(lst[1], lst[2]));
-            m_playersModel->playerLeftRoom(lst[1]);
-            return;
-        }
-    }
+void HWNewNet::cmdTeamAccepted(const QStringList & lst)
+{
+    emit TeamAccepted(lst[1]);
+}
 
-    qWarning() << "Net: Unknown message or wrong state:" << lst;
+void HWNewNet::cmdConfig(const QStringList & lst)
+{
+    QStringList tmp = lst;
+    tmp.removeFirst();
+    tmp.removeFirst();
+    if (lst[1] == "SCHEME")
+        emit netSchemeConfig(tmp);
+    else
+        emit paramChanged(lst[1], tmp);
+}
+
+void HWNewNet::cmdHedgehogsNum(const QStringList & lst)
+{
+    HWTeam tmptm(lst[1]);
+    tmptm.setNumHedgehogs(lst[2].toUInt());
+    emit hhnumChanged(tmptm);
+}
+
+void HWNewNet::cmdTeamColor(const QStringList & lst)
+{
+    HWTeam tmptm(lst[1]);
+    tmptm.setColor(lst[2].toInt());
+    emit teamColorChanged(tmptm);
+}
+
+void HWNewNet::cmdLeft(const QStringList & lst)
+{
+    if (lst.size() < 3)
+        emit chatStringFromNet(tr("%1 *** %2 has left").arg('\x03').arg(lst[1]));
+    else
+        emit chatStringFromNet(tr("%1 *** %2 has left (%3)").arg('\x03').arg(lst[1], lst[2]));
+    m_playersModel->playerLeftRoom(lst[1]);
 }
 
 void HWNewNet::onHedgehogsNumChanged(const HWTeam& team)
@@ -23,10 +23,12 @@
 #include <QObject>
 #include <QString>
 #include <QTcpSocket>
+#include <QTimer>
 #include <QMap>
 
 #include "team.h"
 #include "game.h" // for GameState
+#include "netmessagereader.h"
 
 class GameUIConfig;
 class GameCFGWidget;
@@ -35,6 +37,7 @@ class RoomsListModel;
 class PlayersListModel;
 class QSortFilterProxyModel;
 class QAbstractItemModel;
+template <class Handler> class NetCommandTable;
 
 extern char delimiter;
 
@@ -45,6 +48,17 @@ class HWNewNet : public QObject
     public:
         enum ClientState { Disconnected, Connecting, Connected, InLobby, InRoom, InGame };
 
+        // totals since construction, or per second in trafficRate()
+        struct TrafficStats
+        {
+            quint64 bytesSent;
+            quint64 bytesReceived;
+            quint64 commandsSent;
+            quint64 commandsReceived;
+            quint64 engineMessagesSent;
+            quint64 engineMessagesReceived;
+        };
+
         HWNewNet();
         ~HWNewNet();
         void Connect(const QString & hostName, quint16 port, const QString & nick);
@@ -61,6 +75,7 @@ class HWNewNet : public QObject
         QAbstractItemModel * lobbyPlayersModel();
         QAbstractItemModel * roomPlayersModel();
         bool allPlayersReady();
+        const TrafficStats & trafficStats() const;
         bool m_private_game;
 
     private:
@@ -82,11 +97,63 @@ class HWNewNet : public QObject
         QString m_clientSalt;
         QString m_serverHash;
 
-        QStringList cmdbuf;
+        NetMessageReader m_readBuffer;
+        QByteArray m_engineMessages;
+        QTimer m_engineMessagesTimer;
+        TrafficStats m_traffic;
+        TrafficStats m_trafficLast;
+        QTimer m_trafficTimer;
+
+        // flags of server commands in the command table
+        enum CommandFlag
+        {
+            RoomOnly = 1,
+            Quiet = 2 // not dumped to the debug output in release builds
+        };
 
         void RawSendNet(const QString & buf);
         void RawSendNet(const QByteArray & buf);
+        void writeNet(const QByteArray & buf);
         void ParseCmd(const QStringList & lst);
+
+        static const NetCommandTable<HWNewNet> & commands();
+        static NetCommandTable<HWNewNet> createCommandTable();
+
+        // server command handlers, see commands()
+        void cmdNick(const QStringList & lst);
+        void cmdProto(const QStringList & lst);
+        void cmdError(const QStringList & lst);
+        void cmdWarning(const QStringList & lst);
+        void cmdConnected(const QStringList & lst);
+        void cmdServerAuth(const QStringList & lst);
+        void cmdPing(const QStringList & lst);
+        void cmdRooms(const QStringList & lst);
+        void cmdServerMessage(const QStringList & lst);
+        void cmdChat(const QStringList & lst);
+        void cmdInfo(const QStringList & lst);
+        void cmdServerVars(const QStringList & lst);
+        void cmdBanList(const QStringList & lst);
+        void cmdClientFlags(const QStringList & lst);
+        void cmdKicked(const QStringList & lst);
+        void cmdLobbyJoined(const QStringList & lst);
+        void cmdRoom(const QStringList & lst);
+        void cmdLobbyLeft(const QStringList & lst);
+        void cmdAskPassword(const QStringList & lst);
+        void cmdNotice(const QStringList & lst);
+        void cmdBye(const QStringList & lst);
+        void cmdJoining(const QStringList & lst);
+        void cmdJoined(const QStringList & lst);
+        void cmdEngineMessage(const QStringList & lst);
+        void cmdRoundFinished(const QStringList & lst);
+        void cmdAddTeam(const QStringList & lst);
+        void cmdRemoveTeam(const QStringList & lst);
+        void cmdRoomAbandoned(const QStringList & lst);
+        void cmdRunGame(const QStringList & lst);
+        void cmdTeamAccepted(const QStringList & lst);
+        void cmdConfig(const QStringList & lst);
+        void cmdHedgehogsNum(const QStringList & lst);
+        void cmdTeamColor(const QStringList & lst);
+        void cmdLeft(const QStringList & lst);
         void handleNotice(int n);
 
         void maybeSendPassword();
@@ -142,6 +209,8 @@ class HWNewNet : public QObject
 
         void messageProcessed();
 
+        void trafficRate(const HWNewNet::TrafficStats & perSecond);
+
     public slots:
         void ToggleReady();
         void chatLineToNet(const QString& str);
@@ -184,6 +253,8 @@ class HWNewNet : public QObject
 
     private slots:
         void ClientRead();
+        void flushEngineMessages();
+        void updateTrafficRate();
         void OnConnect();
         void OnDisconnect();
         void displayError(QAbstractSocket::SocketError socketError);
@@ -0,0 +1,137 @@
+/*
+ * Hedgewars, a free turn based strategy game
+ * Copyright (c) 2004-2014 Andrey Korotaev <unC0Rr@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "previewworker.h"
+#include "hwmap.h"
+#include "hwconsts.h"
+
+// alpha preview (256x128) followed by the hedgehogs limit
+static const int previewReplySize = 128 * 256 + 1;
+
+QPointer<HWPreviewWorker> HWPreviewWorker::m_instance(0);
+
+HWPreviewWorker::HWPreviewWorker() :
+    TCPBase(false, 0),
+    m_busy(false)
+{
+}
+
+HWPreviewWorker * HWPreviewWorker::instance()
+{
+    if (!m_instance)
+    {
+        m_instance = new HWPreviewWorker();
+        m_instance->Start(false);
+    }
+
+    return m_instance;
+}
+
+void HWPreviewWorker::request(HWMap * map)
+{
+    // drop requests of the same widget the engine didn't start on yet
+    for (int i = m_queue.size() - 1; i >= 0; --i)
+    {
+        HWMap * queued = m_queue[i];
+        if (!queued || (queued->parent() == map->parent()))
+        {
+            m_queue.removeAt(i);
+            if (queued)
+                queued->deleteLater();
+        }
+    }
+
+    m_queue.append(map);
+
+    sendNext();
+}
+
+void HWPreviewWorker::sendNext()
+{
+    if (m_busy || !isConnected())
+        return;
+
+    while (!m_queue.isEmpty() && !m_current)
+        m_current = m_queue.takeFirst();
+
+    if (!m_current)
+        return;
+
+    m_busy = true;
+    RawSendIPC(m_current->previewRequest());
+}
+
+QStringList HWPreviewWorker::getArguments()
+{
+    QStringList arguments;
+    arguments << "--internal";
+    arguments << ipcArguments();
+    arguments << "--user-prefix";
+    arguments << cfgdir->absolutePath();
+    arguments << "--prefix";
+    arguments << datadir->absolutePath();
+    arguments << "--landpreview";
+#ifndef HWLIBRARY
+    // library engine has to finish to let other jobs run, so it serves one request only
+    arguments << "--preview-worker";
+#endif
+    return arguments;
+}
+
+void HWPreviewWorker::onClientRead()
+{
+    QByteArray reply;
+    while (readbuffer.takeBlock(previewReplySize, reply))
+    {
+        // the request might have been deleted in the meantime
+        if (m_current)
+        {
+            m_current->setPreviewData(reply);
+            m_current->deleteLater();
+        }
+
+        m_current = 0;
+        m_busy = false;
+        sendNext();
+    }
+}
+
+void HWPreviewWorker::onClientDisconnect()
+{
+    // engine is gone, waiting requests go to a new one
+    m_instance = 0;
+
+    if (m_current)
+        m_current->deleteLater();
+
+    foreach(QPointer<HWMap> map, m_queue)
+        if (map)
+            instance()->request(map);
+
+    m_queue.clear();
+}
+
+void HWPreviewWorker::SendToClientFirst()
+{
+    sendNext();
+}
+
+EngineJobKind HWPreviewWorker::jobKind()
+{
+    return ejPreview;
+}
@@ -0,0 +1,69 @@
+/*
+ * Hedgewars, a free turn based strategy game
+ * Copyright (c) 2004-2014 Andrey Korotaev <unC0Rr@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _PREVIEWWORKER_INCLUDED
+#define _PREVIEWWORKER_INCLUDED
+
+#include <QList>
+#include <QPointer>
+
+#include "tcpBase.h"
+
+class HWMap;
+
+/**
+ * @brief Long-lived engine generating map previews.
+ *
+ * The engine is started once with --preview-worker and then serves one
+ * request after another over the same connection, so a preview costs
+ * generation time only instead of a whole engine start.
+ */
+class HWPreviewWorker : public TCPBase
+{
+        Q_OBJECT
+
+    public:
+        static HWPreviewWorker * instance();
+
+        /**
+         * @brief Queues a preview request.
+         *
+         * Requests from the same parent which are still waiting are
+         * superseded by the new one and dropped.
+         */
+        void request(HWMap * map);
+        EngineJobKind jobKind();
+
+    protected:
+        HWPreviewWorker();
+        virtual QStringList getArguments();
+        virtual void onClientRead();
+        virtual void onClientDisconnect();
+        virtual void SendToClientFirst();
+
+    private:
+        static QPointer<HWPreviewWorker> m_instance;
+
+        QList<QPointer<HWMap> > m_queue;
+        QPointer<HWMap> m_current;
+        bool m_busy;
+
+        void sendNext();
+};
+
+#endif // _PREVIEWWORKER_INCLUDED
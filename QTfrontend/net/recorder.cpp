@@ -25,13 +25,6 @@
 #include "game.h"
 #include "LibavInteraction.h"
 
-// Encoding is memory expensive process, so we need to limit maximum number
-// of simultaneous encoders.
-static const int maxRecorders = 3;
-static int numRecorders = 0;
-
-static QList<HWRecorder*> queue;
-
 HWRecorder::HWRecorder(GameUIConfig * config, const QString &prefix) :
     TCPBase(false)
 {
@@ -45,10 +38,6 @@ HWRecorder::HWRecorder(GameUIConfig * config, const QString &prefix) :
 HWRecorder::~HWRecorder()
 {
     emit encodingFinished(finished);
-    if (queue.empty())
-        numRecorders--;
-    else
-        queue.takeFirst()->Start(false);
 }
 
 void HWRecorder::onClientDisconnect()
@@ -57,13 +46,9 @@ void HWRecorder::onClientDisconnect()
 
 void HWRecorder::onClientRead()
 {
-    quint8 msglen;
-    quint32 bufsize;
-    while (!readbuffer.isEmpty() && ((bufsize = readbuffer.size()) > 0) &&
-            ((msglen = readbuffer.data()[0]) < bufsize))
+    QByteArray msg;
+    while (readbuffer.takeMessage(msg))
     {
-        QByteArray msg = readbuffer.left(msglen + 1);
-        readbuffer.remove(0, msglen + 1);
         switch (msg.at(1))
         {
         case '?':
@@ -87,13 +72,8 @@ void HWRecorder::EncodeVideo(const QByteArray & record)
     toSendBuf.replace(QByteArray("\x02TN"), QByteArray("\x02TV"));
     toSendBuf.replace(QByteArray("\x02TS"), QByteArray("\x02TV"));
 
-    if (numRecorders < maxRecorders)
-    {
-        numRecorders++;
-        Start(false); // run engine
-    }
-    else
-        queue.push_back(this);
+    // number of simultaneous encoders is limited by the scheduler
+    Start(false);
 }
 
 QStringList HWRecorder::getArguments()
@@ -103,8 +83,7 @@ QStringList HWRecorder::getArguments()
     QString nick = config->netNick().toUtf8().toBase64();
 
     arguments << "--internal";
-    arguments << "--port";
-    arguments << QString("%1").arg(ipc_port);
+    arguments << ipcArguments();
     arguments << "--prefix";
     arguments << datadir->absolutePath();
     arguments << "--user-prefix";
@@ -145,7 +124,7 @@ QStringList HWRecorder::getArguments()
     return arguments;
 }
 
-bool HWRecorder::simultaneousRun()
+EngineJobKind HWRecorder::jobKind()
 {
-    return true;
+    return ejRecord;
 }
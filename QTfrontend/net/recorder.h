@@ -35,7 +35,7 @@ class HWRecorder : public TCPBase
         virtual ~HWRecorder();
 
         void EncodeVideo(const QByteArray & record);
-        bool simultaneousRun();
+        EngineJobKind jobKind();
 
         VideoItem * item; // used by pagevideos
         QString name;
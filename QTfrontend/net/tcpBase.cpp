@@ -21,6 +21,7 @@
 #include <QImage>
 #include <QThread>
 #include <QApplication>
+#include <QDebug>
 
 #include "tcpBase.h"
 #include "hwconsts.h"
@@ -74,8 +75,13 @@ void EngineInstance::start()
 
 #endif
 
-QList<TCPBase*> srvsList;
+// streamed data is read in chunks of this size, and only while less than
+// cSendSourceBacklog bytes are still waiting to be written to the engine
+static const qint64 cSendSourceChunk = 64 * 1024;
+static const qint64 cSendSourceBacklog = 256 * 1024;
+
 QPointer<QTcpServer> TCPBase::IPCServer(0);
+QPointer<QLocalServer> TCPBase::IPCLocalServer(0);
 
 TCPBase::~TCPBase()
 {
@@ -96,8 +102,8 @@ TCPBase::~TCPBase()
 #endif
         }
     }
-    // make sure this object is not in the server list anymore
-    srvsList.removeOne(this);
+    // make sure the scheduler doesn't know about this object anymore
+    HWEngineScheduler::instance().jobFinished(this);
 
     if (IPCSocket)
         IPCSocket->deleteLater();
@@ -113,8 +119,24 @@ TCPBase::TCPBase(bool demoMode, QObject *parent) :
 {
     process = 0;
 
-    if(!IPCServer)
+    if(!IPCServer && !IPCLocalServer)
+    {
+#ifdef HW_UNIX_IPC
+        // prefer unix domain socket, tcp is only used if it can't be set up
+        QString name = QString("hedgewars-ipc-%1").arg(QCoreApplication::applicationPid());
+        QLocalServer::removeServer(name);
+        IPCLocalServer = new QLocalServer(0);
+        IPCLocalServer->setMaxPendingConnections(1);
+        if (!IPCLocalServer->listen(name))
+        {
+            qWarning() << "Unable to listen on local socket, falling back to tcp:" << IPCLocalServer->errorString();
+            delete IPCLocalServer;
+        }
+    }
+
+    if(!IPCServer && !IPCLocalServer)
     {
+#endif
         IPCServer = new QTcpServer(0);
         IPCServer->setMaxPendingConnections(1);
         if (!IPCServer->listen(QHostAddress::LocalHost))
@@ -124,7 +146,7 @@ TCPBase::TCPBase(bool demoMode, QObject *parent) :
         }
     }
 
-    ipc_port=IPCServer->serverPort();
+    ipc_port = IPCServer ? IPCServer->serverPort() : 0;
 }
 
 void TCPBase::NewConnection()
@@ -135,8 +157,17 @@ void TCPBase::NewConnection()
         return;
     }
 
-    disconnect(IPCServer, SIGNAL(newConnection()), this, SLOT(NewConnection()));
-    IPCSocket = IPCServer->nextPendingConnection();
+    disconnect(ipcServer(), SIGNAL(newConnection()), this, SLOT(NewConnection()));
+    if (IPCLocalServer)
+        IPCSocket = IPCLocalServer->nextPendingConnection();
+    else
+    {
+        QTcpSocket * socket = IPCServer->nextPendingConnection();
+        // engine messages are tiny, don't let them wait for coalescing
+        if (socket)
+            socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        IPCSocket = socket;
+    }
 
     if(!IPCSocket) return;
 
@@ -144,18 +175,16 @@ void TCPBase::NewConnection()
 
     connect(IPCSocket, SIGNAL(disconnected()), this, SLOT(ClientDisconnect()));
     connect(IPCSocket, SIGNAL(readyRead()), this, SLOT(ClientRead()));
+    connect(IPCSocket, SIGNAL(bytesWritten(qint64)), this, SLOT(pumpSendSource()));
+    pumpSendSource();
     SendToClientFirst();
 
-    if(simultaneousRun())
-    {
-        srvsList.removeOne(this);
-        emit isReadyNow();
-    }
+    HWEngineScheduler::instance().jobConnected(this);
 }
 
 void TCPBase::RealStart()
 {
-    connect(IPCServer, SIGNAL(newConnection()), this, SLOT(NewConnection()));
+    connect(ipcServer(), SIGNAL(newConnection()), this, SLOT(NewConnection()));
     IPCSocket = 0;
 
 #ifdef HWLIBRARY
@@ -193,14 +222,11 @@ void TCPBase::ClientDisconnect()
     disconnect(IPCSocket, SIGNAL(readyRead()), this, SLOT(ClientRead()));
     onClientDisconnect();
 
-    if(!simultaneousRun())
-    {
 #ifdef HWLIBRARY
-        thread->quit();
-        thread->wait();
+    thread->quit();
+    thread->wait();
 #endif
-        emit isReadyNow();
-    }
+    HWEngineScheduler::instance().jobFinished(this);
 
     IPCSocket->deleteLater();
     IPCSocket = NULL;
@@ -254,37 +280,35 @@ void TCPBase::onEngineDeath(int exitCode, QProcess::ExitStatus exitStatus)
     deleteLater();
 }
 
-void TCPBase::tcpServerReady()
+void TCPBase::Start(bool couldCancelPreviousRequest)
 {
-    disconnect(srvsList.first(), SIGNAL(isReadyNow()), this, SLOT(tcpServerReady()));
+    HWEngineScheduler::instance().schedule(this, couldCancelPreviousRequest);
+}
 
-    RealStart();
+QObject * TCPBase::ipcServer()
+{
+    if (IPCLocalServer)
+        return IPCLocalServer.data();
+    else
+        return IPCServer.data();
 }
 
-void TCPBase::Start(bool couldCancelPreviousRequest)
+QStringList TCPBase::ipcArguments()
 {
-    if(srvsList.isEmpty())
+    QStringList arguments;
+
+    if (IPCLocalServer)
     {
-        srvsList.push_back(this);
-        RealStart();
+        arguments << "--ipc-socket";
+        arguments << IPCLocalServer->fullServerName();
     }
     else
     {
-        TCPBase * last = srvsList.last();
-        if(couldCancelPreviousRequest
-            && last->couldBeRemoved()
-            && (last->isConnected() || !last->hasStarted())
-            && (last->parent() == parent()))
-        {
-            srvsList.removeLast();
-            delete last;
-            Start(couldCancelPreviousRequest);
-        } else
-        {
-            connect(last, SIGNAL(isReadyNow()), this, SLOT(tcpServerReady()));
-            srvsList.push_back(this);
-        }
+        arguments << "--port";
+        arguments << QString("%1").arg(ipc_port);
     }
+
+    return arguments;
 }
 
 void TCPBase::onClientRead()
@@ -306,9 +330,39 @@ void TCPBase::SendIPC(const QByteArray & buf)
     RawSendIPC(QByteArray::fromRawData((char *)&len, 1) + buf);
 }
 
-void TCPBase::RawSendIPC(const QByteArray & buf)
+void TCPBase::streamToClient(QIODevice * source)
+{
+    m_sendSource = source;
+
+    if (IPCSocket)
+        pumpSendSource();
+}
+
+void TCPBase::pumpSendSource()
 {
     if (!IPCSocket)
+        return;
+
+    while (m_sendSource && IPCSocket->bytesToWrite() < cSendSourceBacklog)
+    {
+        QByteArray chunk = m_sendSource->read(cSendSourceChunk);
+
+        if (!chunk.isEmpty())
+            IPCSocket->write(chunk);
+
+        if (chunk.isEmpty() || m_sendSource->atEnd())
+        {
+            m_sendSource = 0;
+
+            // send what was queued behind the stream meanwhile
+            RawSendIPC(QByteArray());
+        }
+    }
+}
+
+void TCPBase::RawSendIPC(const QByteArray & buf)
+{
+    if (!IPCSocket || m_sendSource)
     {
         toSendBuf += buf;
     }
@@ -338,9 +392,9 @@ bool TCPBase::isConnected()
     return m_connected;
 }
 
-bool TCPBase::simultaneousRun()
+EngineJobKind TCPBase::jobKind()
 {
-    return false;
+    return ejGame;
 }
 
 bool TCPBase::hasStarted()
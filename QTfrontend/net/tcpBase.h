@@ -23,6 +23,8 @@
 #include <QObject>
 #include <QTcpServer>
 #include <QTcpSocket>
+#include <QLocalServer>
+#include <QLocalSocket>
 #include <QByteArray>
 #include <QString>
 #include <QDir>
@@ -34,6 +36,9 @@
 
 #include <QImage>
 
+#include "ipcbuffer.h"
+#include "enginescheduler.h"
+
 #define MAXMSGCHARS 255
 
 class TCPBase : public QObject
@@ -45,24 +50,29 @@ class TCPBase : public QObject
         virtual ~TCPBase();
 
         virtual bool couldBeRemoved();
-        virtual bool simultaneousRun();
+        virtual EngineJobKind jobKind();
         bool isConnected();
         bool hasStarted();
 
-    signals:
-        void isReadyNow();
-
     protected:
         bool m_hasStarted;
         quint16 ipc_port;
 
         void Start(bool couldCancelPreviousRequest);
 
-        QByteArray readbuffer;
+        IPCReadBuffer readbuffer;
 
         QByteArray toSendBuf;
         QByteArray demo;
 
+        // sends everything from source before any other data, reading it
+        // only as fast as the engine consumes it; source is not owned and
+        // not copied to demo
+        void streamToClient(QIODevice * source);
+
+        // engine arguments telling it where to connect to
+        QStringList ipcArguments();
+
         void SendIPC(const QByteArray & buf);
         void RawSendIPC(const QByteArray & buf);
 
@@ -73,6 +83,7 @@ class TCPBase : public QObject
 
     private:
         static QPointer<QTcpServer> IPCServer;
+        static QPointer<QLocalServer> IPCLocalServer;
 #ifdef HWLIBRARY
         QThread * thread;
 #else
@@ -81,16 +92,19 @@ class TCPBase : public QObject
         bool m_isDemoMode;
         bool m_connected;
         void RealStart();
-        QPointer<QTcpSocket> IPCSocket;
+
+        friend class HWEngineScheduler;
+        QPointer<QIODevice> IPCSocket;
+        QPointer<QIODevice> m_sendSource;
+        static QObject * ipcServer();
 
     private slots:
         void NewConnection();
         void ClientDisconnect();
         void ClientRead();
+        void pumpSendSource();
         void StartProcessError(QProcess::ProcessError error);
         void onEngineDeath(int exitCode, QProcess::ExitStatus exitStatus);
-
-        void tcpServerReady();
 };
 
 #ifdef HWLIBRARY
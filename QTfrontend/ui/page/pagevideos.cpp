@@ -742,6 +742,12 @@ QString PageVideos::getVideosInProgress()
     return list;
 }
 
+bool PageVideos::haveVideosToEncode()
+{
+    QDir videoTempDir(cfgdir->absolutePath() + "/VideoTemp/");
+    return !videoTempDir.entryList(QStringList("*.txtout"), QDir::Files).isEmpty();
+}
+
 void PageVideos::startEncoding(const QByteArray & record)
 {
     QDir videoTempDir(cfgdir->absolutePath() + "/VideoTemp/");
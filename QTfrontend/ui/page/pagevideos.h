@@ -39,6 +39,7 @@ class PageVideos : public AbstractPage
         void addRecorder(HWRecorder* pRecorder);
         bool tryQuit(HWForm *form);
         QString getVideosInProgress(); // get multi-line string with list of videos in progress
+        bool haveVideosToEncode(); // whether startEncoding has anything to do
         void startEncoding(const QByteArray & record = QByteArray());
         void init(GameUIConfig * config);
 
@@ -32,6 +32,9 @@
 #include <QSortFilterProxyModel>
 #include <QMenu>
 #include <QScrollBar>
+#include <QTextBlock>
+#include <QTextCursor>
+#include <QTextDocument>
 
 #include "DataManager.h"
 #include "hwconsts.h"
@@ -440,7 +443,7 @@ void HWChatWidget::addLine(const QString & cssClass, QString line, bool isHighli
     beforeContentAdd();
 
     if (chatStrings.size() > 250)
-        chatStrings.removeFirst();
+        removeFirstChatLine();
 
     if (s_isTimeStamped)
     {
@@ -460,8 +463,7 @@ void HWChatWidget::addLine(const QString & cssClass, QString line, bool isHighli
     }
 
     chatStrings.append(line);
-
-    chatText->setHtml("<html><body>"+chatStrings.join("<br>")+"</body></html>");
+    appendChatHtml(line);
 
     afterContentAdd();
 }
@@ -471,11 +473,60 @@ void HWChatWidget::onServerMessage(const QString& str)
     beforeContentAdd();
 
     if (chatStrings.size() > 250)
-        chatStrings.removeFirst();
+        removeFirstChatLine();
 
     chatStrings.append("<hr>" + str + "<hr>");
+    appendChatHtml(chatStrings.last());
+
+    afterContentAdd();
+}
+
+void HWChatWidget::appendChatHtml(const QString & html)
+{
+    QTextDocument * doc = chatText->document();
+    QTextCursor cursor(doc);
+    cursor.movePosition(QTextCursor::End);
+
+    // an empty document still has one block which the first line goes into
+    int blocks = 0;
+    if (!doc->isEmpty())
+    {
+        blocks = doc->blockCount();
+        cursor.insertBlock(QTextBlockFormat(), QTextCharFormat());
+    }
+
+    cursor.insertHtml(html);
+
+    chatLineBlocks.append(doc->blockCount() - blocks);
+}
 
-    chatText->setHtml("<html><body>"+chatStrings.join("<br>")+"</body></html>");
+void HWChatWidget::removeFirstChatLine()
+{
+    if (chatStrings.isEmpty())
+        return;
+
+    chatStrings.removeFirst();
+    int blocks = chatLineBlocks.takeFirst();
+
+    QTextDocument * doc = chatText->document();
+    // the remaining first block would keep the format of the removed one
+    QTextBlockFormat nextFormat = doc->findBlockByNumber(blocks).blockFormat();
+
+    QTextCursor cursor(doc);
+    cursor.movePosition(QTextCursor::NextBlock, QTextCursor::KeepAnchor, blocks);
+    cursor.removeSelectedText();
+    cursor.setBlockFormat(nextFormat);
+}
+
+void HWChatWidget::reloadChatHtml()
+{
+    // the style sheet only applies to newly inserted html, so insert it all again
+    beforeContentAdd();
+
+    chatText->clear();
+    chatLineBlocks.clear();
+    foreach(const QString & line, chatStrings)
+        appendChatHtml(line);
 
     afterContentAdd();
 }
@@ -543,6 +594,7 @@ void HWChatWidget::clear()
 
     chatText->clear();
     chatStrings.clear();
+    chatLineBlocks.clear();
     //chatNicks->clear();
 
     // clear and re compile regexp for highlighting
@@ -773,6 +825,7 @@ void HWChatWidget::dropEvent(QDropEvent * event)
 
         setStyleSheet(style);
         chatText->document()->setDefaultStyleSheet(*s_styleSheet);
+        reloadChatHtml();
         displayNotice(tr("Stylesheet imported from %1").arg(path));
         displayNotice(tr("Enter %1 if you want to use the current StyleSheet in future, enter %2 to reset!").arg("/saveStyleSheet").arg("/discardStyleSheet"));
 
@@ -790,6 +843,7 @@ void HWChatWidget::discardStyleSheet()
 {
     setStyleSheet();
     chatText->document()->setDefaultStyleSheet(*s_styleSheet);
+    reloadChatHtml();
     displayNotice(tr("StyleSheet discarded"));
 }
 
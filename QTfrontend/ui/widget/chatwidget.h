@@ -88,6 +88,9 @@ class HWChatWidget : public QWidget
         QString linkedNick(const QString & nickname);
         void beforeContentAdd();
         void afterContentAdd();
+        void appendChatHtml(const QString & html);
+        void removeFirstChatLine();
+        void reloadChatHtml();
         bool isInGame();
 
         /**
@@ -139,6 +142,7 @@ class HWChatWidget : public QWidget
         QHBoxLayout mainLayout;
         QTextBrowser* chatText;
         QStringList chatStrings;
+        QList<int> chatLineBlocks; ///< number of text blocks each of chatStrings occupies
         QListView* chatNicks;
         SmartLineEdit* chatEditLine;
         QAction * acInfo;
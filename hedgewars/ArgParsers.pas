@@ -86,6 +86,8 @@ begin
     WriteLn(stdout, ' --frame-interval [milliseconds]');
     Writeln(stdout, ' --stereo [value]');
     WriteLn(stdout, ' --raw-quality [flags]');
+    WriteLn(stdout, ' --land-smooth-budget [milliseconds]');
+    WriteLn(stdout, ' --log-level [0-3]');
     WriteLn(stdout, ' --low-quality');
     WriteLn(stdout, ' --nomusic');
     WriteLn(stdout, ' --nosound');
@@ -132,6 +134,24 @@ begin
         end
 end;
 
+procedure setIpcSocket(path: shortstring; var wrongParameter:Boolean);
+begin
+    if not isInternal then
+        begin
+        WriteLn(stderr, 'ERROR: use of --ipc-socket is not allowed');
+        wrongParameter := true;
+        end
+    else
+{$IFDEF USE_UNIX_IPC}
+        ipcSocketPath := path
+{$ELSE}
+        begin
+        WriteLn(stderr, 'ERROR: --ipc-socket is not supported on this platform, use --port');
+        wrongParameter := true;
+        end
+{$ENDIF}
+end;
+
 function parseNick(nick: shortstring): shortstring;
 begin
     if isInternal then
@@ -215,13 +235,14 @@ const videoarray: array [0..4] of string = ('--fullscreen-width','--fullscreen-h
       otherarray: array [0..2] of string = ('--locale','--fullscreen','--showfps');
       mediaarray: array [0..9] of string = ('--fullscreen-width', '--fullscreen-height', '--width', '--height', '--depth', '--volume','--nomusic','--nosound','--locale','--fullscreen');
       allarray: array [0..17] of string = ('--fullscreen-width','--fullscreen-height', '--width', '--height', '--depth','--volume','--nomusic','--nosound','--locale','--fullscreen','--showfps','--altdmg','--frame-interval','--low-quality','--no-teamtag','--no-hogtag','--no-healthtag','--translucent-tags');
-      reallyAll: array[0..35] of shortstring = (
+      reallyAll: array[0..39] of shortstring = (
                 '--prefix', '--user-prefix', '--locale', '--fullscreen-width', '--fullscreen-height', '--width',
                 '--height', '--frame-interval', '--volume','--nomusic', '--nosound',
                 '--fullscreen', '--showfps', '--altdmg', '--low-quality', '--raw-quality', '--stereo', '--nick',
   {deprecated}  '--depth', '--set-video', '--set-audio', '--set-other', '--set-multimedia', '--set-everything',
-  {internal}    '--internal', '--port', '--recorder', '--landpreview',
-  {misc}        '--stats-only', '--gci', '--help','--no-teamtag','--no-hogtag','--no-healthtag','--translucent-tags','--lua-test');
+  {internal}    '--internal', '--port', '--ipc-socket', '--recorder', '--landpreview', '--preview-worker',
+  {misc}        '--stats-only', '--gci', '--help','--no-teamtag','--no-hogtag','--no-healthtag','--translucent-tags','--lua-test',
+                '--land-smooth-budget', '--log-level');
 var cmdIndex: byte;
 begin
     parseParameter:= false;
@@ -260,17 +281,21 @@ begin
         {"internal" options}
         {--internal}            24 : {$IFDEF HWLIBRARY}isInternal:= true{$ENDIF};
         {--port}                25 : setIpcPort( getLongIntParameter(arg, paramIndex, parseParameter), parseParameter );
-        {--recorder}            26 : startVideoRecording(paramIndex);
-        {--landpreview}         27 : GameType := gmtLandPreview;
+        {--ipc-socket}          26 : setIpcSocket( getstringParameter(arg, paramIndex, parseParameter), parseParameter );
+        {--recorder}            27 : startVideoRecording(paramIndex);
+        {--landpreview}         28 : GameType := gmtLandPreview;
+        {--preview-worker}      29 : cPreviewWorker := true;
         {anything else}
-        {--stats-only}          28 : statsOnlyGame();
-        {--gci}                 29 : GciEasterEgg();
-        {--help}                30 : DisplayUsage();
-        {--no-teamtag}          31 : cTagsMask := cTagsMask and (not htTeamName);
-        {--no-hogtag}           32 : cTagsMask := cTagsMask and (not htName);
-        {--no-healthtag}        33 : cTagsMask := cTagsMask and (not htHealth);
-        {--translucent-tags}    34 : cTagsMask := cTagsMask or htTransparent;
-        {--lua-test}            35 : begin cTestLua := true; SetSound(false); cScriptName := getstringParameter(arg, paramIndex, parseParameter); WriteLn(stdout, 'Lua test file specified: ' + cScriptName);end;
+        {--stats-only}          30 : statsOnlyGame();
+        {--gci}                 31 : GciEasterEgg();
+        {--help}                32 : DisplayUsage();
+        {--no-teamtag}          33 : cTagsMask := cTagsMask and (not htTeamName);
+        {--no-hogtag}           34 : cTagsMask := cTagsMask and (not htName);
+        {--no-healthtag}        35 : cTagsMask := cTagsMask and (not htHealth);
+        {--translucent-tags}    36 : cTagsMask := cTagsMask or htTransparent;
+        {--lua-test}            37 : begin cTestLua := true; SetSound(false); cScriptName := getstringParameter(arg, paramIndex, parseParameter); WriteLn(stdout, 'Lua test file specified: ' + cScriptName);end;
+        {--land-smooth-budget}  38 : cLandSmoothBudget := max(getLongIntParameter(arg, paramIndex, parseParameter), 0);
+        {--log-level}           39 : cLogLevel := TLogLevel(min(max(getLongIntParameter(arg, paramIndex, parseParameter), 0), ord(High(TLogLevel))));
     else
         begin
         //Assume the first "non parameter" is the replay file, anything else is invalid
@@ -30,7 +30,7 @@ program hwengine;
 {$ENDIF}
 
 uses SDLh, uMisc, uConsole, uGame, uConsts, uLand, uAmmos, uVisualGears, uGears, uStore, uWorld, uInputHandler
-     , uSound, uScript, uTeams, uStats, uIO, uLocale, uChat, uAI, uAIMisc, uAILandMarks, uLandTexture, uCollisions
+     , uSound, uScript, uTeams, uStats, uIO, uLocale, uChat, uAI, uAIMisc, uAILandMarks, uLandTexture, uLandGraphics, uCollisions
      , SysUtils, uTypes, uVariables, uCommands, uUtils, uCaptions, uDebug, uCommandHandlers, uLandPainted
      , uPhysFSLayer, uCursor, uRandom, ArgParsers, uVisualGearsHandlers, uTextures, uRender
      {$IFDEF USE_VIDEO_RECORDING}, uVideoRec {$ENDIF}
@@ -100,8 +100,12 @@ begin
         gsConfirm, gsGame, gsChat:
             begin
             if not cOnlyStats then
+                begin
+                // smoothing of explosion borders left over by SweepDirty
+                SmoothDirtyLand;
                 // never place between ProcessKbd and DoGameTick - bugs due to /put cmd and isCursorVisible
                 DrawWorld(Lag);
+                end;
             DoGameTick(Lag);
             if not cOnlyStats then ProcessVisualGears(Lag);
             end;
@@ -539,20 +543,45 @@ begin
 end;
 
 ///////////////////////////////////////////////////////////////////////////////
+// resetLandPreview - drop the previous map config, keeping commands and IPC
+procedure resetLandPreview;
+begin
+    uScript.freeModule;
+    uLandPainted.freeModule;
+    uLand.freeModule;
+
+    uVariables.initModule;
+    uScript.initModule;
+
+    // uVariables.initModule restored the default land size, forget it like
+    // uLand.initModule does so that ResizeLand allocates the next map again
+    LAND_WIDTH:= 0;
+    LAND_HEIGHT:= 0;
+    LAND_PIXELS_WIDTH:= 0;
+    LandTilesValid:= false;
+end;
+
 procedure GenLandPreview;
 var Preview: TPreviewAlpha;
 begin
     initEverything(false);
 
     InitIPC;
-    IPCWaitPongEvent;
-    TryDo(InitStepsFlags = cifRandomize, 'Some parameters not set (flags = ' + inttostr(InitStepsFlags) + ')', true);
-
-    ScriptOnPreviewInit;
-    GenPreviewAlpha(Preview);
-    WriteLnToConsole('Sending preview...');
-    SendIPCRaw(@Preview, sizeof(Preview));
-    SendIPCRaw(@MaxHedgehogs, sizeof(byte));
+    repeat
+        IPCWaitPongEvent;
+        TryDo(InitStepsFlags = cifRandomize, 'Some parameters not set (flags = ' + inttostr(InitStepsFlags) + ')', true);
+
+        ScriptOnPreviewInit;
+        GenPreviewAlpha(Preview);
+        WriteLnToConsole('Sending preview...');
+        SendIPCRaw(@Preview, sizeof(Preview));
+        SendIPCRaw(@MaxHedgehogs, sizeof(byte));
+
+        // a preview worker serves requests until the frontend disconnects
+        if cPreviewWorker then
+            resetLandPreview;
+    until not cPreviewWorker;
+
     WriteLnToConsole('Preview sent, disconnect');
     freeEverything(false);
 end;
@@ -40,6 +40,30 @@ var BestActions: TActions;
     ThinkThread: PSDL_Thread;
     ThreadLock: PSDL_Mutex;
 
+// the ammo tests of one walk position are independent of each other and
+// are spread over a pool of worker threads, see TestAmmos
+const cMaxAIWorkers = 8;
+
+type TAmmoJob = record
+        TargetIndex: LongInt;
+        Ammo: TAmmoType;
+        Seed: LongWord;
+        Done: boolean;
+        Score: LongInt;
+        ap: TAttackParams;
+        end;
+
+var Jobs: array of TAmmoJob;
+    JobsCount, NextJob: LongInt;
+    JobMe: PGear;
+    JobBotLevel: Byte;
+    ThinkSeed, JobSerial: LongWord;
+    JobLock: PSDL_Mutex;
+    WorkSem, DoneSem: PSDL_sem;
+    Workers: array[0..Pred(cMaxAIWorkers)] of PSDL_Thread;
+    WorkersCount: LongInt;
+    WorkersStarted, StopWorkers: boolean;
+
 procedure FreeActionsList;
 begin
     AddFileLog('FreeActionsList called');
@@ -103,10 +127,105 @@ end;
 
 
 
+procedure AddAmmoJob(targ: LongInt; am: TAmmoType);
+begin
+if JobsCount = Length(Jobs) then
+    SetLength(Jobs, JobsCount * 2 + 64);
+with Jobs[JobsCount] do
+    begin
+    TargetIndex:= targ;
+    Ammo:= am;
+    // own random sequence for each job, whichever thread runs it
+    Seed:= ThinkSeed xor (JobSerial shl 16) xor JobSerial;
+    Done:= false
+    end;
+inc(JobSerial);
+inc(JobsCount)
+end;
+
+// takes jobs off the list until none is left, run by the thinking thread
+// and the workers alike
+procedure RunAmmoJobs;
+var k: LongInt;
+begin
+repeat
+    SDL_LockMutex(JobLock);
+    k:= NextJob;
+    if k < JobsCount then
+        inc(NextJob);
+    SDL_UnlockMutex(JobLock);
+
+    if (k < JobsCount) and (not StopThinking) then
+        with Jobs[k] do
+            begin
+            CopyTargets;
+            AIrandomize(Seed);
+{$HINTS OFF}
+            Score:= AmmoTests[Ammo].proc(JobMe, Targets.ar[TargetIndex], JobBotLevel, ap);
+{$HINTS ON}
+            Done:= true
+            end
+until k >= JobsCount
+end;
+
+function AmmoWorker(param: Pointer): LongInt; cdecl; export;
+begin
+param:= param; // avoid compiler hint
+SDL_SemWait(WorkSem);
+while not StopWorkers do
+    begin
+    RunAmmoJobs;
+    SDL_SemPost(DoneSem);
+    SDL_SemWait(WorkSem)
+    end;
+AmmoWorker:= 0
+end;
+
+procedure StartWorkers;
+var i, n: LongInt;
+begin
+WorkersStarted:= true;
+n:= 0;
+{$IFNDEF PAS2C}
+{$IFDEF SDL2}
+// one core is left to the game, the thinking thread takes jobs as well
+n:= Max(0, Min(SDL_GetCPUCount() - 2, cMaxAIWorkers));
+{$ENDIF}
+{$ENDIF}
+for i:= 1 to n do
+    begin
+    Workers[WorkersCount]:= SDL_CreateThread(@AmmoWorker{$IFDEF SDL2}, 'aiworker'{$ENDIF}, nil);
+    if Workers[WorkersCount] <> nil then
+        inc(WorkersCount)
+    end;
+AddFileLog('AI: ' + inttostr(WorkersCount) + ' worker threads');
+end;
+
+procedure RunJobs;
+var i, helpers: LongInt;
+    randState: LongWord;
+begin
+// jobs reseed the generator of whichever thread runs them, keep the
+// thinking thread's sequence independent of which jobs it picked up
+randState:= AIRandState;
+NextJob:= 0;
+if JobsCount > 1 then
+    helpers:= WorkersCount
+else
+    helpers:= 0;
+
+for i:= 1 to helpers do
+    SDL_SemPost(WorkSem);
+RunAmmoJobs;
+for i:= 1 to helpers do
+    SDL_SemWait(DoneSem);
+AIRandState:= randState
+end;
+
 procedure TestAmmos(var Actions: TActions; Me: PGear; rareChecks: boolean);
 var BotLevel: Byte;
     ap: TAttackParams;
-    Score, i, t, n, dAngle: LongInt;
+    Score, i, k, t, n, dAngle: LongInt;
     a, aa: TAmmoType;
     useThisActions: boolean;
 begin
@@ -114,132 +233,142 @@ BotLevel:= Me^.Hedgehog^.BotLevel;
 windSpeed:= hwFloat2Float(cWindSpeed);
 useThisActions:= false;
 
+JobsCount:= 0;
 for i:= 0 to Pred(Targets.Count) do
     if (Targets.ar[i].Score >= 0) and (not StopThinking) then
         begin
         with Me^.Hedgehog^ do
             a:= CurAmmoType;
         aa:= a;
-        SDL_delay(0); // hint to let the context switch run
         repeat
         if (CanUseAmmo[a])
             and ((not rareChecks) or ((AmmoTests[a].flags and amtest_Rare) = 0))
             and ((i = 0) or ((AmmoTests[a].flags and amtest_NoTarget) = 0))
             then
+            AddAmmoJob(i, a);
+        if a = High(TAmmoType) then
+            a:= Low(TAmmoType)
+        else inc(a)
+        until (a = aa) or (CurrentHedgehog^.MultiShootAttacks > 0) {shooting same weapon}
+        end;
+
+JobMe:= Me;
+JobBotLevel:= BotLevel;
+RunJobs;
+
+// results are taken in list order, so the choice doesn't depend on which
+// thread finished first. A job skipped by StopThinking ends the list
+k:= 0;
+while (k < JobsCount) and Jobs[k].Done do
+    begin
+    a:= Jobs[k].Ammo;
+    ap:= Jobs[k].ap;
+    Score:= Jobs[k].Score;
+    if (Score > BadTurn) and (Actions.Score + Score > BestActions.Score) then
+        if (BestActions.Score < 0) or (Actions.Score + Score > BestActions.Score + Byte(BotLevel - 1) * 2048) then
             begin
-{$HINTS OFF}
-            Score:= AmmoTests[a].proc(Me, Targets.ar[i], BotLevel, ap);
-{$HINTS ON}
-            if (Score > BadTurn) and (Actions.Score + Score > BestActions.Score) then
-                if (BestActions.Score < 0) or (Actions.Score + Score > BestActions.Score + Byte(BotLevel - 1) * 2048) then
+            if useThisActions then
+                begin
+                BestActions.Count:= Actions.Count
+                end
+            else
+                begin
+                BestActions:= Actions;
+                BestActions.isWalkingToABetterPlace:= false;
+                useThisActions:= true
+                end;
+
+            BestActions.Score:= Actions.Score + Score;
+
+            // if not between shots, activate invulnerability/vampirism if available
+            if CurrentHedgehog^.MultiShootAttacks = 0 then
+                begin
+                if HHHasAmmo(Me^.Hedgehog^, amInvulnerable) > 0 then
                     begin
-                    if useThisActions then
-                        begin
-                        BestActions.Count:= Actions.Count
-                        end
-                    else
-                        begin
-                        BestActions:= Actions;
-                        BestActions.isWalkingToABetterPlace:= false;
-                        useThisActions:= true
-                        end;
+                    AddAction(BestActions, aia_Weapon, Longword(amInvulnerable), 80, 0, 0);
+                    AddAction(BestActions, aia_attack, aim_push, 10, 0, 0);
+                    AddAction(BestActions, aia_attack, aim_release, 10, 0, 0);
+                    end;
 
-                    BestActions.Score:= Actions.Score + Score;
+                if HHHasAmmo(Me^.Hedgehog^, amExtraDamage) > 0 then
+                    begin
+                    AddAction(BestActions, aia_Weapon, Longword(amExtraDamage), 80, 0, 0);
+                    AddAction(BestActions, aia_attack, aim_push, 10, 0, 0);
+                    AddAction(BestActions, aia_attack, aim_release, 10, 0, 0);
+                    end;
+                end;
 
-                    // if not between shots, activate invulnerability/vampirism if available
-                    if CurrentHedgehog^.MultiShootAttacks = 0 then
-                        begin
-                        if HHHasAmmo(Me^.Hedgehog^, amInvulnerable) > 0 then
-                            begin
-                            AddAction(BestActions, aia_Weapon, Longword(amInvulnerable), 80, 0, 0);
-                            AddAction(BestActions, aia_attack, aim_push, 10, 0, 0);
-                            AddAction(BestActions, aia_attack, aim_release, 10, 0, 0);
-                            end;
-
-                        if HHHasAmmo(Me^.Hedgehog^, amExtraDamage) > 0 then
-                            begin
-                            AddAction(BestActions, aia_Weapon, Longword(amExtraDamage), 80, 0, 0);
-                            AddAction(BestActions, aia_attack, aim_push, 10, 0, 0);
-                            AddAction(BestActions, aia_attack, aim_release, 10, 0, 0);
-                            end;
-                        end;
+            AddAction(BestActions, aia_Weapon, Longword(a), 300 + AIrandom(400), 0, 0);
 
-                    AddAction(BestActions, aia_Weapon, Longword(a), 300 + random(400), 0, 0);
+            if (ap.Angle > 0) then
+                AddAction(BestActions, aia_LookRight, 0, 200, 0, 0)
+            else if (ap.Angle < 0) then
+                AddAction(BestActions, aia_LookLeft, 0, 200, 0, 0);
 
-                    if (ap.Angle > 0) then
-                        AddAction(BestActions, aia_LookRight, 0, 200, 0, 0)
-                    else if (ap.Angle < 0) then
-                        AddAction(BestActions, aia_LookLeft, 0, 200, 0, 0);
+            if (Ammoz[a].Ammo.Propz and ammoprop_Timerable) <> 0 then
+                AddAction(BestActions, aia_Timer, ap.Time div 1000, 400, 0, 0);
 
-                    if (Ammoz[a].Ammo.Propz and ammoprop_Timerable) <> 0 then
-                        AddAction(BestActions, aia_Timer, ap.Time div 1000, 400, 0, 0);
+            if (Ammoz[a].Ammo.Propz and ammoprop_NoCrosshair) = 0 then
+                begin
+                dAngle:= LongInt(Me^.Angle) - Abs(ap.Angle);
+                if dAngle > 0 then
+                    begin
+                    AddAction(BestActions, aia_Up, aim_push, 300 + AIrandom(250), 0, 0);
+                    AddAction(BestActions, aia_Up, aim_release, dAngle, 0, 0)
+                    end
+                else if dAngle < 0 then
+                    begin
+                    AddAction(BestActions, aia_Down, aim_push, 300 + AIrandom(250), 0, 0);
+                    AddAction(BestActions, aia_Down, aim_release, -dAngle, 0, 0)
+                    end
+                end;
 
-                    if (Ammoz[a].Ammo.Propz and ammoprop_NoCrosshair) = 0 then
-                        begin
-                        dAngle:= LongInt(Me^.Angle) - Abs(ap.Angle);
-                        if dAngle > 0 then
-                            begin
-                            AddAction(BestActions, aia_Up, aim_push, 300 + random(250), 0, 0);
-                            AddAction(BestActions, aia_Up, aim_release, dAngle, 0, 0)
-                            end
-                        else if dAngle < 0 then
-                            begin
-                            AddAction(BestActions, aia_Down, aim_push, 300 + random(250), 0, 0);
-                            AddAction(BestActions, aia_Down, aim_release, -dAngle, 0, 0)
-                            end
-                        end;
+            if (Ammoz[a].Ammo.Propz and ammoprop_NeedTarget) <> 0 then
+                begin
+                AddAction(BestActions, aia_Put, 0, 1, ap.AttackPutX, ap.AttackPutY)
+                end;
 
-                    if (Ammoz[a].Ammo.Propz and ammoprop_NeedTarget) <> 0 then
-                        begin
-                        AddAction(BestActions, aia_Put, 0, 1, ap.AttackPutX, ap.AttackPutY)
-                        end;
+            if (Ammoz[a].Ammo.Propz and ammoprop_OscAim) <> 0 then
+                begin
+                AddAction(BestActions, aia_attack, aim_push, 350 + AIrandom(200), 0, 0);
+                AddAction(BestActions, aia_attack, aim_release, 1, 0, 0);
 
-                    if (Ammoz[a].Ammo.Propz and ammoprop_OscAim) <> 0 then
-                        begin
-                        AddAction(BestActions, aia_attack, aim_push, 350 + random(200), 0, 0);
-                        AddAction(BestActions, aia_attack, aim_release, 1, 0, 0);
-
-                        if abs(ap.Angle) > 32 then
-                           begin
-                           AddAction(BestActions, aia_Down, aim_push, 100 + random(150), 0, 0);
-                           AddAction(BestActions, aia_Down, aim_release, 32, 0, 0);
-                           end;
-
-                        AddAction(BestActions, aia_waitAngle, ap.Angle, 250, 0, 0);
-                        AddAction(BestActions, aia_attack, aim_push, 1, 0, 0);
-                        AddAction(BestActions, aia_attack, aim_release, 1, 0, 0);
-                        end else
-                        if (Ammoz[a].Ammo.Propz and ammoprop_AttackingPut) = 0 then
-                            begin
-                            if (AmmoTests[a].flags and amtest_MultipleAttacks) = 0 then
-                                n:= 1 else n:= ap.AttacksNum;
-
-                            AddAction(BestActions, aia_attack, aim_push, 650 + random(300), 0, 0);
-                            for t:= 2 to n do
-                                begin
-                                AddAction(BestActions, aia_attack, aim_push, 150, 0, 0);
-                                AddAction(BestActions, aia_attack, aim_release, ap.Power, 0, 0);
-                                end;
-                            AddAction(BestActions, aia_attack, aim_release, ap.Power, 0, 0);
-                            end;
-
-                    if (Ammoz[a].Ammo.Propz and ammoprop_Track) <> 0 then
+                if abs(ap.Angle) > 32 then
+                   begin
+                   AddAction(BestActions, aia_Down, aim_push, 100 + AIrandom(150), 0, 0);
+                   AddAction(BestActions, aia_Down, aim_release, 32, 0, 0);
+                   end;
+
+                AddAction(BestActions, aia_waitAngle, ap.Angle, 250, 0, 0);
+                AddAction(BestActions, aia_attack, aim_push, 1, 0, 0);
+                AddAction(BestActions, aia_attack, aim_release, 1, 0, 0);
+                end else
+                if (Ammoz[a].Ammo.Propz and ammoprop_AttackingPut) = 0 then
+                    begin
+                    if (AmmoTests[a].flags and amtest_MultipleAttacks) = 0 then
+                        n:= 1 else n:= ap.AttacksNum;
+
+                    AddAction(BestActions, aia_attack, aim_push, 650 + AIrandom(300), 0, 0);
+                    for t:= 2 to n do
                         begin
-                        AddAction(BestActions, aia_waitAmmoXY, 0, 12, ap.ExplX, ap.ExplY);
-                        AddAction(BestActions, aia_attack, aim_push, 1, 0, 0);
-                        AddAction(BestActions, aia_attack, aim_release, 7, 0, 0);
+                        AddAction(BestActions, aia_attack, aim_push, 150, 0, 0);
+                        AddAction(BestActions, aia_attack, aim_release, ap.Power, 0, 0);
                         end;
+                    AddAction(BestActions, aia_attack, aim_release, ap.Power, 0, 0);
+                    end;
 
-                    if ap.ExplR > 0 then
-                        AddAction(BestActions, aia_AwareExpl, ap.ExplR, 10, ap.ExplX, ap.ExplY);
-                    end
+            if (Ammoz[a].Ammo.Propz and ammoprop_Track) <> 0 then
+                begin
+                AddAction(BestActions, aia_waitAmmoXY, 0, 12, ap.ExplX, ap.ExplY);
+                AddAction(BestActions, aia_attack, aim_push, 1, 0, 0);
+                AddAction(BestActions, aia_attack, aim_release, 7, 0, 0);
+                end;
+
+            if ap.ExplR > 0 then
+                AddAction(BestActions, aia_AwareExpl, ap.ExplR, 10, ap.ExplX, ap.ExplY);
             end;
-        if a = High(TAmmoType) then
-            a:= Low(TAmmoType)
-        else inc(a)
-        until (a = aa) or (CurrentHedgehog^.MultiShootAttacks > 0) {shooting same weapon}
-            or StopThinking
-        end
+    inc(k)
+    end
 end;
 
 procedure Walk(Me: PGear; var Actions: TActions);
@@ -277,12 +406,12 @@ BaseRate:= Max(BestRate, 0);
 
 // switch to 'skip' if we cannot move because of mouse cursor being shown
 if (Ammoz[Me^.Hedgehog^.CurAmmoType].Ammo.Propz and ammoprop_NeedTarget) <> 0 then
-    AddAction(Actions, aia_Weapon, Longword(amSkip), 100 + random(200), 0, 0);
+    AddAction(Actions, aia_Weapon, Longword(amSkip), 100 + AIrandom(200), 0, 0);
 
 if ((CurrentHedgehog^.MultiShootAttacks = 0) or ((Ammoz[Me^.Hedgehog^.CurAmmoType].Ammo.Propz and ammoprop_NoMoveAfter) = 0))
     and (GameFlags and gfArtillery = 0) and (cGravityf <> 0) then
     begin
-    tmp:= random(2) + 1;
+    tmp:= AIrandom(2) + 1;
     Push(0, Actions, Me^, tmp);
     Push(0, Actions, Me^, tmp xor 3);
 
@@ -324,7 +453,7 @@ if ((CurrentHedgehog^.MultiShootAttacks = 0) or ((Ammoz[Me^.Hedgehog^.CurAmmoTyp
                         else
                             AddAction(MadeActions, aia_LookLeft, 0, 200, 0, 0);
 
-                        AddAction(MadeActions, aia_HJump, 0, 305 + random(50), 0, 0);
+                        AddAction(MadeActions, aia_HJump, 0, 305 + AIrandom(50), 0, 0);
                         AddAction(MadeActions, aia_HJump, 0, 350, 0, 0);
                         end;
                     // but first check walking forward
@@ -346,7 +475,7 @@ if ((CurrentHedgehog^.MultiShootAttacks = 0) or ((Ammoz[Me^.Hedgehog^.CurAmmoTyp
                         else
                             AddAction(MadeActions, aia_LookRight, 0, 200, 0, 0);
 
-                        AddAction(MadeActions, aia_LJump, 0, 305 + random(50), 0, 0);
+                        AddAction(MadeActions, aia_LJump, 0, 305 + AIrandom(50), 0, 0);
                         end;
 
                 // push current position so we proceed from it after checking jump+forward walk opportunities
@@ -355,7 +484,7 @@ if ((CurrentHedgehog^.MultiShootAttacks = 0) or ((Ammoz[Me^.Hedgehog^.CurAmmoTyp
                 // first check where we go after jump walking forward
                 if Push(ticks, Actions, AltMe, Me^.Message) then
                     with Stack.States[Pred(Stack.Count)] do
-                        AddAction(MadeActions, aia_LJump, 0, 305 + random(50), 0, 0);
+                        AddAction(MadeActions, aia_LJump, 0, 305 + AIrandom(50), 0, 0);
                 break
                 end;
 
@@ -389,7 +518,7 @@ if ((CurrentHedgehog^.MultiShootAttacks = 0) or ((Ammoz[Me^.Hedgehog^.CurAmmoTyp
             if GoInfo.FallPix >= FallPixForBranching then
                 Push(ticks, Actions, Me^, Me^.Message xor 3); // aia_Left xor 3 = aia_Right
 
-            if (StartTicks > GameTicks - 1500) and (not StopThinking) then
+            if (StartTicks > GameTicks - 1500) and (not StopThinking) and (not cOnlyStats) then
                 SDL_Delay(1000);
 
             end {while};
@@ -409,6 +538,7 @@ var BackMe, WalkMe: TGear;
 begin
 dmgMod:= 0.01 * hwFloat2Float(cDamageModifier) * cDamagePercent;
 StartTicks:= GameTicks;
+AIrandomize(ThinkSeed);
 
 currHedgehogIndex:= CurrentTeam^.CurrHedgehog;
 itHedgehog:= currHedgehogIndex;
@@ -435,12 +565,12 @@ if ((Me^.State and gstAttacked) = 0) or isInMultiShoot or bonuses.activity then
                     begin
                     // when AI has to use switcher, make it cost smth unless they have a lot of switches
                     if (switchCount < 10) then Actions.Score:= (-27+switchCount*3)*4000;
-                    AddAction(Actions, aia_Weapon, Longword(amSwitch), 300 + random(200), 0, 0);
-                    AddAction(Actions, aia_attack, aim_push, 300 + random(300), 0, 0);
+                    AddAction(Actions, aia_Weapon, Longword(amSwitch), 300 + AIrandom(200), 0, 0);
+                    AddAction(Actions, aia_attack, aim_push, 300 + AIrandom(300), 0, 0);
                     AddAction(Actions, aia_attack, aim_release, 1, 0, 0);
                     end;
                 for i:= 1 to switchesNum do
-                    AddAction(Actions, aia_Switch, 0, 300 + random(200), 0, 0);
+                    AddAction(Actions, aia_Switch, 0, 300 + AIrandom(200), 0, 0);
                 end;
             Walk(@WalkMe, Actions);
 
@@ -455,7 +585,9 @@ if ((Me^.State and gstAttacked) = 0) or isInMultiShoot or bonuses.activity then
             or (itHedgehog = currHedgehogIndex)
             or BestActions.isWalkingToABetterPlace;
 
-            if (StartTicks > GameTicks - 1500) and (not StopThinking) then
+            // only there to not have bots act instantly, nobody watches
+            // a stats-only game
+            if (StartTicks > GameTicks - 1500) and (not StopThinking) and (not cOnlyStats) then
                 SDL_Delay(700);
 
         if (BestActions.Score < -1023) and (not BestActions.isWalkingToABetterPlace) then
@@ -468,7 +600,12 @@ if ((Me^.State and gstAttacked) = 0) or isInMultiShoot or bonuses.activity then
                 AddAction(BestActions, aia_Skip, 0, 250, 0, 0);
             end;
 
-        end else SDL_Delay(100)
+        end
+    else
+        begin
+        if not cOnlyStats then
+            SDL_Delay(100)
+        end
 else
     begin
     BackMe:= Me^;
@@ -489,6 +626,7 @@ else
         Actions.Score:= 0;
         Walk(@WalkMe, Actions);
         if not bonuses.activity then dec(i);
+        // wait for the gears that keep bonuses.activity up to move on
         if not StopThinking then
             SDL_Delay(100)
         end
@@ -519,6 +657,11 @@ BestActions.isWalkingToABetterPlace:= false;
 
 StopThinking:= false;
 ThinkingHH:= Me;
+ThinkSeed:= GameTicks;
+JobSerial:= 0;
+
+if not WorkersStarted then
+    StartWorkers;
 
 FillTargets;
 if Targets.Count = 0 then
@@ -585,11 +728,31 @@ begin
     StartTicks:= 0;
     ThinkThread:= nil;
     ThreadLock:= SDL_CreateMutex();
+    JobLock:= SDL_CreateMutex();
+    WorkSem:= SDL_CreateSemaphore(0);
+    DoneSem:= SDL_CreateSemaphore(0);
+    WorkersCount:= 0;
+    WorkersStarted:= false;
+    StopWorkers:= false;
+    JobsCount:= 0;
 end;
 
 procedure freeModule;
+var i: LongInt;
 begin
     FreeActionsList();
+
+    StopWorkers:= true;
+    for i:= 1 to WorkersCount do
+        SDL_SemPost(WorkSem);
+    for i:= 0 to Pred(WorkersCount) do
+        SDL_WaitThread(Workers[i], nil);
+    WorkersCount:= 0;
+    SetLength(Jobs, 0);
+
+    SDL_DestroySemaphore(DoneSem);
+    SDL_DestroySemaphore(WorkSem);
+    SDL_DestroyMutex(JobLock);
     SDL_DestroyMutex(ThreadLock);
 end;
 
@@ -150,7 +150,7 @@ rTime:= 350;
 ap.ExplR:= 0;
 valueResult:= BadTurn;
 repeat
-    rTime:= rTime + 300 + Level * 50 + random(300);
+    rTime:= rTime + 300 + Level * 50 + AIrandom(300);
     Vx:= - windSpeed * rTime * 0.5 + (Targ.Point.X + AIrndSign(2) - mX) / rTime;
     Vy:= cGravityf * rTime * 0.5 - (Targ.Point.Y + 1 - mY) / rTime;
     r:= sqr(Vx) + sqr(Vy);
@@ -179,8 +179,8 @@ repeat
             value:= 1024 - Metric(Targ.Point.X, Targ.Point.Y, EX, EY) div 64;
         if valueResult <= value then
             begin
-            ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(random((Level - 1) * 9));
-            ap.Power:= trunc(sqrt(r) * cMaxPower) - random((Level - 1) * 17 + 1);
+            ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(AIrandom((Level - 1) * 9));
+            ap.Power:= trunc(sqrt(r) * cMaxPower) - AIrandom((Level - 1) * 17 + 1);
             ap.ExplR:= 100;
             ap.ExplX:= EX;
             ap.ExplY:= EY;
@@ -214,7 +214,7 @@ begin
     valueResult:= BadTurn;
     timer:= 0;
     repeat
-        rTime:= rTime + 300 + Level * 50 + random(300);
+        rTime:= rTime + 300 + Level * 50 + AIrandom(300);
         Vx:= - windSpeed * rTime * 0.5 + (Targ.Point.X + AIrndSign(2) - mX) / rTime;
         Vy:= cGravityf * rTime * 0.5 - (Targ.Point.Y - 35 - mY) / rTime;
         r:= sqr(Vx) + sqr(Vy);
@@ -261,8 +261,8 @@ begin
             else value:= RateExplosion(Me, EX, EY, 101);
             if valueResult <= value then
                 begin
-                ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(random((Level - 1) * 9));
-                ap.Power:= trunc(sqrt(r) * cMaxPower) - random((Level - 1) * 17 + 1);
+                ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(AIrandom((Level - 1) * 9));
+                ap.Power:= trunc(sqrt(r) * cMaxPower) - AIrandom((Level - 1) * 17 + 1);
                 ap.ExplR:= 100;
                 ap.ExplX:= EX;
                 ap.ExplY:= EY;
@@ -291,7 +291,7 @@ rTime:= 350;
 ap.ExplR:= 0;
 valueResult:= BadTurn;
 repeat
-    rTime:= rTime + 300 + Level * 50 + random(1000);
+    rTime:= rTime + 300 + Level * 50 + AIrandom(1000);
     Vx:= - windSpeed * rTime * 0.5 + ((Targ.Point.X + AIrndSign(2)) - meX) / rTime;
     Vy:= cGravityf * rTime * 0.5 - (Targ.Point.Y - meY) / rTime;
     r:= sqr(Vx) + sqr(Vy);
@@ -320,8 +320,8 @@ repeat
 
         if valueResult <= value then
             begin
-            ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(random((Level - 1) * 9));
-            ap.Power:= trunc(sqrt(r) * cMaxPower) - random((Level - 1) * 17 + 1);
+            ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(AIrandom((Level - 1) * 9));
+            ap.Power:= trunc(sqrt(r) * cMaxPower) - AIrandom((Level - 1) * 17 + 1);
             ap.ExplR:= 0;
             ap.ExplX:= EX;
             ap.ExplY:= EY;
@@ -371,8 +371,8 @@ repeat
 
         if valueResult < Score then
             begin
-            ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(random(Level));
-            ap.Power:= trunc(sqrt(r) * cMaxPower) + AIrndSign(random(Level) * 15);
+            ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(AIrandom(Level));
+            ap.Power:= trunc(sqrt(r) * cMaxPower) + AIrndSign(AIrandom(Level) * 15);
             ap.ExplR:= 100;
             ap.ExplX:= EX;
             ap.ExplY:= EY;
@@ -425,8 +425,8 @@ repeat
 
     if (valueResult < Score) and (Score > 0) then
         begin
-        ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(random(Level * 3));
-        ap.Power:= trunc(sqrt(r) * cMaxPower) + AIrndSign(random(Level) * 20);
+        ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(AIrandom(Level * 3));
+        ap.Power:= trunc(sqrt(r) * cMaxPower) + AIrndSign(AIrandom(Level) * 20);
         ap.Time:= TestTime;
         ap.ExplR:= 100;
         ap.ExplX:= EX;
@@ -483,8 +483,8 @@ repeat
 
      if Score > 0 then
         begin
-        ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(random(Level * 2));
-        ap.Power:= trunc(sqrt(r) * cMaxPower) + AIrndSign(random(Level) * 15);
+        ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(AIrandom(Level * 2));
+        ap.Power:= trunc(sqrt(r) * cMaxPower) + AIrndSign(AIrandom(Level) * 15);
         ap.Time:= TestTime div 1000 * 1000;
         ap.ExplR:= 90;
         ap.ExplX:= EX;
@@ -537,8 +537,8 @@ repeat
 
         if valueResult < Score then
             begin
-            ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(random(Level));
-            ap.Power:= trunc(sqrt(r) * cMaxPower) + AIrndSign(random(Level) * 15);
+            ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(AIrandom(Level));
+            ap.Power:= trunc(sqrt(r) * cMaxPower) + AIrndSign(AIrandom(Level) * 15);
             ap.Time:= TestTime div 1000 * 1000;
             ap.ExplR:= 300;
             ap.ExplX:= EX;
@@ -625,7 +625,7 @@ begin
 
     if Score > 0 then
         begin
-        ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(random(Level));
+        ap.Angle:= DxDy2AttackAnglef(Vx, Vy) + AIrndSign(AIrandom(Level));
         ap.Power:= 1;
         ap.ExplR:= 100;
         ap.ExplX:= EX;
@@ -711,7 +711,7 @@ iy:= trunc(y);
 
 if ((ix and LAND_WIDTH_MASK) = 0) and ((iy and LAND_HEIGHT_MASK) = 0) then
     repeat
-        if Land[iy, ix] <> 0 then
+        if Land[iy * LAND_WIDTH + ix] <> 0 then
             inc(d);
         x:= x + vX;
         y:= y + vY;
@@ -763,7 +763,7 @@ repeat
     x:= x + vX;
     y:= y + vY;
     if ((trunc(x) and LAND_WIDTH_MASK) = 0)and((trunc(y) and LAND_HEIGHT_MASK) = 0)
-    and (Land[trunc(y), trunc(x)] <> 0) then
+    and (Land[trunc(y) * LAND_WIDTH + trunc(x)] <> 0) then
         inc(d);
 until (Abs(Targ.Point.X - trunc(x)) + Abs(Targ.Point.Y - trunc(y)) < 4)
     or (x < 0)
@@ -821,7 +821,7 @@ begin
                 valueResult:= v1
                 end;
 
-        a:= a - 15 - random(cMaxAngle div 16)
+        a:= a - 15 - AIrandom(cMaxAngle div 16)
         end;
 
     if valueResult <= 0 then
@@ -1143,7 +1143,7 @@ begin
         begin
         failNum := 0;
         repeat
-            i := random(bonuses.Count);
+            i := AIrandom(bonuses.Count);
             inc(failNum);
         until not TestColl(bonuses.ar[i].X, bonuses.ar[i].Y - cHHRadius - bonuses.ar[i].Radius, cHHRadius)
         or (failNum = bonuses.Count*2);
@@ -70,6 +70,7 @@ procedure initModule;
 procedure freeModule;
 
 procedure FillTargets;
+procedure CopyTargets;
 procedure ResetTargets; inline;
 procedure AddBonus(x, y: LongInt; r: Longword; s: LongInt); inline;
 procedure FillBonuses(isAfterAttack: boolean);
@@ -89,11 +90,20 @@ function  RateHammer(Me: PGear): LongInt;
 
 function  HHGo(Gear, AltGear: PGear; var GoInfo: TGoInfo): boolean;
 function  AIrndSign(num: LongInt): LongInt;
+procedure AIrandomize(seed: LongWord);
+function  AIrandom(m: LongInt): LongInt;
 
 var ThinkingHH: PGear;
     Targets: TTargets;
 
-    bonuses: TBonuses;
+// the rating functions work on a copy of Targets and the AI has its own
+// random generator, both private to the calling thread so that several
+// ammo tests may run at the same time
+{$IFDEF PAS2C}var{$ELSE}threadvar{$ENDIF}
+    WorkTargets: TTargets;
+    AIRandState: LongWord;
+
+var bonuses: TBonuses;
 
     walkbonuses: Twalkbonuses;
 
@@ -112,11 +122,20 @@ var
 procedure ResetTargets; inline;
 var i: LongWord;
 begin
-if Targets.reset then
-    for i:= 0 to Targets.Count do
-        Targets.ar[i].dead:= false;
-Targets.reset:= false;
+if WorkTargets.reset then
+    for i:= 0 to WorkTargets.Count do
+        WorkTargets.ar[i].dead:= false;
+WorkTargets.reset:= false;
+end;
+procedure CopyTargets;
+var i: LongWord;
+begin
+WorkTargets.Count:= Targets.Count;
+WorkTargets.reset:= false;
+for i:= 0 to Pred(Targets.Count) do
+    WorkTargets.ar[i]:= Targets.ar[i]
 end;
+
 procedure FillTargets;
 var //i, t: Longword;
     f, e: LongInt;
@@ -344,10 +363,10 @@ begin
     if not CheckBounds(x, y, r) then
         exit(false);
 
-    if (Land[y-r, x-r] <> 0) or
-       (Land[y+r, x-r] <> 0) or
-       (Land[y-r, x+r] <> 0) or
-       (Land[y+r, x+r] <> 0) then
+    if (Land[(y-r) * LAND_WIDTH + (x-r)] <> 0) or
+       (Land[(y+r) * LAND_WIDTH + (x-r)] <> 0) or
+       (Land[(y-r) * LAND_WIDTH + (x+r)] <> 0) or
+       (Land[(y+r) * LAND_WIDTH + (x+r)] <> 0) then
        exit(true);
 
     TestCollWithEverything := false;
@@ -358,10 +377,10 @@ begin
     if not CheckBounds(x, y, r) then
         exit(false);
 
-    if (Land[y-r, x-r] > lfAllObjMask) or
-       (Land[y+r, x-r] > lfAllObjMask) or
-       (Land[y-r, x-r] > lfAllObjMask) or
-       (Land[y+r, x+r] > lfAllObjMask) then
+    if (Land[(y-r) * LAND_WIDTH + (x-r)] > lfAllObjMask) or
+       (Land[(y+r) * LAND_WIDTH + (x-r)] > lfAllObjMask) or
+       (Land[(y-r) * LAND_WIDTH + (x-r)] > lfAllObjMask) or
+       (Land[(y+r) * LAND_WIDTH + (x+r)] > lfAllObjMask) then
        exit(true);
 
     TestCollExcludingObjects:= false;
@@ -372,10 +391,10 @@ begin
     if not CheckBounds(x, y, r) then
         exit(false);
 
-    if (Land[y-r, x-r] and lfNotCurrentMask <> 0) or
-       (Land[y+r, x-r] and lfNotCurrentMask <> 0) or
-       (Land[y+r, x-r] and lfNotCurrentMask <> 0) or
-       (Land[y+r, x+r] and lfNotCurrentMask <> 0) then
+    if (Land[(y-r) * LAND_WIDTH + (x-r)] and lfNotCurrentMask <> 0) or
+       (Land[(y+r) * LAND_WIDTH + (x-r)] and lfNotCurrentMask <> 0) or
+       (Land[(y+r) * LAND_WIDTH + (x-r)] and lfNotCurrentMask <> 0) or
+       (Land[(y+r) * LAND_WIDTH + (x+r)] and lfNotCurrentMask <> 0) then
        exit(true);
 
     TestColl:= false;
@@ -392,7 +411,7 @@ begin
         MeX:= hwRound(Me^.X);
         MeY:= hwRound(Me^.Y);
         // We are still inside the hog. Skip radius test
-        if ((sqr(x-MeX) + sqr(y-MeY)) < 256) and (Land[y, x] and lfObjMask = 0) then
+        if ((sqr(x-MeX) + sqr(y-MeY)) < 256) and (Land[y * LAND_WIDTH + x] and lfObjMask = 0) then
             exit(false);
     end;
     TestCollExcludingMe:= TestCollWithEverything(x, y, r)
@@ -522,7 +541,7 @@ begin
 fallDmg:= 0;
 rate:= 0;
 // add our virtual position
-with Targets.ar[Targets.Count] do
+with WorkTargets.ar[WorkTargets.Count] do
     begin
     Point.x:= hwRound(Me^.X);
     Point.y:= hwRound(Me^.Y);
@@ -540,9 +559,9 @@ else erasure:= 0;
 
 hadSkips:= false;
 
-for i:= 0 to Targets.Count do
-    if not Targets.ar[i].dead then
-        with Targets.ar[i] do
+for i:= 0 to WorkTargets.Count do
+    if not WorkTargets.ar[i].dead then
+        with WorkTargets.ar[i] do
           if not matters then hadSkips:= true
             else
             begin
@@ -570,9 +589,9 @@ for i:= 0 to Targets.Count do
                     if pY - y < 0 then dY:= -dY;
 
                     if (x and LAND_WIDTH_MASK = 0) and ((y+cHHRadius+2) and LAND_HEIGHT_MASK = 0) and
-                       (Land[y+cHHRadius+2, x] and lfIndestructible <> 0) then
-                         fallDmg:= trunc(TraceFall(x, y, pX, pY, dX, dY, 0, Targets.ar[i]) * dmgMod)
-                    else fallDmg:= trunc(TraceFall(x, y, pX, pY, dX, dY, erasure, Targets.ar[i]) * dmgMod)
+                       (Land[(y+cHHRadius+2) * LAND_WIDTH + x] and lfIndestructible <> 0) then
+                         fallDmg:= trunc(TraceFall(x, y, pX, pY, dX, dY, 0, WorkTargets.ar[i]) * dmgMod)
+                    else fallDmg:= trunc(TraceFall(x, y, pX, pY, dX, dY, erasure, WorkTargets.ar[i]) * dmgMod)
                     end;
                 if Kind = gtHedgehog then
                     begin
@@ -586,7 +605,7 @@ for i:= 0 to Targets.Count do
                     else if (dmg+fallDmg) >= abs(Score) then
                         begin
                         dead:= true;
-                        Targets.reset:= true;
+                        WorkTargets.reset:= true;
                         if dX < 0.035 then
                             begin
                             subrate:= RealRateExplosion(Me, round(pX), round(pY), 61, afErasesLand or (Flags and afTrackFall));
@@ -606,7 +625,7 @@ for i:= 0 to Targets.Count do
                 else if (fallDmg >= 0) and ((dmg+fallDmg) >= Score) then
                     begin
                     dead:= true;
-                    Targets.reset:= true;
+                    WorkTargets.reset:= true;
                     if Kind = gtExplosives then
                          subrate:= RealRateExplosion(Me, round(pX), round(pY), 151, afErasesLand or (Flags and afTrackFall))
                     else subrate:= RealRateExplosion(Me, round(pX), round(pY), 101, afErasesLand or (Flags and afTrackFall));
@@ -629,8 +648,8 @@ fallDmg:= 0;
 dX:= gdX * 0.01 * kick;
 dY:= gdY * 0.01 * kick;
 rate:= 0;
-for i:= 0 to Pred(Targets.Count) do
-    with Targets.ar[i] do
+for i:= 0 to Pred(WorkTargets.Count) do
+    with WorkTargets.ar[i] do
         if skip then
             begin
             if Flags and afSetSkip = 0 then skip:= false
@@ -651,9 +670,9 @@ for i:= 0 to Pred(Targets.Count) do
                     if (Kind = gtExplosives) and (State and gstTmpFlag = 0) and
                        (((abs(dY) > 0.15) and (abs(dX) < 0.02)) or
                         ((abs(dY) < 0.15) and (abs(dX) < 0.15))) then
-                        fallDmg:= trunc(TraceShoveFall(pX, pY, 0, dY, Targets.ar[i]) * dmgMod)
+                        fallDmg:= trunc(TraceShoveFall(pX, pY, 0, dY, WorkTargets.ar[i]) * dmgMod)
                     else
-                        fallDmg:= trunc(TraceShoveFall(pX, pY, dX, dY, Targets.ar[i]) * dmgMod);
+                        fallDmg:= trunc(TraceShoveFall(pX, pY, dX, dY, WorkTargets.ar[i]) * dmgMod);
                 if Kind = gtHedgehog then
                     begin
                     if fallDmg < 0 then // drowning. score healthier hogs higher, since their death is more likely to benefit the AI
@@ -666,7 +685,7 @@ for i:= 0 to Pred(Targets.Count) do
                     else if power+fallDmg >= abs(Score) then
                         begin
                         dead:= true;
-                        Targets.reset:= true;
+                        WorkTargets.reset:= true;
                         if dX < 0.035 then
                             begin
                             subrate:= RealRateExplosion(Me, round(pX), round(pY), 61, afErasesLand or afTrackFall);
@@ -688,7 +707,7 @@ for i:= 0 to Pred(Targets.Count) do
                 else if (fallDmg >= 0) and ((dmg+fallDmg) >= Score) then
                     begin
                     dead:= true;
-                    Targets.reset:= true;
+                    WorkTargets.reset:= true;
                     if Kind = gtExplosives then
                          subrate:= RealRateExplosion(Me, round(pX), round(pY), 151, afErasesLand or (Flags and afTrackFall))
                     else subrate:= RealRateExplosion(Me, round(pX), round(pY), 101, afErasesLand or (Flags and afTrackFall));
@@ -709,7 +728,7 @@ rate:= 0;
 gdX:= gdX * 0.01;
 gdY:= gdX * 0.01;
 // add our virtual position
-with Targets.ar[Targets.Count] do
+with WorkTargets.ar[WorkTargets.Count] do
     begin
     Point.x:= hwRound(Me^.X);
     Point.y:= hwRound(Me^.Y);
@@ -728,9 +747,9 @@ else erasure:= 0;
 
 hadSkips:= false;
 
-for i:= 0 to Targets.Count do
-    if not Targets.ar[i].dead then
-        with Targets.ar[i] do
+for i:= 0 to WorkTargets.Count do
+    if not WorkTargets.ar[i].dead then
+        with WorkTargets.ar[i] do
           if not matters then hadSkips:= true
             else
             begin
@@ -756,9 +775,9 @@ for i:= 0 to Targets.Count do
                         ((abs(dY) < 0.15) and (abs(dX) < 0.15))) then
                        dX:= 0;
                     if (x and LAND_WIDTH_MASK = 0) and ((y+cHHRadius+2) and LAND_HEIGHT_MASK = 0) and
-                       (Land[y+cHHRadius+2, x] and lfIndestructible <> 0) then
-                         fallDmg:= trunc(TraceFall(x, y, pX, pY, dX, dY, 0, Targets.ar[i]) * dmgMod)
-                    else fallDmg:= trunc(TraceFall(x, y, pX, pY, dX, dY, erasure, Targets.ar[i]) * dmgMod)
+                       (Land[(y+cHHRadius+2) * LAND_WIDTH + x] and lfIndestructible <> 0) then
+                         fallDmg:= trunc(TraceFall(x, y, pX, pY, dX, dY, 0, WorkTargets.ar[i]) * dmgMod)
+                    else fallDmg:= trunc(TraceFall(x, y, pX, pY, dX, dY, erasure, WorkTargets.ar[i]) * dmgMod)
                     end;
                 if Kind = gtHedgehog then
                     begin
@@ -772,7 +791,7 @@ for i:= 0 to Targets.Count do
                     else if (dmg+fallDmg) >= abs(Score) then
                         begin
                         dead:= true;
-                        Targets.reset:= true;
+                        WorkTargets.reset:= true;
                         if dX < 0.035 then
                             begin
                             subrate:= RealRateExplosion(Me, round(pX), round(pY), 61, afErasesLand or afTrackFall);
@@ -790,7 +809,7 @@ for i:= 0 to Targets.Count do
                 else if (fallDmg >= 0) and ((dmg+fallDmg) >= Score) then
                     begin
                     dead:= true;
-                    Targets.reset:= true;
+                    WorkTargets.reset:= true;
                     if Kind = gtExplosives then
                          subrate:= RealRateExplosion(Me, round(pX), round(pY), 151, afErasesLand or afTrackFall)
                     else subrate:= RealRateExplosion(Me, round(pX), round(pY), 101, afErasesLand or afTrackFall);
@@ -814,8 +833,8 @@ x:= hwRound(Me^.X) + hwSign(Me^.dX) * 10;
 y:= hwRound(Me^.Y);
 rate:= 0;
 
-for i:= 0 to Pred(Targets.Count) do
-    with Targets.ar[i] do
+for i:= 0 to Pred(WorkTargets.Count) do
+    with WorkTargets.ar[i] do
          // hammer hit radius is 8, shift is 10
       if matters and (Kind = gtHedgehog) and (abs(Point.x - x) + abs(Point.y - y) < 18) then
             begin
@@ -1001,12 +1020,40 @@ end;
 
 function AIrndSign(num: LongInt): LongInt;
 begin
-if random(2) = 0 then
+if AIrandom(2) = 0 then
     AIrndSign:=   num
 else
     AIrndSign:= - num
 end;
 
+procedure AIRandStep; inline;
+begin
+AIRandState:= AIRandState xor (AIRandState shl 13);
+AIRandState:= AIRandState xor (AIRandState shr 17);
+AIRandState:= AIRandState xor (AIRandState shl 5)
+end;
+
+procedure AIrandomize(seed: LongWord);
+var i: LongInt;
+begin
+// xorshift must not start from zero
+if seed = 0 then
+    seed:= $2545F491;
+AIRandState:= seed;
+// spread close seeds apart
+for i:= 1 to 4 do
+    AIRandStep
+end;
+
+function AIrandom(m: LongInt): LongInt;
+begin
+AIRandStep;
+if m <= 0 then
+    AIrandom:= 0
+else
+    AIrandom:= AIRandState mod LongWord(m)
+end;
+
 procedure initModule;
 begin
     friendlyfactor:= 300;
@@ -22,11 +22,9 @@ unit uCollisions;
 interface
 uses uFloat, uTypes;
 
-const cMaxGearArrayInd = 1023;
-
 type PGearArray = ^TGearArray;
     TGearArray = record
-        ar: array[0..cMaxGearArrayInd] of PGear;
+        ar: ^TPGearArray;
         Count: Longword
         end;
 
@@ -62,24 +60,217 @@ function  CalcSlopeNearGear(Gear: PGear; dirX, dirY: LongInt): hwFloat;
 function  CalcSlopeTangent(Gear: PGear; collisionX, collisionY: LongInt; var outDeltaX, outDeltaY: LongInt; TestWord: LongWord): boolean;
 
 implementation
-uses uConsts, uLandGraphics, uVariables, uDebug;
+uses uConsts, uLandGraphics, uVariables, uLandUtils;
 
 type TCollisionEntry = record
     X, Y, Radius: LongInt;
     cGear: PGear;
+    // broadphase grid nodes holding this entry
+    Nodes: array[0..3] of LongInt;
+    NodesCount: LongInt;
+    end;
+
+    TCollisionCellNode = record
+    ci, Bucket, Prev, Next: LongInt;
     end;
 
-const MAXRECTSINDEX = 1023;
-var Count: Longword;
-    cinfos: array[0..MAXRECTSINDEX] of TCollisionEntry;
+const cInitialEntriesCapacity = 1024;
+    // broadphase grid: 64x64 px cells hashed into a 64x32 table which
+    // covers the largest map without aliasing, anything outside just wraps
+    cCellSize = 64;
+    cGridWidth = 64;
+    cGridHeight = 32;
+    cBucketsCount = cGridWidth * cGridHeight;
+    // entries spanning more than 2x2 cells go to this extra bucket which is
+    // always checked, queries spanning more than cMaxQueryCells cells check everything
+    cBigBucket = cBucketsCount;
+    cMaxQueryCells = 16;
+
+// The registry grows on demand. Entries are kept packed in [0, Count) and
+// deleting one moves the last entry into its slot, so the order only depends
+// on the sequence of AddCI/DeleteCI calls and stays the same on all clients.
+var Count, Capacity: Longword;
+    cinfos: array of TCollisionEntry;
     ga: TGearArray;
+    gaItems: TPGearArray;
+    cellHeads: array[0..cBigBucket] of LongInt;
+    cellNodes: array of TCollisionCellNode;
+    freeCellNode: LongInt;
+    // candidate indices of the last query, sorted ascending
+    candidates: array of LongInt;
+    candidateStamps: array of LongWord;
+    queryStamp: LongWord;
+
+procedure GrowRegistry(newCapacity: LongWord);
+var i: LongInt;
+begin
+SetLength(cinfos, newCapacity);
+SetLength(candidates, newCapacity);
+SetLength(candidateStamps, newCapacity);
+for i:= Capacity to Pred(newCapacity) do
+    candidateStamps[i]:= 0;
+
+// one spare slot for AmmoShove adding the current hedgehog
+SetLength(gaItems, newCapacity + 1);
+
+// every entry takes at most 4 grid nodes
+SetLength(cellNodes, newCapacity * 4);
+for i:= Capacity * 4 to Pred(newCapacity * 4) do
+    cellNodes[i].Next:= i + 1;
+cellNodes[Pred(newCapacity * 4)].Next:= freeCellNode;
+freeCellNode:= Capacity * 4;
+
+Capacity:= newCapacity
+end;
+
+function CellCoord(v: LongInt): LongInt; inline;
+begin
+// truncates towards zero for negative values, which only makes the cells
+// around the map origin wider, the mapping stays monotonic
+CellCoord:= v div cCellSize
+end;
+
+function CellBucket(cx, cy: LongInt): LongInt; inline;
+begin
+CellBucket:= (cy and (cGridHeight - 1)) * cGridWidth + (cx and (cGridWidth - 1))
+end;
+
+procedure LinkCellNode(ci, bucket: LongInt);
+var n: LongInt;
+begin
+n:= freeCellNode;
+freeCellNode:= cellNodes[n].Next;
+
+cellNodes[n].ci:= ci;
+cellNodes[n].Bucket:= bucket;
+cellNodes[n].Prev:= -1;
+cellNodes[n].Next:= cellHeads[bucket];
+if cellHeads[bucket] >= 0 then
+    cellNodes[cellHeads[bucket]].Prev:= n;
+cellHeads[bucket]:= n;
+
+with cinfos[ci] do
+    begin
+    Nodes[NodesCount]:= n;
+    inc(NodesCount)
+    end
+end;
+
+procedure AddToGrid(ci: LongInt);
+var cx1, cy1, cx2, cy2, cx, cy: LongInt;
+begin
+with cinfos[ci] do
+    begin
+    NodesCount:= 0;
+    cx1:= CellCoord(X - Radius);
+    cx2:= CellCoord(X + Radius);
+    cy1:= CellCoord(Y - Radius);
+    cy2:= CellCoord(Y + Radius);
+    end;
+
+if (cx2 - cx1 > 1) or (cy2 - cy1 > 1) then
+    LinkCellNode(ci, cBigBucket)
+else
+    for cy:= cy1 to cy2 do
+        for cx:= cx1 to cx2 do
+            LinkCellNode(ci, CellBucket(cx, cy))
+end;
+
+procedure RemoveFromGrid(ci: LongInt);
+var i, n: LongInt;
+begin
+with cinfos[ci] do
+    begin
+    for i:= 0 to Pred(NodesCount) do
+        begin
+        n:= Nodes[i];
+        with cellNodes[n] do
+            begin
+            if Prev >= 0 then
+                cellNodes[Prev].Next:= Next
+            else
+                cellHeads[Bucket]:= Next;
+            if Next >= 0 then
+                cellNodes[Next].Prev:= Prev;
+            Next:= freeCellNode
+            end;
+        freeCellNode:= n
+        end;
+    NodesCount:= 0
+    end
+end;
+
+procedure CollectBucket(bucket: LongInt; var n: LongInt);
+var node, ci: LongInt;
+begin
+node:= cellHeads[bucket];
+while node >= 0 do
+    begin
+    ci:= cellNodes[node].ci;
+    if candidateStamps[ci] <> queryStamp then
+        begin
+        candidateStamps[ci]:= queryStamp;
+        candidates[n]:= ci;
+        inc(n)
+        end;
+    node:= cellNodes[node].Next
+    end
+end;
+
+// fills candidates with every entry which might be within r of (mx, my) plus
+// its own radius, in ascending index order so callers visit entries exactly
+// like a linear scan would
+function CollectCandidates(mx, my, r: LongInt): LongInt;
+var cx1, cy1, cx2, cy2, cx, cy, n, i, j, t: LongInt;
+begin
+cx1:= CellCoord(mx - r);
+cx2:= CellCoord(mx + r);
+cy1:= CellCoord(my - r);
+cy2:= CellCoord(my + r);
+
+if (cx2 - cx1 + 1) * (cy2 - cy1 + 1) > cMaxQueryCells then
+    begin
+    for i:= 0 to Pred(LongInt(Count)) do
+        candidates[i]:= i;
+    exit(Count)
+    end;
+
+inc(queryStamp);
+if queryStamp = 0 then
+    begin
+    for i:= 0 to Pred(LongInt(Capacity)) do
+        candidateStamps[i]:= 0;
+    queryStamp:= 1
+    end;
+
+n:= 0;
+CollectBucket(cBigBucket, n);
+for cy:= cy1 to cy2 do
+    for cx:= cx1 to cx2 do
+        CollectBucket(CellBucket(cx, cy), n);
+
+// usually just a handful of entries
+for i:= 1 to Pred(n) do
+    begin
+    t:= candidates[i];
+    j:= i;
+    while (j > 0) and (candidates[j - 1] > t) do
+        begin
+        candidates[j]:= candidates[j - 1];
+        dec(j)
+        end;
+    candidates[j]:= t
+    end;
+
+CollectCandidates:= n
+end;
 
 procedure AddCI(Gear: PGear);
 begin
-if (Gear^.CollisionIndex >= 0) or 
-    ((Count > MAXRECTSINDEX-200) and ((Gear^.Kind = gtMine) or (Gear^.Kind = gtSMine) or (Gear^.Kind = gtKnife))) then
+if Gear^.CollisionIndex >= 0 then
     exit;
-TryDo(Count <= MAXRECTSINDEX, 'Collision rects array overflow', true);
+if Count = Capacity then
+    GrowRegistry(Capacity * 2);
 with cinfos[Count] do
     begin
     X:= hwRound(Gear^.X);
@@ -88,18 +279,30 @@ with cinfos[Count] do
     ChangeRoundInLand(X, Y, Radius - 1, true, (Gear = CurrentHedgehog^.Gear) or ((Gear^.Kind = gtCase) and (Gear^.State and gstFrozen = 0)));
     cGear:= Gear
     end;
+AddToGrid(Count);
 Gear^.CollisionIndex:= Count;
 inc(Count);
 end;
 
 procedure DeleteCI(Gear: PGear);
+var ci, i: LongInt;
 begin
-if Gear^.CollisionIndex >= 0 then
+ci:= Gear^.CollisionIndex;
+if ci >= 0 then
     begin
-    with cinfos[Gear^.CollisionIndex] do
+    with cinfos[ci] do
         ChangeRoundInLand(X, Y, Radius - 1, false, ((CurrentHedgehog <> nil) and (Gear = CurrentHedgehog^.Gear)) or ((Gear^.Kind = gtCase) and (Gear^.State and gstFrozen = 0)));
-    cinfos[Gear^.CollisionIndex]:= cinfos[Pred(Count)];
-    cinfos[Gear^.CollisionIndex].cGear^.CollisionIndex:= Gear^.CollisionIndex;
+    RemoveFromGrid(ci);
+    if ci <> Pred(LongInt(Count)) then
+        begin
+        cinfos[ci]:= cinfos[Pred(Count)];
+        with cinfos[ci] do
+            begin
+            cGear^.CollisionIndex:= ci;
+            for i:= 0 to Pred(NodesCount) do
+                cellNodes[Nodes[i]].ci:= ci
+            end
+        end;
     Gear^.CollisionIndex:= -1;
     dec(Count)
     end;
@@ -112,8 +315,7 @@ begin
 end;
 
 function CheckGearsCollision(Gear: PGear): PGearArray;
-var mx, my, tr: LongInt;
-    i: Longword;
+var mx, my, tr, i, n: LongInt;
 begin
 CheckGearsCollision:= @ga;
 ga.Count:= 0;
@@ -124,12 +326,13 @@ my:= hwRound(Gear^.Y);
 
 tr:= Gear^.Radius + 2;
 
-for i:= 0 to Pred(Count) do
-    with cinfos[i] do
+n:= CollectCandidates(mx, my, tr);
+for i:= 0 to Pred(n) do
+    with cinfos[candidates[i]] do
         if (Gear <> cGear) and
             (sqr(mx - x) + sqr(my - y) <= sqr(Radius + tr)) then
                 begin
-                ga.ar[ga.Count]:= cinfos[i].cGear;
+                ga.ar^[ga.Count]:= cGear;
                 inc(ga.Count)
                 end
 end;
@@ -155,8 +358,8 @@ if (x and LAND_WIDTH_MASK) = 0 then
     i:= y + Gear^.Radius * 2 - 2;
     repeat
         if (y and LAND_HEIGHT_MASK) = 0 then
-            if Land[y, x] and Gear^.CollisionMask <> 0 then
-                exit(Land[y, x] and Gear^.CollisionMask);
+            if Land[y * LAND_WIDTH + x] and Gear^.CollisionMask <> 0 then
+                exit(Land[y * LAND_WIDTH + x] and Gear^.CollisionMask);
         inc(y)
     until (y > i);
     end;
@@ -184,9 +387,9 @@ if (y and LAND_HEIGHT_MASK) = 0 then
     i:= x + Gear^.Radius * 2 - 2;
     repeat
         if (x and LAND_WIDTH_MASK) = 0 then
-            if Land[y, x] and Gear^.CollisionMask <> 0 then
+            if Land[y * LAND_WIDTH + x] and Gear^.CollisionMask <> 0 then
                 begin
-                exit(Land[y, x] and Gear^.CollisionMask)
+                exit(Land[y * LAND_WIDTH + x] and Gear^.CollisionMask)
                 end;
         inc(x)
     until (x > i);
@@ -195,7 +398,7 @@ TestCollisionYwithGear:= 0
 end;
 
 function TestCollisionXKick(Gear: PGear; Dir: LongInt): Word;
-var x, y, mx, my, i: LongInt;
+var x, y, mx, my, i, n: LongInt;
     pixel: Word;
 begin
 pixel:= 0;
@@ -211,10 +414,10 @@ if (x and LAND_WIDTH_MASK) = 0 then
     i:= y + Gear^.Radius * 2 - 2;
     repeat
         if (y and LAND_HEIGHT_MASK) = 0 then
-            if Land[y, x] and Gear^.CollisionMask > 255 then
-                exit(Land[y, x] and Gear^.CollisionMask)
-            else if Land[y, x] and Gear^.CollisionMask <> 0 then
-                pixel:= Land[y, x] and Gear^.CollisionMask;
+            if Land[y * LAND_WIDTH + x] and Gear^.CollisionMask > 255 then
+                exit(Land[y * LAND_WIDTH + x] and Gear^.CollisionMask)
+            else if Land[y * LAND_WIDTH + x] and Gear^.CollisionMask <> 0 then
+                pixel:= Land[y * LAND_WIDTH + x] and Gear^.CollisionMask;
     inc(y)
     until (y > i);
     end;
@@ -231,8 +434,9 @@ if pixel <> 0 then
     mx:= hwRound(Gear^.X);
     my:= hwRound(Gear^.Y);
 
-    for i:= 0 to Pred(Count) do
-        with cinfos[i] do
+    n:= CollectCandidates(mx, my, Gear^.Radius + 2);
+    for i:= 0 to Pred(n) do
+        with cinfos[candidates[i]] do
             if  (Gear <> cGear) and
                 ((mx > x) xor (Dir > 0)) and
                 (
@@ -257,7 +461,7 @@ if pixel <> 0 then
 end;
 
 function TestCollisionYKick(Gear: PGear; Dir: LongInt): Word;
-var x, y, mx, my,  myr, i: LongInt;
+var x, y, mx, my,  myr, i, n: LongInt;
     pixel: Word;
 begin
 pixel:= 0;
@@ -273,11 +477,11 @@ if (y and LAND_HEIGHT_MASK) = 0 then
     i:= x + Gear^.Radius * 2 - 2;
     repeat
     if (x and LAND_WIDTH_MASK) = 0 then
-        if Land[y, x] > 0 then
-            if Land[y, x] and Gear^.CollisionMask > 255 then
-                exit(Land[y, x] and Gear^.CollisionMask)
-            else if Land[y, x] <> 0 then
-                pixel:= Land[y, x] and Gear^.CollisionMask;
+        if Land[y * LAND_WIDTH + x] > 0 then
+            if Land[y * LAND_WIDTH + x] and Gear^.CollisionMask > 255 then
+                exit(Land[y * LAND_WIDTH + x] and Gear^.CollisionMask)
+            else if Land[y * LAND_WIDTH + x] <> 0 then
+                pixel:= Land[y * LAND_WIDTH + x] and Gear^.CollisionMask;
     inc(x)
     until (x > i);
     end;
@@ -294,8 +498,9 @@ if pixel <> 0 then
     my:= hwRound(Gear^.Y);
     myr:= my+Gear^.Radius;
 
-    for i:= 0 to Pred(Count) do
-        with cinfos[i] do
+    n:= CollectCandidates(mx, my, Gear^.Radius + 2);
+    for i:= 0 to Pred(n) do
+        with cinfos[candidates[i]] do
             if (Gear <> cGear) and
                ((myr > y) xor (Dir > 0)) and
                (Gear^.State and gstNotKickable = 0) and
@@ -348,8 +553,8 @@ if (x and LAND_WIDTH_MASK) = 0 then
     i:= y + Gear^.Radius * 2 - 2;
     repeat
         if (y and LAND_HEIGHT_MASK) = 0 then
-            if Land[y, x] and Gear^.CollisionMask > 255 then
-                exit(Land[y, x] and Gear^.CollisionMask);
+            if Land[y * LAND_WIDTH + x] and Gear^.CollisionMask > 255 then
+                exit(Land[y * LAND_WIDTH + x] and Gear^.CollisionMask);
     inc(y)
     until (y > i);
     end;
@@ -371,8 +576,8 @@ if (y and LAND_HEIGHT_MASK) = 0 then
     i:= x + Gear^.Radius * 2 - 2;
     repeat
         if (x and LAND_WIDTH_MASK) = 0 then
-            if Land[y, x] and Gear^.CollisionMask > 255 then
-                exit(Land[y, x] and Gear^.CollisionMask);
+            if Land[y * LAND_WIDTH + x] and Gear^.CollisionMask > 255 then
+                exit(Land[y * LAND_WIDTH + x] and Gear^.CollisionMask);
     inc(x)
     until (x > i);
     end;
@@ -426,10 +631,17 @@ end;
 if (hasBorder and ((y1 < 0) or (x1 < 0) or (x2 > LAND_WIDTH))) then
     exit;
 
-for y := y1 to y2 do
-    for x := x1 to x2 do
-        if ((y and LAND_HEIGHT_MASK) = 0) and ((x and LAND_WIDTH_MASK) = 0) and (Land[y, x] > TestWord) then
-            exit;
+y:= y1;
+while y <= y2 do
+    begin
+    // rows of tiles without any land need no pixel checks
+    y:= SkipEmptyLandRows(x1, x2, y, y2 + 1);
+    if y <= y2 then
+        for x := x1 to x2 do
+            if ((y and LAND_HEIGHT_MASK) = 0) and ((x and LAND_WIDTH_MASK) = 0) and (Land[y * LAND_WIDTH + x] > TestWord) then
+                exit;
+    inc(y)
+    end;
 
 TestRectangleForObstacle:= false
 end;
@@ -477,7 +689,7 @@ begin
             tmpy:= collisionY + k * my;
 
             if (((tmpy) and LAND_HEIGHT_MASK) = 0) and (((tmpx) and LAND_WIDTH_MASK) = 0) then
-                if (Land[tmpy,tmpx] > TestWord) then
+                if (Land[tmpy * LAND_WIDTH + tmpx] > TestWord) then
                     begin
                     // remember the index belonging to the first and last collision (if in 1st half)
                     if (i <> 0) then
@@ -528,7 +740,7 @@ begin
                 tmpx:= ldx + k * offset[tmpo,0];
                 tmpy:= ldy + k * offset[tmpo,1];
                 if (((tmpy) and LAND_HEIGHT_MASK) = 0) and (((tmpx) and LAND_WIDTH_MASK)  = 0)
-                and (Land[tmpy,tmpx] > TestWord) then
+                and (Land[tmpy * LAND_WIDTH + tmpx] > TestWord) then
                     begin
                     ldx:= tmpx;
                     ldy:= tmpy;
@@ -552,7 +764,7 @@ begin
                 tmpx:= rdx + k * offset[tmpo,0];
                 tmpy:= rdy + k * offset[tmpo,1];
                 if (((tmpy) and LAND_HEIGHT_MASK) = 0) and (((tmpx) and LAND_WIDTH_MASK)  = 0)
-                and (Land[tmpy,tmpx] > TestWord) then
+                and (Land[tmpy * LAND_WIDTH + tmpx] > TestWord) then
                     begin
                     rdx:= tmpx;
                     rdy:= tmpy;
@@ -595,7 +807,7 @@ if dirY <> 0 then
         i:= x + Gear^.Radius * 2 - 2;
         repeat
         if (x and LAND_WIDTH_MASK) = 0 then
-            if Land[y, x] <> 0 then
+            if Land[y * LAND_WIDTH + x] <> 0 then
                 if (not isColl) or (abs(x-gx) < abs(collX-gx)) then
                     begin
                     isColl:= true;
@@ -618,7 +830,7 @@ else
         i:= y + Gear^.Radius * 2 - 2;
         repeat
         if (y and LAND_HEIGHT_MASK) = 0 then
-            if Land[y, x] <> 0 then
+            if Land[y * LAND_WIDTH + x] <> 0 then
                 if (not isColl) or (abs(y-gy) < abs(collY-gy)) then
                     begin
                     isColl:= true;
@@ -687,7 +899,7 @@ if (y and LAND_HEIGHT_MASK) = 0 then
     i:= x + Gear^.Radius * 2 - 2;
     repeat
     if (x and LAND_WIDTH_MASK) = 0 then
-        if Land[y, x] > 255 then
+        if Land[y * LAND_WIDTH + x] > 255 then
             if (not isColl) or (abs(x-gx) < abs(collX-gx)) then
                 begin
                 isColl:= true;
@@ -727,13 +939,29 @@ CalcSlopeBelowGear := _0;
 end;
 
 procedure initModule;
+var i: LongInt;
 begin
     Count:= 0;
+    Capacity:= 0;
+    for i:= 0 to cBigBucket do
+        cellHeads[i]:= -1;
+    freeCellNode:= -1;
+    queryStamp:= 0;
+    GrowRegistry(cInitialEntriesCapacity);
+
+    ga.ar:= @gaItems;
+    ga.Count:= 0;
 end;
 
 procedure freeModule;
 begin
-
+    SetLength(cinfos, 0);
+    SetLength(candidates, 0);
+    SetLength(candidateStamps, 0);
+    SetLength(gaItems, 0);
+    SetLength(cellNodes, 0);
+    Capacity:= 0;
+    Count:= 0;
 end;
 
 end.
@@ -36,17 +36,32 @@ procedure ParseTeamCommand(s: shortstring);
 procedure StopMessages(Message: Longword);
 
 implementation
-uses uConsts, uVariables, uConsole, uUtils, SDLh;
+uses uConsts, uTypes, uVariables, uConsole, uUtils, SDLh;
 
 type  PVariable = ^TVariable;
     TVariable = record
-        Next: PVariable;
+        Next, NextInBucket: PVariable;
         Name: string[15];
         Handler: TCommandHandler;
         Trusted, Rand: boolean;
         end;
 
+// registered variables are also chained into hash buckets by name,
+// a later registration under the same name shadows the earlier one
+const cVariableBuckets = 256; // power of 2
+
 var Variables: PVariable;
+    VariableBuckets: array[0..Pred(cVariableBuckets)] of PVariable;
+
+function VariableHash(const Name: shortstring): LongWord; inline;
+var i: LongInt;
+    h: LongWord;
+begin
+h:= 2166136261;
+for i:= 1 to Length(Name) do
+    h:= (h xor ord(Name[i])) * 16777619;
+VariableHash:= (h xor (h shr 16)) and Pred(cVariableBuckets)
+end;
 
 procedure RegisterVariable(Name: shortstring; p: TCommandHandler; Trusted: boolean);
 begin
@@ -55,6 +70,7 @@ end;
 
 procedure RegisterVariable(Name: shortstring; p: TCommandHandler; Trusted: boolean; Rand: boolean);
 var value: PVariable;
+    h: LongWord;
 begin
 New(value);
 if value = nil then
@@ -73,6 +89,11 @@ else
     value^.Next:= Variables;
     Variables:= value
     end;
+
+// hash the stored name, it might have been truncated
+h:= VariableHash(value^.Name);
+value^.NextInBucket:= VariableBuckets[h];
+VariableBuckets[h]:= value
 end;
 
 
@@ -91,7 +112,8 @@ isExternalSource:= ExternalSource or ((CurrentTeam <> nil) and CurrentTeam^.ExtD
 if CmdStr[0]=#0 then
     exit;
 
-AddFileLog('[Cmd] ' + sanitizeForLog(CmdStr));
+if LogEnabled(llDebug) then
+    AddFileLog(llDebug, '[Cmd] ' + sanitizeForLog(CmdStr));
 
 c:= CmdStr[1];
 if (c = '/') or (c = '$') then
@@ -99,7 +121,7 @@ if (c = '/') or (c = '$') then
 s:= '';
 SplitBySpace(CmdStr, s);
 
-t:= Variables;
+t:= VariableBuckets[VariableHash(CmdStr)];
 while t <> nil do
     begin
     if t^.Name = CmdStr then
@@ -113,7 +135,7 @@ while t <> nil do
         exit
         end
     else
-        t:= t^.Next
+        t:= t^.NextInBucket
     end;
 case c of
     '$': WriteLnToConsole(errmsgUnknownVariable + ': "$' + CmdStr + '"')
@@ -151,6 +173,7 @@ end;
 procedure initModule;
 begin
     Variables:= nil;
+    FillChar(VariableBuckets, sizeof(VariableBuckets), 0);
     isDeveloperMode:= true;
 end;
 
@@ -159,6 +182,7 @@ var t, tt: PVariable;
 begin
     tt:= Variables;
     Variables:= nil;
+    FillChar(VariableBuckets, sizeof(VariableBuckets), 0);
     while tt <> nil do
     begin
         t:= tt;
@@ -121,6 +121,10 @@ const
     // consists of 0-127 counted for object checkins and $80 as a bit flag for current hog.
     lfAllObjMask     = $00FF;  // lfCurrentHog or lfObjMask
 
+    // states of a LandDirty tile
+    ldSweep          = $01;  // land changed, to be despeckled by SweepDirty
+    ldSmooth         = $02;  // waiting for its smoothing in SmoothDirtyLand
+
 
     cMaxPower     = 1500;
     cMaxAngle     = 2048;
@@ -155,6 +159,10 @@ const
 
     cMaxEdgePoints = 32768;
 
+    // buckets of the uid -> gear lookup tables, powers of 2
+    cGearsByUIDSize = 1024;
+    cVisualGearsByUIDSize = 4096;
+
     cHHRadius = 9;
     cHHStepTicks = 29;
 
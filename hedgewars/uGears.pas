@@ -560,12 +560,12 @@ procedure FreeGearsList;
 var t, tt: PGear;
 begin
     tt:= GearsList;
-    GearsList:= nil;
+    ResetGearsList;
     while tt <> nil do
     begin
         t:= tt;
         tt:= tt^.NextGear;
-        Dispose(t)
+        DisposeGear(t)
     end;
 end;
 
@@ -884,21 +884,15 @@ var gear: PGear;
 begin
 GearByUID:= nil;
 if uid = 0 then exit;
-if (lastGearByUID <> nil) and (lastGearByUID^.uid = uid) then
-    begin
-    GearByUID:= lastGearByUID;
-    exit
-    end;
-gear:= GearsList;
+gear:= GearsByUID[uid and Pred(cGearsByUIDSize)];
 while gear <> nil do
     begin
     if gear^.uid = uid then
         begin
-        lastGearByUID:= gear;
         GearByUID:= gear;
         exit
         end;
-    gear:= gear^.NextGear
+    gear:= gear^.NextByUID
     end
 end;
 
@@ -1067,7 +1061,7 @@ begin
     RegisterVariable('hogsay', @chHogSay, true );
 
     CurAmmoGear:= nil;
-    GearsList:= nil;
+    ResetGearsList;
     curHandledGear:= nil;
 
     KilledHHs:= 0;
@@ -1092,6 +1086,7 @@ end;
 procedure freeModule;
 begin
     FreeGearsList();
+    FreeGearsPool();
 end;
 
 end.
@@ -147,7 +147,7 @@ implementation
 uses uConsts, uVariables, uVisualGearsList, uRandom, uCollisions, uGearsList, uUtils, uSound
     , SDLh, uScript, uGearsHedgehog, uGearsUtils, uIO, uCaptions, uLandGraphics
     , uGearsHandlers, uTextures, uRenderUtils, uAmmos, uTeams, uLandTexture, uCommands
-    , uStore, uAI, uStats;
+    , uStore, uAI, uStats, uLandUtils;
 
 procedure doStepPerPixel(Gear: PGear; step: TGearStepProcedure; onlyCheckIfChanged: boolean);
 var
@@ -241,9 +241,6 @@ begin
     if FollowGear = HH^.Gear then
         FollowGear:= nil;
 
-    if lastGearByUID = HH^.Gear then
-        lastGearByUID := nil;
-
     HH^.Gear^.Message:= HH^.Gear^.Message or gmRemoveFromList;
     with HH^.Gear^ do
         begin
@@ -831,38 +828,38 @@ We aren't using frametick right now, so just a waste of cycles.
         else if (cGravity < _0) and (yy < LAND_HEIGHT-1200) then
             move:=true
         // Solid pixel encountered
-        else if ((yy and LAND_HEIGHT_MASK) = 0) and ((xx and LAND_WIDTH_MASK) = 0) and (Land[yy, xx] <> 0) then
+        else if ((yy and LAND_HEIGHT_MASK) = 0) and ((xx and LAND_WIDTH_MASK) = 0) and (Land[yy * LAND_WIDTH + xx] <> 0) then
             begin
-            lf:= Land[yy, xx] and (lfObject or lfBasic or lfIndestructible);
+            lf:= Land[yy * LAND_WIDTH + xx] and (lfObject or lfBasic or lfIndestructible);
             if lf = 0 then lf:= lfObject;
             // If there's room below keep falling
-            if (((yy-1) and LAND_HEIGHT_MASK) = 0) and (Land[yy-1, xx] = 0) then
+            if (((yy-1) and LAND_HEIGHT_MASK) = 0) and (Land[(yy-1) * LAND_WIDTH + xx] = 0) then
                 begin
                 X:= X - cWindSpeed * 1600 - dX;
                 end
             // If there's room below, on the sides, fill the gaps
-            else if (((yy-1) and LAND_HEIGHT_MASK) = 0) and (((xx-(1*hwSign(cWindSpeed))) and LAND_WIDTH_MASK) = 0) and (Land[yy-1, (xx-(1*hwSign(cWindSpeed)))] = 0) then
+            else if (((yy-1) and LAND_HEIGHT_MASK) = 0) and (((xx-(1*hwSign(cWindSpeed))) and LAND_WIDTH_MASK) = 0) and (Land[(yy-1) * LAND_WIDTH + (xx-(1*hwSign(cWindSpeed)))] = 0) then
                 begin
                 X:= X - _0_8 * hwSign(cWindSpeed);
                 Y:= Y - dY - cGravity * vobFallSpeed * 8;
                 end
-            else if (((yy-1) and LAND_HEIGHT_MASK) = 0) and (((xx-(2*hwSign(cWindSpeed))) and LAND_WIDTH_MASK) = 0) and (Land[yy-1, (xx-(2*hwSign(cWindSpeed)))] = 0) then
+            else if (((yy-1) and LAND_HEIGHT_MASK) = 0) and (((xx-(2*hwSign(cWindSpeed))) and LAND_WIDTH_MASK) = 0) and (Land[(yy-1) * LAND_WIDTH + (xx-(2*hwSign(cWindSpeed)))] = 0) then
                 begin
                 X:= X - _0_8 * 2 * hwSign(cWindSpeed);
                 Y:= Y - dY - cGravity * vobFallSpeed * 8;
                 end
-            else if (((yy-1) and LAND_HEIGHT_MASK) = 0) and (((xx+(1*hwSign(cWindSpeed))) and LAND_WIDTH_MASK) = 0) and (Land[yy-1, (xx+(1*hwSign(cWindSpeed)))] = 0) then
+            else if (((yy-1) and LAND_HEIGHT_MASK) = 0) and (((xx+(1*hwSign(cWindSpeed))) and LAND_WIDTH_MASK) = 0) and (Land[(yy-1) * LAND_WIDTH + (xx+(1*hwSign(cWindSpeed)))] = 0) then
                 begin
                 X:= X + _0_8 * hwSign(cWindSpeed);
                 Y:= Y - dY - cGravity * vobFallSpeed * 8;
                 end
-            else if (((yy-1) and LAND_HEIGHT_MASK) = 0) and (((xx+(2*hwSign(cWindSpeed))) and LAND_WIDTH_MASK) = 0) and (Land[yy-1, (xx+(2*hwSign(cWindSpeed)))] = 0) then
+            else if (((yy-1) and LAND_HEIGHT_MASK) = 0) and (((xx+(2*hwSign(cWindSpeed))) and LAND_WIDTH_MASK) = 0) and (Land[(yy-1) * LAND_WIDTH + (xx+(2*hwSign(cWindSpeed)))] = 0) then
                 begin
                 X:= X + _0_8 * 2 * hwSign(cWindSpeed);
                 Y:= Y - dY - cGravity * vobFallSpeed * 8;
                 end
             // if there's an hog/object below do nothing
-            else if ((((yy+1) and LAND_HEIGHT_MASK) = 0) and ((Land[yy+1, xx] and $FF) <> 0))
+            else if ((((yy+1) and LAND_HEIGHT_MASK) = 0) and ((Land[(yy+1) * LAND_WIDTH + xx] and $FF) <> 0))
                 then move:=true
             else draw:= true
             end
@@ -890,7 +887,7 @@ if draw then
                 for px:= 0 to Pred(s^.w) do
                     begin
                     lx:=xx + px; ly:=yy + py;
-                    if (ly and LAND_HEIGHT_MASK = 0) and (lx and LAND_WIDTH_MASK = 0) and (Land[ly, lx] and $FF = 0) then
+                    if (ly and LAND_HEIGHT_MASK = 0) and (lx and LAND_WIDTH_MASK = 0) and (Land[ly * LAND_WIDTH + lx] and $FF = 0) then
                         begin
                         rx:= lx;
                         ry:= ly;
@@ -898,26 +895,27 @@ if draw then
                             begin
                             rx:= rx div 2;ry:= ry div 2;
                             end;
-                        if Land[yy + py, xx + px] <= lfAllObjMask then
+                        if Land[(yy + py) * LAND_WIDTH + (xx + px)] <= lfAllObjMask then
                             if gun then
                                 begin
-                                LandDirty[yy div 32, xx div 32]:= 1;
-                                if LandPixels[ry, rx] = 0 then
-                                    Land[ly, lx]:=  lfDamaged or lfObject
-                                else Land[ly, lx]:=  lfDamaged or lfBasic
+                                MarkLandDirty(xx, yy);
+                                if LandPixels[ry * LAND_PIXELS_WIDTH + rx] = 0 then
+                                    Land[ly * LAND_WIDTH + lx]:=  lfDamaged or lfObject
+                                else Land[ly * LAND_WIDTH + lx]:=  lfDamaged or lfBasic
                                 end
-                            else Land[ly, lx]:= lf;
+                            else Land[ly * LAND_WIDTH + lx]:= lf;
                         if gun then
-                             LandPixels[ry, rx]:= (Gear^.Tint shr 24         shl RShift) or 
+                             LandPixels[ry * LAND_PIXELS_WIDTH + rx]:= (Gear^.Tint shr 24         shl RShift) or 
                                                   (Gear^.Tint shr 16 and $FF shl GShift) or 
                                                   (Gear^.Tint shr  8 and $FF shl BShift) or 
                                                   (p^[px] and AMask)
-                        else LandPixels[ry, rx]:= addBgColor(LandPixels[ry, rx], p^[px]);
+                        else LandPixels[ry * LAND_PIXELS_WIDTH + rx]:= addBgColor(LandPixels[ry * LAND_PIXELS_WIDTH + rx], p^[px]);
                         end
                     else allpx:= false
                     end;
                 p:= PLongWordArray(@(p^[s^.pitch shr 2]))
                 end;
+            LandTilesAdded(xx, yy, xx + s^.w - 1, yy + s^.h - 1);
 
             // Why is this here.  For one thing, there's no test on +1 being safe.
             //Land[py, px+1]:= lfBasic;
@@ -1263,7 +1261,7 @@ begin
         x := hwRound(Gear^.X);
         y := hwRound(Gear^.Y);
 
-        if ((y and LAND_HEIGHT_MASK) = 0) and ((x and LAND_WIDTH_MASK) = 0) and (Land[y, x] <> 0) then
+        if ((y and LAND_HEIGHT_MASK) = 0) and ((x and LAND_WIDTH_MASK) = 0) and (Land[y * LAND_WIDTH + x] <> 0) then
             inc(Gear^.Damage);
         // let's interrupt before a collision to give portals a chance to catch the bullet
         if (Gear^.Damage = 1) and (Gear^.Tag = 0) and (not CheckLandValue(x, y, lfLandMask)) then
@@ -1479,7 +1477,7 @@ begin
     if (Gear^.Timer mod 47) = 0 then
         begin
         // ok. this was an attempt to turn off dust if not actually drilling land.  I have no idea why it isn't working as expected
-        if (( (y + 12) and LAND_HEIGHT_MASK) = 0) and ((x and LAND_WIDTH_MASK) = 0) and (Land[y + 12, x] > 255) then
+        if (( (y + 12) and LAND_HEIGHT_MASK) = 0) and ((x and LAND_WIDTH_MASK) = 0) and (Land[(y + 12) * LAND_WIDTH + x] > 255) then
             for i:= 0 to 1 do
                 AddVisualGear(x - 5 + Random(10), y + 12, vgtDust);
 
@@ -3439,16 +3437,19 @@ begin
         dec(playWidth, 2);
         for i:= 0 to LAND_HEIGHT - 1 do
             begin
-            Land[i, leftX] := 0;
-            Land[i, rightX] := 0;
+            Land[i * LAND_WIDTH + leftX] := 0;
+            Land[i * LAND_WIDTH + rightX] := 0;
             end;
+        LandTilesCleared(leftX, 0, leftX, LAND_HEIGHT - 1);
+        LandTilesCleared(rightX, 0, rightX, LAND_HEIGHT - 1);
         end;
 
     if cWaterLine > 0 then
         begin
         dec(cWaterLine);
         for i:= 0 to LAND_WIDTH - 1 do
-            Land[cWaterLine, i] := 0;
+            Land[cWaterLine * LAND_WIDTH + i] := 0;
+        LandTilesCleared(0, cWaterLine, LAND_WIDTH - 1, cWaterLine);
         SetAllToActive
         end;
 
@@ -4212,8 +4213,8 @@ begin
     doPortalColorSwitch();
 
     // destroy portal if ground it was attached too is gone
-    if (Land[hwRound(Gear^.Y), hwRound(Gear^.X)] <= lfAllObjMask)
-    or (Land[hwRound(Gear^.Y), hwRound(Gear^.X)] and lfBouncy <> 0)
+    if (Land[hwRound(Gear^.Y) * LAND_WIDTH + hwRound(Gear^.X)] <= lfAllObjMask)
+    or (Land[hwRound(Gear^.Y) * LAND_WIDTH + hwRound(Gear^.X)] and lfBouncy <> 0)
     or (Gear^.Timer < 1)
     or (Gear^.Hedgehog^.Team <> CurrentHedgehog^.Team)
     or CheckCoordInWater(hwRound(Gear^.X), hwRound(Gear^.Y)) then
@@ -4572,12 +4573,12 @@ begin
     ty := 0;
     // avoid compiler hints
 
-    if ((y and LAND_HEIGHT_MASK) = 0) and ((x and LAND_WIDTH_MASK) = 0) and (Land[y, x] > 255) then
+    if ((y and LAND_HEIGHT_MASK) = 0) and ((x and LAND_WIDTH_MASK) = 0) and (Land[y * LAND_WIDTH + x] > 255) then
         begin
         Gear^.State := Gear^.State or gstCollision;
         Gear^.State := Gear^.State and (not gstMoving);
 
-        if (Land[y, x] and lfBouncy <> 0)
+        if (Land[y * LAND_WIDTH + x] and lfBouncy <> 0)
         or (not CalcSlopeTangent(Gear, x, y, tx, ty, 255))
         or (DistanceI(tx,ty) < _12) then // reject shots at too irregular terrain
             begin
@@ -4883,9 +4884,9 @@ begin
             if (not CheckCoordInWater(rX, rY)) or (not CheckCoordInWater(x, y)) then
                 begin
                 if ((y and LAND_HEIGHT_MASK) = 0) and ((x and LAND_WIDTH_MASK) = 0)
-                    and (Land[y, x] <> 0) then
+                    and (Land[y * LAND_WIDTH + x] <> 0) then
                         begin
-                        if ((GameFlags and gfSolidLand) <> 0) and (Land[y, x] > 255) then
+                        if ((GameFlags and gfSolidLand) <> 0) and (Land[y * LAND_WIDTH + x] > 255) then
                             Gear^.Damage := initHealth
                         else if justCollided then
                             begin
@@ -5213,7 +5214,7 @@ i:= t^.Count;
 while i > 0 do
     begin
     dec(i);
-    tmp:= t^.ar[i];
+    tmp:= t^.ar^[i];
     if (tmp^.State and gstNoDamage) = 0 then
         if (tmp^.Kind = gtHedgehog) or (tmp^.Kind = gtMine) or (tmp^.Kind = gtExplosives) then
             begin
@@ -5832,7 +5833,7 @@ begin
         ndY:= -AngleCos(HHGear^.Angle) * _4;
         if (ndX <> dX) or (ndY <> dY) or
            ((Target.X <> NoPointX) and (Target.X and LAND_WIDTH_MASK = 0) and
-             (Target.Y and LAND_HEIGHT_MASK = 0) and ((Land[Target.Y, Target.X] = 0)) and
+             (Target.Y and LAND_HEIGHT_MASK = 0) and ((Land[Target.Y * LAND_WIDTH + Target.X] = 0)) and
              (not CheckCoordInWater(Target.X, Target.Y))) then
             begin
             updateTarget(Gear, ndX, ndY);
@@ -5860,7 +5861,7 @@ begin
                 else if CheckCoordInWater(Target.X, Target.Y) or
                         ((Target.X and LAND_WIDTH_MASK  = 0) and
                          (Target.Y and LAND_HEIGHT_MASK = 0) and
-                         (Land[Target.Y, Target.X] = lfIce) and
+                         (Land[Target.Y * LAND_WIDTH + Target.X] = lfIce) and
                          ((Target.Y+iceHeight+5 > cWaterLine) or
                           ((WorldEdge = weSea) and
                            ((Target.X+iceHeight+5 > LongInt(rightX)) or
@@ -5992,7 +5993,7 @@ begin
                 end
             else if (t > 400) and (CheckCoordInWater(gX, gY) or
                     (((gX and LAND_WIDTH_MASK = 0) and (gY and LAND_HEIGHT_MASK = 0))
-                        and (Land[gY, gX] <> 0))) then
+                        and (Land[gY * LAND_WIDTH + gX] <> 0))) then
                 begin
                 Target.X:= gX;
                 Target.Y:= gY;
@@ -26,6 +26,9 @@ function  AddGear(X, Y: LongInt; Kind: TGearType; State: Longword; dX, dY: hwFlo
 procedure DeleteGear(Gear: PGear);
 procedure InsertGearToList(Gear: PGear);
 procedure RemoveGearFromList(Gear: PGear);
+procedure ResetGearsList;
+procedure DisposeGear(Gear: PGear);
+procedure FreeGearsPool;
 
 var curHandledGear: PGear;
 
@@ -113,32 +116,225 @@ const
     cUsualZ = 500;
     cOnHHZ = 2000;
 
-procedure InsertGearToList(Gear: PGear);
-var tmp, ptmp: PGear;
+// GearsList is sorted by the Z gears had when they were inserted. For
+// every Z value present in the list we keep its first and last gear,
+// sorted by Z, so inserting doesn't need to walk the list. There are only
+// a handful of distinct Z values in a game.
+type TZBucket = record
+    Z: LongWord;
+    First, Last: PGear;
+    end;
+
+var ZBuckets: array of TZBucket;
+    ZBucketsCount: LongWord;
+
+// Gear records are carved out of slabs and recycled through a free list
+// (chained via NextGear) instead of going through the heap every time.
+const cGearsSlabSize = 256;
+
+type PGearsSlab = ^TGearsSlab;
+    TGearsSlab = array[0..Pred(cGearsSlabSize)] of TGear;
+
+var GearsSlabs: array of PGearsSlab;
+    GearsSlabsCount: LongWord;
+    FreeGears: PGear;
+    // pool statistics, written to the debug log by FreeGearsPool
+    GearsAllocated, GearsInUse, GearsPeak: LongWord;
+
+function NewGear: PGear;
+var slab: PGearsSlab;
+    i: LongInt;
+    gear: PGear;
 begin
-    tmp:= GearsList;
-    ptmp:= GearsList;
-    while (tmp <> nil) and (tmp^.Z < Gear^.Z) do
+    if FreeGears = nil then
         begin
-        ptmp:= tmp;
-        tmp:= tmp^.NextGear
+        New(slab);
+        if GearsSlabsCount = LongWord(Length(GearsSlabs)) then
+            SetLength(GearsSlabs, GearsSlabsCount * 2 + 4);
+        GearsSlabs[GearsSlabsCount]:= slab;
+        inc(GearsSlabsCount);
+        for i:= Pred(cGearsSlabSize) downto 0 do
+            begin
+            slab^[i].NextGear:= FreeGears;
+            FreeGears:= @slab^[i]
+            end;
+        AddFileLog('Gears pool: added slab #' + inttostr(GearsSlabsCount) + ', ' + inttostr(GearsInUse) + ' gears in use')
         end;
 
-    if ptmp <> tmp then
-        begin
-        Gear^.NextGear:= ptmp^.NextGear;
-        Gear^.PrevGear:= ptmp;
-        if ptmp^.NextGear <> nil then
-            ptmp^.NextGear^.PrevGear:= Gear;
-        ptmp^.NextGear:= Gear
-        end
+    gear:= FreeGears;
+    FreeGears:= gear^.NextGear;
+    FillChar(gear^, sizeof(TGear), 0);
+
+    inc(GearsAllocated);
+    inc(GearsInUse);
+    if GearsInUse > GearsPeak then
+        GearsPeak:= GearsInUse;
+
+    NewGear:= gear
+end;
+
+procedure DisposeGear(Gear: PGear);
+begin
+    Gear^.NextGear:= FreeGears;
+    FreeGears:= Gear;
+    dec(GearsInUse)
+end;
+
+procedure FreeGearsPool;
+var i: LongInt;
+begin
+    AddFileLog('Gears pool: ' + inttostr(GearsAllocated) + ' allocations, peak ' + inttostr(GearsPeak)
+        + ' in use, ' + inttostr(GearsSlabsCount) + ' slabs, ' + inttostr(GearsInUse) + ' not returned');
+
+    for i:= 0 to Pred(LongInt(GearsSlabsCount)) do
+        Dispose(GearsSlabs[i]);
+    SetLength(GearsSlabs, 0);
+    GearsSlabsCount:= 0;
+    FreeGears:= nil;
+
+    GearsAllocated:= 0;
+    GearsInUse:= 0;
+    GearsPeak:= 0
+end;
+
+// GearsByUID holds exactly the gears which are in GearsList,
+// so hidden hedgehogs can't be looked up just like before
+procedure AddGearByUID(Gear: PGear);
+var bucket: LongWord;
+begin
+    bucket:= Gear^.uid and Pred(cGearsByUIDSize);
+    Gear^.NextByUID:= GearsByUID[bucket];
+    GearsByUID[bucket]:= Gear
+end;
+
+procedure RemoveGearByUID(Gear: PGear);
+var bucket: LongWord;
+    t: PGear;
+begin
+    bucket:= Gear^.uid and Pred(cGearsByUIDSize);
+    if GearsByUID[bucket] = Gear then
+        GearsByUID[bucket]:= Gear^.NextByUID
     else
         begin
-        Gear^.NextGear:= GearsList;
-        if Gear^.NextGear <> nil then
-            Gear^.NextGear^.PrevGear:= Gear;
+        t:= GearsByUID[bucket];
+        while (t <> nil) and (t^.NextByUID <> Gear) do
+            t:= t^.NextByUID;
+        if t <> nil then
+            t^.NextByUID:= Gear^.NextByUID
+        end;
+    Gear^.NextByUID:= nil
+end;
+
+procedure LinkGearBefore(Gear, Next: PGear);
+begin
+    Gear^.NextGear:= Next;
+    Gear^.PrevGear:= Next^.PrevGear;
+    if Next^.PrevGear <> nil then
+        Next^.PrevGear^.NextGear:= Gear
+    else
         GearsList:= Gear;
+    Next^.PrevGear:= Gear
+end;
+
+procedure LinkGearAfter(Gear, Prev: PGear);
+begin
+    Gear^.PrevGear:= Prev;
+    Gear^.NextGear:= Prev^.NextGear;
+    if Prev^.NextGear <> nil then
+        Prev^.NextGear^.PrevGear:= Gear;
+    Prev^.NextGear:= Gear
+end;
+
+// index of the first bucket with Z not less than the given one
+function FindZBucket(Z: LongWord): LongWord;
+var l, r, m: LongWord;
+begin
+    l:= 0;
+    r:= ZBucketsCount;
+    while l < r do
+        begin
+        m:= (l + r) div 2;
+        if ZBuckets[m].Z < Z then
+            l:= m + 1
+        else
+            r:= m
         end;
+    FindZBucket:= l
+end;
+
+// a new gear goes in front of the gears with the same Z, where the old
+// walk from the head of the list put it as long as the list was sorted.
+// A gear whose Z is changed in place and only reinserted later (hog
+// switching does that) sits in the bucket of its old Z meanwhile, while
+// the old walk compared its new Z, so gears inserted in between can end
+// up in a different order than they used to.
+procedure InsertGearToList(Gear: PGear);
+var i, p: LongWord;
+begin
+    AddGearByUID(Gear);
+
+    p:= FindZBucket(Gear^.Z);
+    if (p < ZBucketsCount) and (ZBuckets[p].Z = Gear^.Z) then
+        begin
+        LinkGearBefore(Gear, ZBuckets[p].First);
+        ZBuckets[p].First:= Gear;
+        exit
+        end;
+
+    if ZBucketsCount = LongWord(Length(ZBuckets)) then
+        SetLength(ZBuckets, ZBucketsCount * 2 + 8);
+    for i:= ZBucketsCount downto p + 1 do
+        ZBuckets[i]:= ZBuckets[i - 1];
+    inc(ZBucketsCount);
+
+    ZBuckets[p].Z:= Gear^.Z;
+    ZBuckets[p].First:= Gear;
+    ZBuckets[p].Last:= Gear;
+
+    if p + 1 < ZBucketsCount then
+        LinkGearBefore(Gear, ZBuckets[p + 1].First)
+    else if p > 0 then
+        LinkGearAfter(Gear, ZBuckets[p - 1].Last)
+    else
+        begin
+        Gear^.NextGear:= nil;
+        Gear^.PrevGear:= nil;
+        GearsList:= Gear
+        end
+end;
+
+// Gear^.Z might have been changed already while the gear waits to be
+// reinserted, so find its bucket by the boundary gears instead
+procedure RemoveGearFromZBuckets(Gear: PGear);
+var i, j: LongInt;
+begin
+    for i:= 0 to Pred(LongInt(ZBucketsCount)) do
+        if ZBuckets[i].First = Gear then
+            begin
+            if ZBuckets[i].Last = Gear then
+                begin
+                // last gear with this Z
+                dec(ZBucketsCount);
+                for j:= i to Pred(LongInt(ZBucketsCount)) do
+                    ZBuckets[j]:= ZBuckets[j + 1]
+                end
+            else
+                ZBuckets[i].First:= Gear^.NextGear;
+            exit
+            end
+        else if ZBuckets[i].Last = Gear then
+            begin
+            ZBuckets[i].Last:= Gear^.PrevGear;
+            exit
+            end
+end;
+
+procedure ResetGearsList;
+begin
+    GearsList:= nil;
+    FillChar(GearsByUID, sizeof(GearsByUID), 0);
+    SetLength(ZBuckets, 0);
+    ZBucketsCount:= 0
 end;
 
 
@@ -151,6 +347,9 @@ if (Gear <> GearsList) and (Gear <> nil) and (Gear^.NextGear = nil) and (Gear^.P
     end;
 TryDo((Gear = nil) or (curHandledGear = nil) or (Gear = curHandledGear), 'You''re doing it wrong', true);
 
+RemoveGearByUID(Gear);
+RemoveGearFromZBuckets(Gear);
+
 if Gear^.NextGear <> nil then
     Gear^.NextGear^.PrevGear:= Gear^.PrevGear;
 if Gear^.PrevGear <> nil then
@@ -170,11 +369,11 @@ var gear: PGear;
 begin
 inc(GCounter);
 
-AddFileLog('AddGear: #' + inttostr(GCounter) + ' (' + inttostr(x) + ',' + inttostr(y) + '), d(' + floattostr(dX) + ',' + floattostr(dY) + ') type = ' + EnumToStr(Kind));
+if LogEnabled(llDebug) then
+    AddFileLog(llDebug, 'AddGear: #' + inttostr(GCounter) + ' (' + inttostr(x) + ',' + inttostr(y) + '), d(' + floattostr(dX) + ',' + floattostr(dY) + ') type = ' + EnumToStr(Kind));
 
 
-New(gear);
-FillChar(gear^, sizeof(TGear), 0);
+gear:= NewGear;
 gear^.X:= int2hwFloat(X);
 gear^.Y:= int2hwFloat(Y);
 gear^.Target.X:= NoPointX;
@@ -760,20 +959,19 @@ else if Gear^.Kind = gtHedgehog then
         end;
 with Gear^ do
     begin
-    AddFileLog('Delete: #' + inttostr(uid) + ' (' + inttostr(hwRound(x)) + ',' + inttostr(hwRound(y)) + '), d(' + floattostr(dX) + ',' + floattostr(dY) + ') type = ' + EnumToStr(Kind));
+    if LogEnabled(llDebug) then
+        AddFileLog(llDebug, 'Delete: #' + inttostr(uid) + ' (' + inttostr(hwRound(x)) + ',' + inttostr(hwRound(y)) + '), d(' + floattostr(dX) + ',' + floattostr(dY) + ') type = ' + EnumToStr(Kind));
     AddRandomness(X.round xor X.frac xor dX.round xor dX.frac xor Y.round xor Y.frac xor dY.round xor dY.frac)
     end;
 if CurAmmoGear = Gear then
     CurAmmoGear:= nil;
 if FollowGear = Gear then
     FollowGear:= nil;
-if lastGearByUID = Gear then
-    lastGearByUID := nil;
 if (Gear^.Hedgehog = nil) or (Gear^.Hedgehog^.GearHidden <> Gear) then // hidden hedgehogs shouldn't be in the list
      RemoveGearFromList(Gear)
 else Gear^.Hedgehog^.GearHidden:= nil;
 
-Dispose(Gear)
+DisposeGear(Gear)
 end;
 
 end.
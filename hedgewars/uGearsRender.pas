@@ -411,7 +411,7 @@ begin
                 hy:= ty;
                 while ((ty and LAND_HEIGHT_MASK) = 0) and
                     ((tx and LAND_WIDTH_MASK) = 0) and
-                    (Land[ty, tx] = 0) do // TODO: check for constant variable instead
+                    (Land[ty * LAND_WIDTH + tx] = 0) do // TODO: check for constant variable instead
                     begin
                     lx:= lx + ax;
                     ly:= ly + ay;
@@ -65,7 +65,7 @@ var doStepHandlers: array[TGearType] of TGearStepProcedure;
 
 implementation
 uses uSound, uCollisions, uUtils, uConsts, uVisualGears, uAIMisc,
-    uVariables, uLandGraphics, uScript, uStats, uCaptions, uTeams, uStore,
+    uVariables, uLandGraphics, uLandUtils, uScript, uStats, uCaptions, uTeams, uStore,
     uLocale, uTextures, uRenderUtils, uRandom, SDLh, uDebug,
     uGearsList, Math, uVisualGearsList, uGearsHandlersMess,
     uGearsHedgehog;
@@ -770,7 +770,7 @@ var i: LongInt;
 begin
     if (y and LAND_HEIGHT_MASK) = 0 then
         for i:= max(x - r, 0) to min(x + r, LAND_WIDTH - 1) do
-            if Land[y, i] and mask <> 0 then
+            if Land[y * LAND_WIDTH + i] and mask <> 0 then
             begin
                 inc(count);
                 if count = c then
@@ -792,8 +792,8 @@ begin
     begin
         for i:= r - c + 2 to r do
         begin
-            if (Land[y, x - i] and mask <> 0) then inc(cnt);
-            if (Land[y, x + i] and mask <> 0) then inc(cnt);
+            if (Land[y * LAND_WIDTH + (x - i)] and mask <> 0) then inc(cnt);
+            if (Land[y * LAND_WIDTH + (x + i)] and mask <> 0) then inc(cnt);
 
             if cnt >= c then
             begin
@@ -867,6 +867,8 @@ while tryAgain do
 
                 repeat
                     inc(y);
+                    // fall through the air tile by tile
+                    y:= SkipEmptyLandRows(x - Gear^.Radius + 1, x + Gear^.Radius - 1, y, cWaterLine);
                 until (y >= cWaterLine) or
                         ((not ignoreOverlap) and (CountNonZeroz(x, y, Gear^.Radius - 1, 1, $FFFF) <> 0)) or
                         (ignoreOverlap and (CountNonZeroz(x, y, Gear^.Radius - 1, 1, lfLandMask) <> 0));
@@ -1127,7 +1129,7 @@ if (CurAmmoGear <> nil) and ((CurAmmoGear^.Kind = gtRope) or (CurAmmoGear^.Kind
 and (CurrentHedgehog^.Gear <> nil) and (CurrentHedgehog^.Gear^.CollisionIndex = -1)
 and (sqr(hwRound(Ammo^.X) - hwRound(CurrentHedgehog^.Gear^.X)) + sqr(hwRound(Ammo^.Y) - hwRound(CurrentHedgehog^.Gear^.Y)) <= sqr(cHHRadius + Ammo^.Radius)) then
     begin
-    t^.ar[t^.Count]:= CurrentHedgehog^.Gear;
+    t^.ar^[t^.Count]:= CurrentHedgehog^.Gear;
     inc(t^.Count)
     end;
 
@@ -1138,7 +1140,7 @@ if (Ammo^.Kind = gtFlame) and (i > 0) then
 while i > 0 do
     begin
     dec(i);
-    Gear:= t^.ar[i];
+    Gear:= t^.ar^[i];
     if ((Ammo^.Kind = gtFlame) or (Ammo^.Kind = gtBlowTorch)) and
        (Gear^.Kind = gtHedgehog) and (Gear^.Hedgehog^.Effects[heFrozen] > 255) then
         Gear^.Hedgehog^.Effects[heFrozen]:= max(255,Gear^.Hedgehog^.Effects[heFrozen]-10000);
@@ -39,15 +39,14 @@ procedure NetGetNextCmd;
 procedure doPut(putX, putY: LongInt; fromAI: boolean);
 
 implementation
-uses uConsole, uConsts, uVariables, uCommands, uUtils, uDebug;
+uses uConsole, uConsts, uVariables, uCommands, uUtils, uDebug{$IFDEF USE_UNIX_IPC}, BaseUnix, Sockets{$ENDIF};
 
 const
     cSendEmptyPacketTime = 1000;
     cSendBufferSize = 1024;
+    cRecvBufferSize = 16384;
 
-type PCmd = ^TCmd;
-     TCmd = packed record
-            Next: PCmd;
+type TCmd = packed record
             loTime: Word;
             case byte of
             1: (len: byte;
@@ -57,50 +56,178 @@ type PCmd = ^TCmd;
 
 var IPCSock: PTCPSocket;
     fds: PSDLNet_SocketSet;
+{$IFDEF USE_UNIX_IPC}
+    IPCUnixSock: LongInt;
+{$ENDIF}
     isPonged: boolean;
-    SocketString: shortstring;
 
-    headcmd: PCmd;
-    lastcmd: PCmd;
+    // queued commands are stored back to back as loTime, length byte and
+    // the command itself; only the one at the head is decoded into headcmd
+    cmdQueue: record
+              buf: array of byte;
+              head, tail: LongInt;
+              end;
+    headcmd: TCmd;
+    hasHeadCmd: boolean;
 
     flushDelayTicks: LongWord;
     sendBuffer: record
                 buf: array[0..Pred(cSendBufferSize)] of byte;
                 count: Word;
                 end;
+    // received bytes from start to count are not parsed yet
+    recvBuffer: record
+                buf: array[0..Pred(cRecvBufferSize)] of byte;
+                start, count: LongInt;
+                end;
 
-function AddCmd(Time: Word; str: shortstring): PCmd;
-var command: PCmd;
+procedure DecodeHeadCmd;
 begin
-new(command);
-FillChar(command^, sizeof(TCmd), 0);
-command^.loTime:= Time;
-command^.str:= str;
-if (command^.cmd <> 'F') and (command^.cmd <> 'G') then dec(command^.len, 2); // cut timestamp
-if headcmd = nil then
+with cmdQueue do
     begin
-    headcmd:= command;
-    lastcmd:= command
+    hasHeadCmd:= head < tail;
+    if hasHeadCmd then
+        begin
+        Move(buf[head], headcmd.loTime, sizeof(headcmd.loTime));
+        Move(buf[head + sizeof(headcmd.loTime)], headcmd.str, Succ(buf[head + sizeof(headcmd.loTime)]))
+        end
     end
-else
+end;
+
+procedure AddCmd(Time: Word; str: shortstring);
+var size: LongInt;
+begin
+if (str[1] <> 'F') and (str[1] <> 'G') then dec(str[0], 2); // cut timestamp
+size:= sizeof(Time) + Succ(Length(str));
+
+with cmdQueue do
     begin
-    lastcmd^.Next:= command;
-    lastcmd:= command
+    if tail + size > Length(buf) then
+        begin
+        // drop the consumed part if that frees enough, otherwise grow
+        if (head > 0) and (head >= Length(buf) div 2) then
+            begin
+            if tail > head then
+                Move(buf[head], buf[0], tail - head);
+            dec(tail, head);
+            head:= 0
+            end;
+        if tail + size > Length(buf) then
+            SetLength(buf, Max(Length(buf) * 2, tail + size + 4096))
+        end;
+
+    Move(Time, buf[tail], sizeof(Time));
+    Move(str, buf[tail + sizeof(Time)], Succ(Length(str)));
+    inc(tail, size)
     end;
-AddCmd:= command;
+
+if not hasHeadCmd then
+    DecodeHeadCmd
 end;
 
 procedure RemoveCmd;
-var tmp: PCmd;
 begin
-TryDo(headcmd <> nil, 'Engine bug: headcmd = nil', true);
-tmp:= headcmd;
-headcmd:= headcmd^.Next;
-if headcmd = nil then
-    lastcmd:= nil;
-dispose(tmp)
+TryDo(hasHeadCmd, 'Engine bug: no head command', true);
+with cmdQueue do
+    begin
+    inc(head, sizeof(headcmd.loTime) + Succ(headcmd.len));
+    if head = tail then
+        begin
+        head:= 0;
+        tail:= 0
+        end
+    end;
+DecodeHeadCmd
+end;
+
+function isIPCOpen: boolean;
+begin
+{$IFDEF USE_UNIX_IPC}
+    if IPCUnixSock >= 0 then
+        exit(true);
+{$ENDIF}
+    isIPCOpen:= IPCSock <> nil
+end;
+
+procedure IPCSend(p: pointer; len: LongInt);
+{$IFDEF USE_UNIX_IPC}
+var sent: LongInt;
+{$ENDIF}
+begin
+{$IFDEF USE_UNIX_IPC}
+    if IPCUnixSock >= 0 then
+        begin
+        while len > 0 do
+            begin
+            sent:= fpSend(IPCUnixSock, p, len, 0);
+            if sent < 0 then
+                begin
+                if fpGetErrno = ESysEINTR then
+                    continue;
+                exit
+                end;
+            p:= @(PByteArray(p)^[sent]);
+            dec(len, sent)
+            end;
+        exit
+        end;
+{$ENDIF}
+    SDLNet_TCP_Send(IPCSock, p, len)
+end;
+
+function IPCRecv(p: pointer; maxLen: LongInt): LongInt;
+begin
+{$IFDEF USE_UNIX_IPC}
+    if IPCUnixSock >= 0 then
+        exit(fpRecv(IPCUnixSock, p, maxLen, 0));
+{$ENDIF}
+    IPCRecv:= SDLNet_TCP_Recv(IPCSock, p, maxLen)
+end;
+
+function IPCHasData: boolean;
+{$IFDEF USE_UNIX_IPC}
+var readfds: TFDSet;
+{$ENDIF}
+begin
+{$IFDEF USE_UNIX_IPC}
+    if IPCUnixSock >= 0 then
+        begin
+        fpFD_ZERO(readfds);
+        fpFD_SET(IPCUnixSock, readfds);
+        exit(fpSelect(IPCUnixSock + 1, @readfds, nil, nil, 0) > 0)
+        end;
+{$ENDIF}
+    fds^.numsockets:= 0;
+    SDLNet_AddSocket(fds, IPCSock);
+    IPCHasData:= SDLNet_CheckSockets(fds, 0) > 0
 end;
 
+{$IFDEF USE_UNIX_IPC}
+procedure InitUnixIPC;
+var addr: sockaddr_un;
+begin
+    WriteToConsole('Establishing IPC connection to unix socket ' + ipcSocketPath + ' ');
+    TryDo(Length(ipcSocketPath) < sizeof(addr.sun_path), 'IPC socket path is too long', true);
+
+    FillChar(addr, sizeof(addr), 0);
+    addr.sun_family:= AF_UNIX;
+    Move(ipcSocketPath[1], addr.sun_path[0], Length(ipcSocketPath));
+
+    // a frontend going away must show up as a send error, not kill us
+    fpSignal(SIGPIPE, signalhandler(SIG_IGN));
+
+    IPCUnixSock:= fpSocket(AF_UNIX, SOCK_STREAM, 0);
+    TryDo(IPCUnixSock >= 0, 'Cannot create IPC socket', true);
+    if fpConnect(IPCUnixSock, psockaddr(@addr), sizeof(addr)) <> 0 then
+        begin
+        fpClose(IPCUnixSock);
+        IPCUnixSock:= -1;
+        OutError('Cannot connect to ' + ipcSocketPath, true)
+        end;
+    WriteLnToConsole(msgOK)
+end;
+{$ENDIF}
+
 procedure InitIPC;
 var ipaddr: TIPAddress;
 begin
@@ -109,6 +236,13 @@ begin
     fds:= SDLNet_AllocSocketSet(1);
     SDLTry(fds <> nil, true);
     WriteLnToConsole(msgOK);
+{$IFDEF USE_UNIX_IPC}
+    if ipcSocketPath <> '' then
+        begin
+        InitUnixIPC;
+        exit
+        end;
+{$ENDIF}
     WriteToConsole('Establishing IPC connection to tcp 127.0.0.1:' + IntToStr(ipcPort) + ' ');
     {$HINTS OFF}
     SDLTry(SDLNet_ResolveHost(ipaddr, PChar('127.0.0.1'), ipcPort) = 0, true);
@@ -172,42 +306,57 @@ case s[1] of
     begin
         loTicks:= SDLNet_Read16(@s[byte(s[0]) - 1]);
         AddCmd(loTicks, s);
-        AddFileLog('[IPC in] ' + sanitizeCharForLog(s[1]) + ' ticks ' + IntToStr(lastcmd^.loTime));
+        AddFileLog('[IPC in] ' + sanitizeCharForLog(s[1]) + ' ticks ' + IntToStr(loTicks));
     end
 end;
 
 procedure IPCCheckSock;
-var i: LongInt;
+var i, free: LongInt;
     s: shortstring;
 begin
-    if IPCSock = nil then
+    if not isIPCOpen then
         exit;
 
-    fds^.numsockets:= 0;
-    SDLNet_AddSocket(fds, IPCSock);
-
-    while SDLNet_CheckSockets(fds, 0) > 0 do
+    while IPCHasData do
     begin
-        i:= SDLNet_TCP_Recv(IPCSock, @s[1], 255 - Length(SocketString));
-        if i > 0 then
-        begin
-            s[0]:= char(i);
-            SocketString:= SocketString + s;
-            while (Length(SocketString) > 1) and (Length(SocketString) > byte(SocketString[1])) do
+        free:= cRecvBufferSize - recvBuffer.count;
+        i:= IPCRecv(@recvBuffer.buf[recvBuffer.count], free);
+        if i <= 0 then
+            OutError('IPC connection lost', true);
+
+        inc(recvBuffer.count, i);
+        // commands might call IPCCheckSock themselves (e.g. waiting for a pong),
+        // so the offsets are advanced before each command is parsed
+        with recvBuffer do
+            while (count - start > 1) and (count - start > buf[start]) do
             begin
-                ParseIPCCommand(copy(SocketString, 2, byte(SocketString[1])));
-                Delete(SocketString, 1, Succ(byte(SocketString[1])))
-            end
-        end
-    else
-        OutError('IPC connection lost', true)
+                s[0]:= char(buf[start]);
+                Move(buf[start + 1], s[1], byte(s[0]));
+                inc(start, Succ(byte(s[0])));
+                ParseIPCCommand(s)
+            end;
+
+        // only the tail of an incomplete command is left to move
+        with recvBuffer do
+            if start > 0 then
+            begin
+                if count > start then
+                    Move(buf[start], buf[0], count - start);
+                dec(count, start);
+                start:= 0
+            end;
+
+        // a short read means everything available has been drained,
+        // no need to poll the socket again until the next frame
+        if i < free then
+            break
     end;
 end;
 
 procedure LoadRecordFromFile(fileName: shortstring);
 var f  : File;
-    ss : shortstring = '';
-    i  : LongInt;
+    data: array[0..Pred(cRecvBufferSize)] of byte;
+    start, count, i: LongInt;
     s  : shortstring;
 begin
 
@@ -218,20 +367,24 @@ assign(f, fileName);
 reset(f, 1);
 tryDo(IOResult = 0, 'Error opening file ' + fileName, true);
 
+// read big chunks and parse the commands in place,
+// only an incomplete command at the end of a chunk gets moved
 i:= 0; // avoid compiler hints
-s[0]:= #0;
+count:= 0;
 repeat
-    BlockRead(f, s[1], 255 - Length(ss), i);
-    if i > 0 then
+    BlockRead(f, data[count], cRecvBufferSize - count, i);
+    inc(count, i);
+    start:= 0;
+    while (count - start > 1) and (count - start > data[start]) do
         begin
-        s[0]:= char(i);
-        ss:= ss + s;
-        while (Length(ss) > 1)and(Length(ss) > byte(ss[1])) do
-            begin
-            ParseIPCCommand(copy(ss, 2, byte(ss[1])));
-            Delete(ss, 1, Succ(byte(ss[1])));
-            end
-        end
+        s[0]:= char(data[start]);
+        Move(data[start + 1], s[1], byte(s[0]));
+        inc(start, Succ(byte(s[0])));
+        ParseIPCCommand(s)
+        end;
+    if count > start then
+        Move(data[start], data[0], count - start);
+    dec(count, start)
 until i = 0;
 
 close(f)
@@ -261,9 +414,9 @@ end;
 
 procedure flushBuffer();
 begin
-    if IPCSock <> nil then
+    if isIPCOpen then
         begin
-        SDLNet_TCP_Send(IPCSock, @sendBuffer.buf, sendBuffer.count);
+        IPCSend(@sendBuffer.buf, sendBuffer.count);
         flushDelayTicks:= 0;
         sendBuffer.count:= 0
         end
@@ -271,7 +424,7 @@ end;
 
 procedure SendIPC(s: shortstring);
 begin
-if IPCSock <> nil then
+if isIPCOpen then
     begin
     if s[0] > #251 then
         s[0]:= #251;
@@ -292,15 +445,15 @@ if IPCSock <> nil then
         if (s[1] = 'N') or (s[1] = '#') then
             flushBuffer();
         end else
-        SDLNet_TCP_Send(IPCSock, @s, Succ(byte(s[0])))
+        IPCSend(@s, Succ(byte(s[0])))
     end
 end;
 
 procedure SendIPCRaw(p: pointer; len: Longword);
 begin
-if IPCSock <> nil then
+if isIPCOpen then
     begin
-    SDLNet_TCP_Send(IPCSock, p, len)
+    IPCSend(p, len)
     end
 end;
 
@@ -349,17 +502,17 @@ var tmpflag: boolean;
 begin
 tmpflag:= true;
 
-while (headcmd <> nil)
-    and (tmpflag or (headcmd^.cmd = '#')) // '#' is the only cmd which can be sent within same tick after 'N'
-    and ((GameTicks = LongWord(hiTicks shl 16 + headcmd^.loTime))
-        or (headcmd^.cmd = 's') // for these commands time is not specified
-        or (headcmd^.cmd = 'h') // seems the hedgewars protocol does not allow remote synced commands
-        or (headcmd^.cmd = '#') // must be synced for saves to work
-        or (headcmd^.cmd = 'b')
-        or (headcmd^.cmd = 'F')
-        or (headcmd^.cmd = 'G')) do
+while hasHeadCmd
+    and (tmpflag or (headcmd.cmd = '#')) // '#' is the only cmd which can be sent within same tick after 'N'
+    and ((GameTicks = LongWord(hiTicks shl 16 + headcmd.loTime))
+        or (headcmd.cmd = 's') // for these commands time is not specified
+        or (headcmd.cmd = 'h') // seems the hedgewars protocol does not allow remote synced commands
+        or (headcmd.cmd = '#') // must be synced for saves to work
+        or (headcmd.cmd = 'b')
+        or (headcmd.cmd = 'F')
+        or (headcmd.cmd = 'G')) do
     begin
-    case headcmd^.cmd of
+    case headcmd.cmd of
         '+': ; // do nothing - it is just an empty packet
         '#': begin
             AddFileLog('hiTicks increment by remote message');
@@ -382,58 +535,58 @@ while (headcmd <> nil)
         'J': ParseCommand('hjump', true);
         ',': ParseCommand('skip', true);
         'c': begin
-            s:= copy(headcmd^.str, 2, Pred(headcmd^.len));
+            s:= copy(headcmd.str, 2, Pred(headcmd.len));
             ParseCommand('gencmd ' + s, true);
              end;
-        's': ParseChatCommand('chatmsg ', headcmd^.str, 2);
-        'b': ParseChatCommand('chatmsg ' + #4, headcmd^.str, 2);
-        'F': ParseCommand('teamgone u' + copy(headcmd^.str, 2, Pred(headcmd^.len)), true);
-        'G': ParseCommand('teamback u' + copy(headcmd^.str, 2, Pred(headcmd^.len)), true);
-        'f': ParseCommand('teamgone s' + copy(headcmd^.str, 2, Pred(headcmd^.len)), true);
-        'g': ParseCommand('teamback s' + copy(headcmd^.str, 2, Pred(headcmd^.len)), true);
+        's': ParseChatCommand('chatmsg ', headcmd.str, 2);
+        'b': ParseChatCommand('chatmsg ' + #4, headcmd.str, 2);
+        'F': ParseCommand('teamgone u' + copy(headcmd.str, 2, Pred(headcmd.len)), true);
+        'G': ParseCommand('teamback u' + copy(headcmd.str, 2, Pred(headcmd.len)), true);
+        'f': ParseCommand('teamgone s' + copy(headcmd.str, 2, Pred(headcmd.len)), true);
+        'g': ParseCommand('teamback s' + copy(headcmd.str, 2, Pred(headcmd.len)), true);
         'N': begin
             tmpflag:= false;
-            lastTurnChecksum:= SDLNet_Read32(@headcmd^.str[2]);
-            AddFileLog('got cmd "N": time '+IntToStr(hiTicks shl 16 + headcmd^.loTime))
+            lastTurnChecksum:= SDLNet_Read32(@headcmd.str[2]);
+            AddFileLog('got cmd "N": time '+IntToStr(hiTicks shl 16 + headcmd.loTime))
              end;
         'p': begin
-            x32:= SDLNet_Read32(@(headcmd^.str[2]));
-            y32:= SDLNet_Read32(@(headcmd^.str[6]));
+            x32:= SDLNet_Read32(@(headcmd.str[2]));
+            y32:= SDLNet_Read32(@(headcmd.str[6]));
             doPut(x32, y32, false)
              end;
         'P': begin
             // these are equations solved for CursorPoint
-            // SDLNet_Read16(@(headcmd^.X)) == CursorPoint.X - WorldDx;
-            // SDLNet_Read16(@(headcmd^.Y)) == cScreenHeight - CursorPoint.Y - WorldDy;
+            // SDLNet_Read16(@(headcmd.X)) == CursorPoint.X - WorldDx;
+            // SDLNet_Read16(@(headcmd.Y)) == cScreenHeight - CursorPoint.Y - WorldDy;
             if CurrentTeam^.ExtDriven then
                begin
-               TargetCursorPoint.X:= LongInt(SDLNet_Read32(@(headcmd^.str[2]))) + WorldDx;
-               TargetCursorPoint.Y:= cScreenHeight - LongInt(SDLNet_Read32(@(headcmd^.str[6]))) - WorldDy;
+               TargetCursorPoint.X:= LongInt(SDLNet_Read32(@(headcmd.str[2]))) + WorldDx;
+               TargetCursorPoint.Y:= cScreenHeight - LongInt(SDLNet_Read32(@(headcmd.str[6]))) - WorldDy;
                if not bShowAmmoMenu and autoCameraOn then
                     CursorPoint:= TargetCursorPoint
                end
              end;
-        'w': ParseCommand('setweap ' + headcmd^.str[2], true);
-        't': ParseCommand('taunt ' + headcmd^.str[2], true);
-        'h': ParseCommand('hogsay ' + copy(headcmd^.str, 2, Pred(headcmd^.len)), true);
-        '1'..'5': ParseCommand('timer ' + headcmd^.cmd, true);
+        'w': ParseCommand('setweap ' + headcmd.str[2], true);
+        't': ParseCommand('taunt ' + headcmd.str[2], true);
+        'h': ParseCommand('hogsay ' + copy(headcmd.str, 2, Pred(headcmd.len)), true);
+        '1'..'5': ParseCommand('timer ' + headcmd.cmd, true);
         else
-            if (byte(headcmd^.cmd) >= 128) and (byte(headcmd^.cmd) <= 128 + cMaxSlotIndex) then
-                ParseCommand('slot ' + char(byte(headcmd^.cmd) - 79), true)
+            if (byte(headcmd.cmd) >= 128) and (byte(headcmd.cmd) <= 128 + cMaxSlotIndex) then
+                ParseCommand('slot ' + char(byte(headcmd.cmd) - 79), true)
                 else
-                OutError('Unexpected protocol command: ' + headcmd^.cmd, True)
+                OutError('Unexpected protocol command: ' + headcmd.cmd, True)
         end;
     RemoveCmd
     end;
 
-if (headcmd <> nil) and tmpflag and (not CurrentTeam^.hasGone) then
-    TryDo(GameTicks < LongWord(hiTicks shl 16) + headcmd^.loTime,
-            'oops, queue error. in buffer: ' + headcmd^.cmd +
+if (hasHeadCmd) and tmpflag and (not CurrentTeam^.hasGone) then
+    TryDo(GameTicks < LongWord(hiTicks shl 16) + headcmd.loTime,
+            'oops, queue error. in buffer: ' + headcmd.cmd +
             ' (' + IntToStr(GameTicks) + ' > ' +
-            IntToStr(hiTicks shl 16 + headcmd^.loTime) + ')',
+            IntToStr(hiTicks shl 16 + headcmd.loTime) + ')',
             true);
 
-isInLag:= (headcmd = nil) and tmpflag and (not CurrentTeam^.hasGone);
+isInLag:= (not hasHeadCmd) and tmpflag and (not CurrentTeam^.hasGone);
 
 if isInLag and fastUntilLag then 
 begin
@@ -447,8 +600,9 @@ begin
     SendIPC('E' + s);
     // TODO: should we try to clean more stuff here?
     SDL_Quit;
+    FlushFileLog;
 
-    if IPCSock <> nil then
+    if isIPCOpen then
         halt(HaltFatalError)
     else
         halt(HaltFatalErrorNoIPC);
@@ -504,11 +658,16 @@ begin
     RegisterVariable('fatal', @chFatalError, true );
 
     IPCSock:= nil;
+{$IFDEF USE_UNIX_IPC}
+    IPCUnixSock:= -1;
+{$ENDIF}
 
-    headcmd:= nil;
-    lastcmd:= nil;
+    cmdQueue.head:= 0;
+    cmdQueue.tail:= 0;
+    hasHeadCmd:= false;
     isPonged:= false;
-    SocketString:= '';
+    recvBuffer.start:= 0;
+    recvBuffer.count:= 0;
 
     hiTicks:= 0;
     flushDelayTicks:= 0;
@@ -517,9 +676,14 @@ end;
 
 procedure freeModule;
 begin
-    while headcmd <> nil do RemoveCmd;
+    SetLength(cmdQueue.buf, 0);
+    hasHeadCmd:= false;
     SDLNet_FreeSocketSet(fds);
     SDLNet_TCP_Close(IPCSock);
+{$IFDEF USE_UNIX_IPC}
+    if IPCUnixSock >= 0 then
+        fpClose(IPCUnixSock);
+{$ENDIF}
     SDLNet_Quit();
 
 end;
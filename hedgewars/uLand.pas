@@ -56,18 +56,18 @@ begin
     begin
         yd:= LAND_HEIGHT - 1;
         repeat
-            while (yd > 0) and (Land[yd, x] <> lfBasic) do dec(yd);
+            while (yd > 0) and (Land[yd * LAND_WIDTH + x] <> lfBasic) do dec(yd);
 
             if (yd < 0) then
                 yd:= 0;
 
-            while (yd < LAND_HEIGHT) and (Land[yd, x] = lfBasic) do
+            while (yd < LAND_HEIGHT) and (Land[yd * LAND_WIDTH + x] = lfBasic) do
                 inc(yd);
             dec(yd);
             yu:= yd;
 
-            while (yu > 0  ) and (Land[yu, x] = lfBasic) do dec(yu);
-            while (yu < yd ) and (Land[yu, x] <>  lfBasic) do inc(yu);
+            while (yu > 0  ) and (Land[yu * LAND_WIDTH + x] = lfBasic) do dec(yu);
+            while (yu < yd ) and (Land[yu * LAND_WIDTH + x] <>  lfBasic) do inc(yu);
 
             if (yd < LAND_HEIGHT - 1) and ((yd - yu) >= 16) then
                 begin
@@ -108,7 +108,7 @@ begin
 
     for x:= 0 to LAND_WIDTH - 1 do
         for y:= 0 to LAND_HEIGHT - 1 do
-            if Land[y, x] = 0 then
+            if Land[y * LAND_WIDTH + x] = 0 then
                 if s < y then
                     begin
                     for i:= max(s, y - 8) to y - 1 do
@@ -116,9 +116,9 @@ begin
                         if ((x + i) and 16) = 0 then c:= c1 else c:= c2;
 
                         if (cReducedQuality and rqBlurryLand) = 0 then
-                            LandPixels[i, x]:= c
+                            LandPixels[i * LAND_PIXELS_WIDTH + x]:= c
                         else
-                            LandPixels[i div 2, x div 2]:= c
+                            LandPixels[(i div 2) * LAND_PIXELS_WIDTH + (x div 2)]:= c
                         end;
                     s:= LAND_HEIGHT
                     end
@@ -131,9 +131,9 @@ begin
                     if ((x + y) and 16) = 0 then c:= c1 else c:= c2;
 
                     if (cReducedQuality and rqBlurryLand) = 0 then
-                        LandPixels[y, x]:= c
+                        LandPixels[y * LAND_PIXELS_WIDTH + x]:= c
                     else
-                        LandPixels[y div 2, x div 2]:= c
+                        LandPixels[(y div 2) * LAND_PIXELS_WIDTH + (x div 2)]:= c
                     end;
                 end;
 
@@ -142,7 +142,7 @@ begin
 
     for y:= 0 to LAND_HEIGHT - 1 do
         for x:= 0 to LAND_WIDTH - 1 do
-            if Land[y, x] = 0 then
+            if Land[y * LAND_WIDTH + x] = 0 then
                 if s < x then
                     begin
                     for i:= max(s, x - 8) to x - 1 do
@@ -150,9 +150,9 @@ begin
                         if ((y + i) and 16) = 0 then c:= c1 else c:= c2;
 
                         if (cReducedQuality and rqBlurryLand) = 0 then
-                            LandPixels[y, i]:= c
+                            LandPixels[y * LAND_PIXELS_WIDTH + i]:= c
                         else
-                            LandPixels[y div 2, i div 2]:= c
+                            LandPixels[(y div 2) * LAND_PIXELS_WIDTH + (i div 2)]:= c
                         end;
                     s:= LAND_WIDTH
                     end
@@ -165,9 +165,9 @@ begin
                     if ((x + y) and 16) = 0 then c:= c1 else c:= c2;
 
                     if (cReducedQuality and rqBlurryLand) = 0 then
-                        LandPixels[y, x]:= c
+                        LandPixels[y * LAND_PIXELS_WIDTH + x]:= c
                     else
-                        LandPixels[y div 2, x div 2]:= c
+                        LandPixels[(y div 2) * LAND_PIXELS_WIDTH + (x div 2)]:= c
                     end;
                 end
 end;
@@ -260,11 +260,11 @@ p:= Surface^.pixels;
 for y:= 0 to LAND_HEIGHT - 1 do
     begin
     for x:= 0 to LAND_WIDTH - 1 do
-    if Land[y, x] <> 0 then
+    if Land[y * LAND_WIDTH + x] <> 0 then
         if (cReducedQuality and rqBlurryLand) = 0 then
-            LandPixels[y, x]:= p^[x] or AMask
+            LandPixels[y * LAND_PIXELS_WIDTH + x]:= p^[x] or AMask
         else
-            LandPixels[y div 2, x div 2]:= p^[x] or AMask;
+            LandPixels[(y div 2) * LAND_PIXELS_WIDTH + (x div 2)]:= p^[x] or AMask;
 
     p:= PLongwordArray(@(p^[Surface^.pitch div 4]));
     end;
@@ -294,38 +294,38 @@ begin
 
     for x:= leftX+2 to rightX-2 do
         for y:= topY+2 to LAND_HEIGHT-3 do
-            if (Land[y, x] = 0) and
-               (((Land[y, x-1] = lfBasic) and ((Land[y+1,x] = lfBasic)) or (Land[y-1,x] = lfBasic)) or
-               ((Land[y, x+1] = lfBasic) and ((Land[y-1,x] = lfBasic) or (Land[y+1,x] = lfBasic)))) then
+            if (Land[y * LAND_WIDTH + x] = 0) and
+               (((Land[y * LAND_WIDTH + (x-1)] = lfBasic) and ((Land[(y+1) * LAND_WIDTH + x] = lfBasic)) or (Land[(y-1) * LAND_WIDTH + x] = lfBasic)) or
+               ((Land[y * LAND_WIDTH + (x+1)] = lfBasic) and ((Land[(y-1) * LAND_WIDTH + x] = lfBasic) or (Land[(y+1) * LAND_WIDTH + x] = lfBasic)))) then
             begin
                 if (cReducedQuality and rqBlurryLand) = 0 then
                     begin
-                    if (Land[y, x-1] = lfBasic) and (LandPixels[y, x-1] and AMask <> 0) then
-                        LandPixels[y, x]:= LandPixels[y, x-1]
+                    if (Land[y * LAND_WIDTH + (x-1)] = lfBasic) and (LandPixels[y * LAND_PIXELS_WIDTH + (x-1)] and AMask <> 0) then
+                        LandPixels[y * LAND_PIXELS_WIDTH + x]:= LandPixels[y * LAND_PIXELS_WIDTH + (x-1)]
 
-                    else if (Land[y, x+1] = lfBasic) and (LandPixels[y, x+1] and AMask <> 0) then
-                        LandPixels[y, x]:= LandPixels[y, x+1]
+                    else if (Land[y * LAND_WIDTH + (x+1)] = lfBasic) and (LandPixels[y * LAND_PIXELS_WIDTH + (x+1)] and AMask <> 0) then
+                        LandPixels[y * LAND_PIXELS_WIDTH + x]:= LandPixels[y * LAND_PIXELS_WIDTH + (x+1)]
 
-                    else if (Land[y-1, x] = lfBasic) and (LandPixels[y-1, x] and AMask <> 0) then
-                        LandPixels[y, x]:= LandPixels[y-1, x]
+                    else if (Land[(y-1) * LAND_WIDTH + x] = lfBasic) and (LandPixels[(y-1) * LAND_PIXELS_WIDTH + x] and AMask <> 0) then
+                        LandPixels[y * LAND_PIXELS_WIDTH + x]:= LandPixels[(y-1) * LAND_PIXELS_WIDTH + x]
 
-                    else if (Land[y+1, x] = lfBasic) and (LandPixels[y+1, x] and AMask <> 0) then
-                        LandPixels[y, x]:= LandPixels[y+1, x];
+                    else if (Land[(y+1) * LAND_WIDTH + x] = lfBasic) and (LandPixels[(y+1) * LAND_PIXELS_WIDTH + x] and AMask <> 0) then
+                        LandPixels[y * LAND_PIXELS_WIDTH + x]:= LandPixels[(y+1) * LAND_PIXELS_WIDTH + x];
 
-                    if (((LandPixels[y,x] and AMask) shr AShift) > 10) then
-                        LandPixels[y,x]:= (LandPixels[y,x] and (not AMask)) or (128 shl AShift)
+                    if (((LandPixels[y * LAND_PIXELS_WIDTH + x] and AMask) shr AShift) > 10) then
+                        LandPixels[y * LAND_PIXELS_WIDTH + x]:= (LandPixels[y * LAND_PIXELS_WIDTH + x] and (not AMask)) or (128 shl AShift)
                     end;
-                Land[y,x]:= lfObject
+                Land[y * LAND_WIDTH + x]:= lfObject
             end
-            else if (Land[y, x] = 0) and
-                    (((Land[y, x-1] = lfBasic) and (Land[y+1,x-1] = lfBasic) and (Land[y+2,x] = lfBasic)) or
-                    ((Land[y, x-1] = lfBasic) and (Land[y-1,x-1] = lfBasic) and (Land[y-2,x] = lfBasic)) or
-                    ((Land[y, x+1] = lfBasic) and (Land[y+1,x+1] = lfBasic) and (Land[y+2,x] = lfBasic)) or
-                    ((Land[y, x+1] = lfBasic) and (Land[y-1,x+1] = lfBasic) and (Land[y-2,x] = lfBasic)) or
-                    ((Land[y+1, x] = lfBasic) and (Land[y+1,x+1] = lfBasic) and (Land[y,x+2] = lfBasic)) or
-                    ((Land[y-1, x] = lfBasic) and (Land[y-1,x+1] = lfBasic) and (Land[y,x+2] = lfBasic)) or
-                    ((Land[y+1, x] = lfBasic) and (Land[y+1,x-1] = lfBasic) and (Land[y,x-2] = lfBasic)) or
-                    ((Land[y-1, x] = lfBasic) and (Land[y-1,x-1] = lfBasic) and (Land[y,x-2] = lfBasic))) then
+            else if (Land[y * LAND_WIDTH + x] = 0) and
+                    (((Land[y * LAND_WIDTH + (x-1)] = lfBasic) and (Land[(y+1) * LAND_WIDTH + (x-1)] = lfBasic) and (Land[(y+2) * LAND_WIDTH + x] = lfBasic)) or
+                    ((Land[y * LAND_WIDTH + (x-1)] = lfBasic) and (Land[(y-1) * LAND_WIDTH + (x-1)] = lfBasic) and (Land[(y-2) * LAND_WIDTH + x] = lfBasic)) or
+                    ((Land[y * LAND_WIDTH + (x+1)] = lfBasic) and (Land[(y+1) * LAND_WIDTH + (x+1)] = lfBasic) and (Land[(y+2) * LAND_WIDTH + x] = lfBasic)) or
+                    ((Land[y * LAND_WIDTH + (x+1)] = lfBasic) and (Land[(y-1) * LAND_WIDTH + (x+1)] = lfBasic) and (Land[(y-2) * LAND_WIDTH + x] = lfBasic)) or
+                    ((Land[(y+1) * LAND_WIDTH + x] = lfBasic) and (Land[(y+1) * LAND_WIDTH + (x+1)] = lfBasic) and (Land[y * LAND_WIDTH + (x+2)] = lfBasic)) or
+                    ((Land[(y-1) * LAND_WIDTH + x] = lfBasic) and (Land[(y-1) * LAND_WIDTH + (x+1)] = lfBasic) and (Land[y * LAND_WIDTH + (x+2)] = lfBasic)) or
+                    ((Land[(y+1) * LAND_WIDTH + x] = lfBasic) and (Land[(y+1) * LAND_WIDTH + (x-1)] = lfBasic) and (Land[y * LAND_WIDTH + (x-2)] = lfBasic)) or
+                    ((Land[(y-1) * LAND_WIDTH + x] = lfBasic) and (Land[(y-1) * LAND_WIDTH + (x-1)] = lfBasic) and (Land[y * LAND_WIDTH + (x-2)] = lfBasic))) then
 
                 begin
 
@@ -333,22 +333,22 @@ begin
 
                     begin
 
-                    if (Land[y, x-1] = lfBasic) and (LandPixels[y,x-1] and AMask <> 0) then
-                        LandPixels[y, x]:= LandPixels[y, x-1]
+                    if (Land[y * LAND_WIDTH + (x-1)] = lfBasic) and (LandPixels[y * LAND_PIXELS_WIDTH + (x-1)] and AMask <> 0) then
+                        LandPixels[y * LAND_PIXELS_WIDTH + x]:= LandPixels[y * LAND_PIXELS_WIDTH + (x-1)]
 
-                    else if (Land[y, x+1] = lfBasic) and (LandPixels[y,x+1] and AMask <> 0) then
-                        LandPixels[y, x]:= LandPixels[y, x+1]
+                    else if (Land[y * LAND_WIDTH + (x+1)] = lfBasic) and (LandPixels[y * LAND_PIXELS_WIDTH + (x+1)] and AMask <> 0) then
+                        LandPixels[y * LAND_PIXELS_WIDTH + x]:= LandPixels[y * LAND_PIXELS_WIDTH + (x+1)]
 
-                    else if (Land[y+1, x] = lfBasic) and (LandPixels[y+1,x] and AMask <> 0) then
-                        LandPixels[y, x]:= LandPixels[y+1, x]
+                    else if (Land[(y+1) * LAND_WIDTH + x] = lfBasic) and (LandPixels[(y+1) * LAND_PIXELS_WIDTH + x] and AMask <> 0) then
+                        LandPixels[y * LAND_PIXELS_WIDTH + x]:= LandPixels[(y+1) * LAND_PIXELS_WIDTH + x]
 
-                    else if (Land[y-1, x] = lfBasic) and (LandPixels[y-1,x] and AMask <> 0) then
-                        LandPixels[y, x]:= LandPixels[y-1, x];
+                    else if (Land[(y-1) * LAND_WIDTH + x] = lfBasic) and (LandPixels[(y-1) * LAND_PIXELS_WIDTH + x] and AMask <> 0) then
+                        LandPixels[y * LAND_PIXELS_WIDTH + x]:= LandPixels[(y-1) * LAND_PIXELS_WIDTH + x];
 
-                    if (((LandPixels[y,x] and AMask) shr AShift) > 10) then
-                        LandPixels[y,x]:= (LandPixels[y,x] and (not AMask)) or (64 shl AShift)
+                    if (((LandPixels[y * LAND_PIXELS_WIDTH + x] and AMask) shr AShift) > 10) then
+                        LandPixels[y * LAND_PIXELS_WIDTH + x]:= (LandPixels[y * LAND_PIXELS_WIDTH + x] and (not AMask)) or (64 shl AShift)
                     end;
-                Land[y,x]:= lfObject
+                Land[y * LAND_WIDTH + x]:= lfObject
             end;
 
     AddProgress();
@@ -440,7 +440,7 @@ if (tmpsurf <> nil) and (tmpsurf^.format^.BytesPerPixel = 4) then
         for y:= 0 to Pred(tmpsurf^.h) do
             begin
             for x:= 0 to Pred(tmpsurf^.w) do
-                SetLand(Land[cpY + y, cpX + x], p^[x]);
+                SetLand(Land[(cpY + y) * LAND_WIDTH + (cpX + x)], p^[x]);
             p:= PLongwordArray(@(p^[tmpsurf^.pitch div 4]));
             end;
 
@@ -501,17 +501,18 @@ begin
 for w:= 0 to 23 do
     for x:= leftX to rightX do
         begin
-        Land[Longword(cWaterLine) - 1 - w, x]:= lfIndestructible;
+        Land[(Longword(cWaterLine) - 1 - w) * LAND_WIDTH + x]:= lfIndestructible;
         if (x + w) mod 32 < 16 then
             c:= AMask
         else
             c:= AMask or RMask or GMask; // FF00FFFF
 
         if (cReducedQuality and rqBlurryLand) = 0 then
-            LandPixels[Longword(cWaterLine) - 1 - w, x]:= c
+            LandPixels[(Longword(cWaterLine) - 1 - w) * LAND_PIXELS_WIDTH + x]:= c
         else
-            LandPixels[(Longword(cWaterLine) - 1 - w) div 2, x div 2]:= c
-        end
+            LandPixels[((Longword(cWaterLine) - 1 - w) div 2) * LAND_PIXELS_WIDTH + (x div 2)]:= c
+        end;
+LandTilesAdded(leftX, cWaterLine - 24, rightX, cWaterLine - 1)
 end;
 
 procedure GenMap;
@@ -566,7 +567,7 @@ if (GameFlags and gfBorder) <> 0 then
 else
     for y:= topY to topY + 5 do
         for x:= leftX to rightX do
-            if Land[y, x] <> 0 then
+            if Land[y * LAND_WIDTH + x] <> 0 then
                 begin
                 inc(c);
                 if c > LongWord((LAND_WIDTH div 2)) then // avoid accidental triggering
@@ -583,13 +584,13 @@ if hasBorder then
         for y:= 0 to LAND_HEIGHT - 1 do
             for x:= 0 to LAND_WIDTH - 1 do
                 if (y < topY) or (x < leftX) or (x > rightX) then
-                    Land[y, x]:= lfIndestructible;
+                    Land[y * LAND_WIDTH + x]:= lfIndestructible;
         end
     else if topY > 0 then
         begin
         for y:= 0 to LongInt(topY) - 1 do
             for x:= 0 to LAND_WIDTH - 1 do
-                Land[y, x]:= lfIndestructible;
+                Land[y * LAND_WIDTH + x]:= lfIndestructible;
         end;
     // experiment hardcoding cave
     // also try basing cave dimensions on map/template dimensions, if they exist
@@ -598,8 +599,8 @@ if hasBorder then
         if (WorldEdge <> weBounce) and (WorldEdge <> weWrap) then
             for y:= topY to LAND_HEIGHT - 1 do
                     begin
-                    Land[y, leftX + w]:= lfIndestructible;
-                    Land[y, rightX - w]:= lfIndestructible;
+                    Land[y * LAND_WIDTH + (leftX + w)]:= lfIndestructible;
+                    Land[y * LAND_WIDTH + (rightX - w)]:= lfIndestructible;
                     if (y + w) mod 32 < 16 then
                         c:= AMask
                     else
@@ -607,28 +608,28 @@ if hasBorder then
 
                     if (cReducedQuality and rqBlurryLand) = 0 then
                         begin
-                        LandPixels[y, leftX + w]:= c;
-                        LandPixels[y, rightX - w]:= c;
+                        LandPixels[y * LAND_PIXELS_WIDTH + (leftX + w)]:= c;
+                        LandPixels[y * LAND_PIXELS_WIDTH + (rightX - w)]:= c;
                         end
                     else
                         begin
-                        LandPixels[y div 2, (leftX + w) div 2]:= c;
-                        LandPixels[y div 2, (rightX - w) div 2]:= c;
+                        LandPixels[(y div 2) * LAND_PIXELS_WIDTH + ((leftX + w) div 2)]:= c;
+                        LandPixels[(y div 2) * LAND_PIXELS_WIDTH + ((rightX - w) div 2)]:= c;
                         end;
                     end;
 
         for x:= leftX to rightX do
             begin
-            Land[topY + w, x]:= lfIndestructible;
+            Land[(topY + w) * LAND_WIDTH + x]:= lfIndestructible;
             if (x + w) mod 32 < 16 then
                 c:= AMask
             else
                 c:= AMask or RMask or GMask; // FF00FFFF
 
             if (cReducedQuality and rqBlurryLand) = 0 then
-                LandPixels[topY + w, x]:= c
+                LandPixels[(topY + w) * LAND_PIXELS_WIDTH + x]:= c
             else
-                LandPixels[(topY + w) div 2, x div 2]:= c;
+                LandPixels[((topY + w) div 2) * LAND_PIXELS_WIDTH + (x div 2)]:= c;
             end;
         end;
     end;
@@ -639,6 +640,10 @@ if (GameFlags and gfBottomBorder) <> 0 then
 if (GameFlags and gfDisableGirders) <> 0 then
     hasGirders:= false;
 
+// the shape of the land is done, from here on every change to it goes
+// through code keeping the tile summary up to date
+RebuildLandTiles;
+
 if (GameFlags and gfForts = 0) and (maskOnly or (cPathz[ptMapCurrent] = '')) then
     AddObjects
 
@@ -653,23 +658,23 @@ if GrayScale then
         for x:= leftX to rightX do
             for y:= topY to LAND_HEIGHT-1 do
                 begin
-                w:= LandPixels[y,x];
+                w:= LandPixels[y * LAND_PIXELS_WIDTH + x];
                 w:= round(((w shr RShift and $FF) * RGB_LUMINANCE_RED +
                       (w shr BShift and $FF) * RGB_LUMINANCE_GREEN +
                       (w shr GShift and $FF) * RGB_LUMINANCE_BLUE));
                 if w > 255 then
                     w:= 255;
-                w:= (w and $FF shl RShift) or (w and $FF shl BShift) or (w and $FF shl GShift) or (LandPixels[y,x] and AMask);
-                LandPixels[y,x]:= w or (LandPixels[y, x] and AMask)
+                w:= (w and $FF shl RShift) or (w and $FF shl BShift) or (w and $FF shl GShift) or (LandPixels[y * LAND_PIXELS_WIDTH + x] and AMask);
+                LandPixels[y * LAND_PIXELS_WIDTH + x]:= w or (LandPixels[y * LAND_PIXELS_WIDTH + x] and AMask)
                 end
     else
         for x:= leftX div 2 to rightX div 2 do
             for y:= topY div 2 to LAND_HEIGHT-1 div 2 do
                 begin
-                w:= LandPixels[y div 2,x div 2];
+                w:= LandPixels[(y div 2) * LAND_PIXELS_WIDTH + (x div 2)];
                 w:= ((w shr RShift and $FF) +  (w shr BShift and $FF) + (w shr GShift and $FF)) div 3;
-                w:= (w and $FF shl RShift) or (w and $FF shl BShift) or (w and $FF shl GShift) or (LandPixels[y div 2,x div 2] and AMask);
-                LandPixels[y,x]:= w or (LandPixels[y div 2, x div 2] and AMask)
+                w:= (w and $FF shl RShift) or (w and $FF shl BShift) or (w and $FF shl GShift) or (LandPixels[(y div 2) * LAND_PIXELS_WIDTH + (x div 2)] and AMask);
+                LandPixels[y * LAND_PIXELS_WIDTH + x]:= w or (LandPixels[(y div 2) * LAND_PIXELS_WIDTH + (x div 2)] and AMask)
                 end
     end;
 
@@ -720,7 +725,7 @@ begin
                 for yy:= y * lh to y * lh + 7 do
                     for xx:= x * lw + cbit to x * lw + cbit + 7 do
                         if ((yy-oy) and LAND_HEIGHT_MASK = 0) and ((xx-ox) and LAND_WIDTH_MASK = 0)
-                           and (Land[yy-oy, xx-ox] <> 0) then
+                           and (Land[(yy-oy) * LAND_WIDTH + (xx-ox)] <> 0) then
                             inc(t);
                 if t > 8 then
                     Preview[y, x]:= Preview[y, x] or ($80 shr bit);
@@ -765,7 +770,7 @@ begin
             for yy:= y * lh - oy to y * lh + lh - 1 - oy do
                 for xx:= x * lw - ox to x * lw + lw - 1 - ox do
                     if (yy and LAND_HEIGHT_MASK = 0) and (xx and LAND_WIDTH_MASK = 0)
-                        and (Land[yy, xx] <> 0) then
+                        and (Land[yy * LAND_WIDTH + xx] <> 0) then
                         inc(t);
 
             Preview[y, x]:= t * 255 div (lh * lw);
@@ -786,7 +791,7 @@ var adler, i: LongInt;
 begin
     adler:= 1;
     for i:= 0 to LAND_HEIGHT-1 do
-        adler:= Adler32Update(adler, @Land[i,0], LAND_WIDTH);
+        adler:= Adler32Update(adler, @Land[i * LAND_WIDTH], LAND_WIDTH);
     s:= 'M' + IntToStr(adler) + cScriptName;
 
     ScriptSetString('LandDigest', s);
@@ -804,22 +809,21 @@ begin
     digest:= '';
     LAND_WIDTH:= 0;
     LAND_HEIGHT:= 0;
-(*
-    if (cReducedQuality and rqBlurryLand) = 0 then
-        SetLength(LandPixels, LAND_HEIGHT, LAND_WIDTH)
-    else
-        SetLength(LandPixels, LAND_HEIGHT div 2, LAND_WIDTH div 2);
-
-    SetLength(Land, LAND_HEIGHT, LAND_WIDTH);
-    SetLength(LandDirty, (LAND_HEIGHT div 32), (LAND_WIDTH div 32));
-*)
+    LAND_PIXELS_WIDTH:= 0;
+    LandTilesValid:= false;
 end;
 
 procedure freeModule;
 begin
-    SetLength(Land, 0, 0);
-    SetLength(LandPixels, 0, 0);
+    SetLength(Land, 0);
+    SetLength(LandPixels, 0);
     SetLength(LandDirty, 0, 0);
+    SetLength(LandDirtyList, 0);
+    SetLength(LandSmoothList, 0);
+    LandDirtyCount:= 0;
+    LandSmoothCount:= 0;
+    SetLength(LandTiles, 0);
+    SetLength(LandTileRows, 0);
 end;
 
 end.
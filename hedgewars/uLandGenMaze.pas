@@ -403,11 +403,11 @@ off_y := LAND_HEIGHT - playHeight;
 
 for x := 0 to playWidth do
     for y := 0 to off_y - 1 do
-        Land[y, x] := 0;
+        Land[y * LAND_WIDTH + x] := 0;
 
 for x := 0 to playWidth do
     for y := off_y to LAND_HEIGHT - 1 do
-        Land[y, x] := lfBasic;
+        Land[y * LAND_WIDTH + x] := lfBasic;
 
 for y := 0 to num_cells_y - 1 do
     for x := 0 to num_cells_x - 1 do
@@ -527,9 +527,9 @@ if maze_inverted then
 else
     begin
     x := 0;
-    while Land[cellsize div 2 + cellsize + off_y, x] = lfBasic do
+    while Land[(cellsize div 2 + cellsize + off_y) * LAND_WIDTH + x] = lfBasic do
         x := x + 1;
-    while Land[cellsize div 2 + cellsize + off_y, x] = 0 do
+    while Land[(cellsize div 2 + cellsize + off_y) * LAND_WIDTH + x] = 0 do
         x := x + 1;
     FillLand(x+1, cellsize div 2 + cellsize + off_y, 0, 0);
     end;
@@ -168,24 +168,24 @@ begin
             }
 
             if r < rCutoff then
-                Land[y, x]:= 0
+                Land[y * LAND_WIDTH + x]:= 0
             else if param1 = 0 then
-                Land[y, x]:= lfObjMask
+                Land[y * LAND_WIDTH + x]:= lfObjMask
             else
-                Land[y, x]:= lfBasic
+                Land[y * LAND_WIDTH + x]:= lfBasic
         end;
     end;
 
     if param1 = 0 then
         begin
         for x:= 0 to width do
-            if Land[height - 1, x] = lfObjMask then FillLand(x, height - 1, 0, lfBasic);
+            if Land[(height - 1) * LAND_WIDTH + x] = lfObjMask then FillLand(x, height - 1, 0, lfBasic);
 
         // strip all lfObjMask pixels
         for y:= minY to LAND_HEIGHT - 1 do
             for x:= 0 to LAND_WIDTH - 1 do
-                if Land[y, x] = lfObjMask then
-                    Land[y, x]:= 0;
+                if Land[y * LAND_WIDTH + x] = lfObjMask then
+                    Land[y * LAND_WIDTH + x]:= 0;
         end;
 
     leftX:= 0;
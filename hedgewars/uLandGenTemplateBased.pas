@@ -342,7 +342,7 @@ begin
     ResizeLand(Template.TemplateWidth, Template.TemplateHeight);
     for y:= 0 to LAND_HEIGHT - 1 do
         for x:= 0 to LAND_WIDTH - 1 do
-            Land[y, x]:= lfBasic;
+            Land[y * LAND_WIDTH + x]:= lfBasic;
 
     minDistance:= sqr(cFeatureSize) div 8 + 10;
     //dabDiv:= getRandom(41)+60;
@@ -380,13 +380,13 @@ begin
         for y:= 0 to LAND_HEIGHT - 1 do
             for x:= 0 to LAND_WIDTH - 1 do
                 if (y < topY) or (x < leftX) or (x > rightX) then
-                    Land[y, x]:= 0
+                    Land[y * LAND_WIDTH + x]:= 0
                 else
                     begin
-                    if Land[y, x] = 0 then
-                        Land[y, x]:= lfBasic
-                    else if Land[y, x] = lfBasic then
-                        Land[y, x]:= 0;
+                    if Land[y * LAND_WIDTH + x] = 0 then
+                        Land[y * LAND_WIDTH + x]:= lfBasic
+                    else if Land[y * LAND_WIDTH + x] = lfBasic then
+                        Land[y * LAND_WIDTH + x]:= 0;
                     end;
         end;
 end;
@@ -33,6 +33,7 @@ TLandCircleProcedure = procedure (landX, landY, pixelX, pixelY: Longint);
 
 function  addBgColor(OldColor, NewColor: LongWord): LongWord;
 function  SweepDirty: boolean;
+procedure SmoothDirtyLand;
 function  Despeckle(X, Y: LongInt): Boolean;
 procedure Smooth(X, Y: LongInt);
 function  CheckLandValue(X, Y: LongInt; LandFlag: Word): boolean;
@@ -55,9 +56,18 @@ procedure EraseLand(cpX, cpY: LongInt; Obj: TSprite; Frame: LongInt; LandFlags:
 function GetPlaceCollisionTex(cpX, cpY: LongInt; Obj: TSprite; Frame: LongInt): PTexture;
 
 implementation
-uses SDLh, uLandTexture, uTextures, uVariables, uUtils, uDebug, uScript;
+uses SDLh, uLandTexture, uTextures, uVariables, uUtils, uDebug, uScript, uLandUtils;
 
 
+// reports Land set to Value somewhere inside of the rectangle to the tile summary
+procedure UpdateLandTiles(x1, y1, x2, y2: LongInt; Value: Longword); inline;
+begin
+if Value = 0 then
+    LandTilesCleared(x1, y1, x2, y2)
+else
+    LandTilesAdded(x1, y1, x2, y2)
+end;
+
 procedure calculatePixelsCoordinates(landX, landY: Longint; var pixelX, pixelY: Longint); inline;
 begin
 if (cReducedQuality and rqBlurryLand) = 0 then
@@ -72,29 +82,86 @@ else
     end;
 end;
 
-function drawPixelBG(landX, landY, pixelX, pixelY: Longint): Longword; inline;
+// Span kernels for the circle fills below: each one handles the pixels
+// fromX..toX of row y (clipped to Land by the caller) with the row offsets
+// into Land and LandPixels worked out once per span instead of per pixel.
+
+// the LandPixels row and column shift matching row y of Land
+procedure landPixelsRow(y: LongInt; var pixelRow, pixelShift: LongInt); inline;
 begin
-drawPixelBG := 0;
-if (Land[LandY, landX] and lfIndestructible) = 0 then
+if (cReducedQuality and rqBlurryLand) = 0 then
     begin
-        if ((Land[landY, landX] and lfBasic) <> 0) and (((LandPixels[pixelY, pixelX] and AMask) shr AShift) = 255) and (not disableLandBack) then
+    pixelRow:= y * LAND_PIXELS_WIDTH;
+    pixelShift:= 0
+    end
+else
+    begin
+    pixelRow:= (y div 2) * LAND_PIXELS_WIDTH;
+    pixelShift:= 1
+    end
+end;
+
+function drawSpanBG(y, fromX, toX: LongInt): Longword;
+var i, landRow, pixelRow, pixelShift, p: LongInt;
+    lw: Word;
+begin
+drawSpanBG:= 0;
+landRow:= y * LAND_WIDTH;
+landPixelsRow(y, pixelRow, pixelShift);
+for i:= fromX to toX do
+    begin
+    lw:= Land[landRow + i];
+    if (lw and lfIndestructible) = 0 then
         begin
-            LandPixels[pixelY, pixelX]:= LandBackPixel(landX, landY);
-            inc(drawPixelBG);
+        p:= pixelRow + (i shr pixelShift);
+        if ((lw and lfBasic) <> 0) and (((LandPixels[p] and AMask) shr AShift) = 255) and (not disableLandBack) then
+            begin
+            LandPixels[p]:= LandBackPixel(i, y);
+            inc(drawSpanBG);
+            end
+        else if ((lw and lfObject) <> 0) or (((LandPixels[p] and AMask) shr AShift) < 255) then
+            LandPixels[p]:= ExplosionBorderColorNoA
         end
-        else if ((Land[landY, landX] and lfObject) <> 0) or (((LandPixels[pixelY, pixelX] and AMask) shr AShift) < 255) then
-            LandPixels[pixelY, pixelX]:= ExplosionBorderColorNoA
-    end;
+    end
 end;
 
-procedure drawPixelEBC(landX, landY, pixelX, pixelY: Longint); inline;
+procedure drawSpanEBC(y, fromX, toX: LongInt);
+var i, landRow, pixelRow, pixelShift: LongInt;
 begin
-if ((Land[landY, landX] and lfBasic) <> 0) or ((Land[landY, landX] and lfObject) <> 0) then
-    begin
-    LandPixels[pixelY, pixelX]:= ExplosionBorderColor;
-    Land[landY, landX]:= (Land[landY, landX] or lfDamaged) and (not lfIce);
-    LandDirty[landY div 32, landX div 32]:= 1;
-    end;
+landRow:= y * LAND_WIDTH;
+landPixelsRow(y, pixelRow, pixelShift);
+for i:= fromX to toX do
+    if (Land[landRow + i] and (lfBasic or lfObject)) <> 0 then
+        begin
+        LandPixels[pixelRow + (i shr pixelShift)]:= ExplosionBorderColor;
+        Land[landRow + i]:= (Land[landRow + i] or lfDamaged) and (not lfIce);
+        MarkLandDirty(i, y);
+        end
+end;
+
+procedure drawSpanNull(y, fromX, toX: LongInt);
+var i, landRow, pixelRow, pixelShift: LongInt;
+begin
+landRow:= y * LAND_WIDTH;
+landPixelsRow(y, pixelRow, pixelShift);
+for i:= fromX to toX do
+    if ((Land[landRow + i] and lfIndestructible) = 0) and (not disableLandBack or (Land[landRow + i] > 255)) then
+        LandPixels[pixelRow + (i shr pixelShift)]:= ExplosionBorderColorNoA
+end;
+
+// sets fromX..toX of row y to Value, except for indestructible pixels,
+// returns the number of pixels that changed
+function fillLandSpan(y, fromX, toX: LongInt; Value: Longword): Longword;
+var i, landRow: LongInt;
+begin
+fillLandSpan:= 0;
+landRow:= y * LAND_WIDTH;
+for i:= fromX to toX do
+    if (Land[landRow + i] and lfIndestructible) = 0 then
+        begin
+        if Land[landRow + i] <> Value then inc(fillLandSpan);
+        Land[landRow + i]:= Value
+        end
 end;
 
 function isLandscapeEdge(weight:Longint):boolean; inline;
@@ -116,7 +183,7 @@ for i := x - 1 to x + 1 do
        (j > LAND_HEIGHT -1) then
        exit(9);
 
-    if Land[j, i] and lfLandMask and (not lfIce) = 0 then
+    if Land[j * LAND_WIDTH + i] and lfLandMask and (not lfIce) = 0 then
        inc(r)
     end;
 
@@ -134,7 +201,7 @@ begin
     // So. 3 parameters here. Ice colour, Ice opacity, and a bias on the greyscaled pixel towards lightness
     iceSurface:= SpritesData[sprIceTexture].Surface;
     icePixels := iceSurface^.pixels;
-    w:= LandPixels[pixelY, pixelX];
+    w:= LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX];
     if w > 0 then
         begin
         w:= round(((w shr RShift and $FF) * RGB_LUMINANCE_RED +
@@ -142,66 +209,54 @@ begin
               (w shr GShift and $FF) * RGB_LUMINANCE_BLUE));
         if w < 128 then w:= w+128;
         if w > 255 then w:= 255;
-        w:= (w shl RShift) or (w shl BShift) or (w shl GShift) or (LandPixels[pixelY, pixelX] and AMask);
-        LandPixels[pixelY, pixelX]:= addBgColor(w, IceColor);
-        LandPixels[pixelY, pixelX]:= addBgColor(LandPixels[pixelY, pixelX], icePixels^[iceSurface^.w * (pixelY mod iceSurface^.h) + (pixelX mod iceSurface^.w)])
+        w:= (w shl RShift) or (w shl BShift) or (w shl GShift) or (LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX] and AMask);
+        LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX]:= addBgColor(w, IceColor);
+        LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX]:= addBgColor(LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX], icePixels^[iceSurface^.w * (pixelY mod iceSurface^.h) + (pixelX mod iceSurface^.w)])
         end
     else
         begin
-        LandPixels[pixelY, pixelX]:= IceColor and (not AMask) or $E8 shl AShift;
-        LandPixels[pixelY, pixelX]:= addBgColor(LandPixels[pixelY, pixelX], icePixels^[iceSurface^.w * (pixelY mod iceSurface^.h) + (pixelX mod iceSurface^.w)]);
+        LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX]:= IceColor and (not AMask) or $E8 shl AShift;
+        LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX]:= addBgColor(LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX], icePixels^[iceSurface^.w * (pixelY mod iceSurface^.h) + (pixelX mod iceSurface^.w)]);
         // silly workaround to avoid having to make background erasure a tadb it smarter about sea ice
-        if LandPixels[pixelY, pixelX] and AMask shr AShift = 255 then
-            LandPixels[pixelY, pixelX]:= LandPixels[pixelY, pixelX] and (not AMask) or 254 shl AShift;
+        if LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX] and AMask shr AShift = 255 then
+            LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX]:= LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX] and (not AMask) or 254 shl AShift;
         end;
 end;
 
 
 procedure DrawPixelIce(landX, landY, pixelX, pixelY: Longint); inline;
 begin
-if ((Land[landY, landX] and lfIce) <> 0) then exit;
+if ((Land[landY * LAND_WIDTH + landX] and lfIce) <> 0) then exit;
 if isLandscapeEdge(getPixelWeight(landX, landY)) then
     begin
-    if (LandPixels[pixelY, pixelX] and AMask < 255) and (LandPixels[pixelY, pixelX] and AMask > 0) then
-        LandPixels[pixelY, pixelX] := (IceEdgeColor and (not AMask)) or (LandPixels[pixelY, pixelX] and AMask)
-    else if (LandPixels[pixelY, pixelX] and AMask < 255) or (Land[landY, landX] > 255) then
-        LandPixels[pixelY, pixelX] := IceEdgeColor
+    if (LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX] and AMask < 255) and (LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX] and AMask > 0) then
+        LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX] := (IceEdgeColor and (not AMask)) or (LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX] and AMask)
+    else if (LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX] and AMask < 255) or (Land[landY * LAND_WIDTH + landX] > 255) then
+        LandPixels[pixelY * LAND_PIXELS_WIDTH + pixelX] := IceEdgeColor
     end
-else if Land[landY, landX] > 255 then
+else if Land[landY * LAND_WIDTH + landX] > 255 then
     begin
         fillPixelFromIceSprite(pixelX, pixelY);
     end;
-if Land[landY, landX] > 255 then Land[landY, landX] := Land[landY, landX] or lfIce and (not lfDamaged);
+if Land[landY * LAND_WIDTH + landX] > 255 then Land[landY * LAND_WIDTH + landX] := Land[landY * LAND_WIDTH + landX] or lfIce and (not lfDamaged);
 end;
 
 
 function FillLandCircleLineFT(y, fromPix, toPix: LongInt; fill : fillType): Longword;
-var px, py, i: LongInt;
+var px, py, i, landRow: LongInt;
 begin
 //get rid of compiler warning
     px := 0;
     py := 0;
     FillLandCircleLineFT := 0;
+    landRow:= y * LAND_WIDTH;
     case fill of
     backgroundPixel:
-        for i:= fromPix to toPix do
-            begin
-            calculatePixelsCoordinates(i, y, px, py);
-            inc(FillLandCircleLineFT, drawPixelBG(i, y, px, py));
-            end;
+        FillLandCircleLineFT:= drawSpanBG(y, fromPix, toPix);
     ebcPixel:
-        for i:= fromPix to toPix do
-            begin
-            calculatePixelsCoordinates(i, y, px, py);
-            drawPixelEBC(i, y, px, py);
-            end;
+        drawSpanEBC(y, fromPix, toPix);
     nullPixel:
-        for i:= fromPix to toPix do
-            begin
-            calculatePixelsCoordinates(i, y, px, py);
-            if ((Land[y, i] and lfIndestructible) = 0) and (not disableLandBack or (Land[y, i] > 255))  then
-                LandPixels[py, px]:= ExplosionBorderColorNoA;
-            end;
+        drawSpanNull(y, fromPix, toPix);
     icePixel:
         for i:= fromPix to toPix do
             begin
@@ -209,27 +264,19 @@ begin
             DrawPixelIce(i, y, px, py);
             end;
     setNotCurrentMask:
-        for i:= fromPix to toPix do
-            begin
-            Land[y, i]:= Land[y, i] and lfNotCurrentMask;
-            end;
+        for i:= landRow + fromPix to landRow + toPix do
+            Land[i]:= Land[i] and lfNotCurrentMask;
     changePixelSetNotCurrent:
-        for i:= fromPix to toPix do
-            begin
-            if Land[y, i] and lfObjMask > 0 then
-                Land[y, i]:= Land[y, i] - 1;
-            end;
+        for i:= landRow + fromPix to landRow + toPix do
+            if Land[i] and lfObjMask > 0 then
+                Land[i]:= Land[i] - 1;
     setCurrentHog:
-        for i:= fromPix to toPix do
-            begin
-            Land[y, i]:= Land[y, i] or lfCurrentHog
-            end;
+        for i:= landRow + fromPix to landRow + toPix do
+            Land[i]:= Land[i] or lfCurrentHog;
     changePixelNotSetNotCurrent:
-        for i:= fromPix to toPix do
-            begin
-            if Land[y, i] and lfObjMask < lfObjMask then
-                Land[y, i]:= Land[y, i] + 1
-            end;
+        for i:= landRow + fromPix to landRow + toPix do
+            if Land[i] and lfObjMask < lfObjMask then
+                Land[i]:= Land[i] + 1;
     end;
 end;
 
@@ -302,38 +349,17 @@ begin
 end;
 
 function FillCircleLines(x, y, dx, dy: LongInt; Value: Longword): Longword;
-var i: LongInt;
 begin
     FillCircleLines:= 0;
 
     if ((y + dy) and LAND_HEIGHT_MASK) = 0 then
-        for i:= Max(x - dx, 0) to Min(x + dx, LAND_WIDTH - 1) do
-            if (Land[y + dy, i] and lfIndestructible) = 0 then
-            begin
-                if Land[y + dy, i] <> Value then inc(FillCircleLines);
-                Land[y + dy, i]:= Value;
-            end;
+        inc(FillCircleLines, fillLandSpan(y + dy, Max(x - dx, 0), Min(x + dx, LAND_WIDTH - 1), Value));
     if ((y - dy) and LAND_HEIGHT_MASK) = 0 then
-        for i:= Max(x - dx, 0) to Min(x + dx, LAND_WIDTH - 1) do
-            if (Land[y - dy, i] and lfIndestructible) = 0 then
-            begin
-                if Land[y - dy, i] <> Value then inc(FillCircleLines);
-                Land[y - dy, i]:= Value;
-            end;
+        inc(FillCircleLines, fillLandSpan(y - dy, Max(x - dx, 0), Min(x + dx, LAND_WIDTH - 1), Value));
     if ((y + dx) and LAND_HEIGHT_MASK) = 0 then
-        for i:= Max(x - dy, 0) to Min(x + dy, LAND_WIDTH - 1) do
-            if (Land[y + dx, i] and lfIndestructible) = 0 then
-            begin
-                if Land[y + dx, i] <> Value then inc(FillCircleLines);
-                Land[y + dx, i]:= Value;
-            end;
+        inc(FillCircleLines, fillLandSpan(y + dx, Max(x - dy, 0), Min(x + dy, LAND_WIDTH - 1), Value));
     if ((y - dx) and LAND_HEIGHT_MASK) = 0 then
-        for i:= Max(x - dy, 0) to Min(x + dy, LAND_WIDTH - 1) do
-            if (Land[y - dx, i] and lfIndestructible) = 0 then
-            begin
-                if Land[y - dx, i] <> Value then inc(FillCircleLines);
-                Land[y - dx, i]:= Value;
-            end;
+        inc(FillCircleLines, fillLandSpan(y - dx, Max(x - dy, 0), Min(x + dy, LAND_WIDTH - 1), Value));
 end;
 
 function FillRoundInLand(X, Y, Radius: LongInt; Value: Longword): Longword;
@@ -357,6 +383,7 @@ while (dx < dy) do
     end;
 if (dx = dy) then
     inc(FillRoundInLand, FillCircleLines(x, y, dx, dy, Value));
+UpdateLandTiles(X - Radius, Y - Radius, X + Radius, Y + Radius, Value)
 end;
 
 procedure ChangeRoundInLand(X, Y, Radius: LongInt; doSet, isCurrent: boolean);
@@ -369,6 +396,11 @@ else if doSet and IsCurrent then
     FillRoundInLandFT(X, Y, Radius, setCurrentHog)
 else if doSet and (not IsCurrent) then
     FillRoundInLandFT(X, Y, Radius, changePixelNotSetNotCurrent);
+
+if doSet then
+    LandTilesAdded(X - Radius, Y - Radius, X + Radius, Y + Radius)
+else
+    LandTilesCleared(X - Radius, Y - Radius, X + Radius, Y + Radius)
 end;
 
 procedure DrawIceBreak(x, y, iceRadius, iceHeight: Longint);
@@ -416,9 +448,9 @@ for i := iceL to iceR do
     begin
     for j := iceT to iceB do
         begin
-        if Land[j, i] = 0 then
+        if Land[j * LAND_WIDTH + i] = 0 then
             begin
-            Land[j, i] := lfIce;
+            Land[j * LAND_WIDTH + i] := lfIce;
             if (cReducedQuality and rqBlurryLand) = 0 then
                 fillPixelFromIceSprite(i, j)
             else
@@ -427,6 +459,8 @@ for i := iceL to iceR do
         end;
     end;
 
+LandTilesAdded(iceL, iceT, iceR, iceB);
+
 landRect.x := iceL;
 landRect.y := iceT;
 landRect.w := iceR - IceL + 1;
@@ -452,29 +486,24 @@ begin
 end;
 
 procedure DrawHLinesExplosions(ar: PRangeArray; Radius: LongInt; y, dY: LongInt; Count: Byte);
-var tx, ty, by, bx,  i: LongInt;
+var tx, ty, p, i, landRow, pixelRow, pixelShift: LongInt;
 begin
 for i:= 0 to Pred(Count) do
     begin
     for ty:= Max(y - Radius, 0) to Min(y + Radius, LAND_HEIGHT) do
+        begin
+        landRow:= ty * LAND_WIDTH;
+        landPixelsRow(ty, pixelRow, pixelShift);
         for tx:= Max(0, ar^[i].Left - Radius) to Min(LAND_WIDTH, ar^[i].Right + Radius) do
-            begin
-            if (Land[ty, tx] and lfIndestructible) = 0 then
+            if (Land[landRow + tx] and lfIndestructible) = 0 then
                 begin
-                if (cReducedQuality and rqBlurryLand) = 0 then
-                    begin
-                    by:= ty; bx:= tx;
-                    end
-                else
-                    begin
-                    by:= ty div 2; bx:= tx div 2;
-                    end;
-                if ((Land[ty, tx] and lfBasic) <> 0) and (((LandPixels[by,bx] and AMask) shr AShift) = 255) and (not disableLandBack) then
-                    LandPixels[by, bx]:= LandBackPixel(tx, ty)
-                else if ((Land[ty, tx] and lfObject) <> 0) or (((LandPixels[by,bx] and AMask) shr AShift) < 255) then
-                    LandPixels[by, bx]:= LandPixels[by, bx] and (not AMASK)
+                p:= pixelRow + (tx shr pixelShift);
+                if ((Land[landRow + tx] and lfBasic) <> 0) and (((LandPixels[p] and AMask) shr AShift) = 255) and (not disableLandBack) then
+                    LandPixels[p]:= LandBackPixel(tx, ty)
+                else if ((Land[landRow + tx] and lfObject) <> 0) or (((LandPixels[p] and AMask) shr AShift) < 255) then
+                    LandPixels[p]:= LandPixels[p] and (not AMASK)
                 end
-            end;
+        end;
     inc(y, dY)
     end;
 
@@ -484,17 +513,7 @@ dec(y, Count * dY);
 for i:= 0 to Pred(Count) do
     begin
     for ty:= Max(y - Radius, 0) to Min(y + Radius, LAND_HEIGHT) do
-        for tx:= Max(0, ar^[i].Left - Radius) to Min(LAND_WIDTH, ar^[i].Right + Radius) do
-            if ((Land[ty, tx] and lfBasic) <> 0) or ((Land[ty, tx] and lfObject) <> 0) then
-                begin
-                 if (cReducedQuality and rqBlurryLand) = 0 then
-                    LandPixels[ty, tx]:= ExplosionBorderColor
-                else
-                    LandPixels[ty div 2, tx div 2]:= ExplosionBorderColor;
-
-                Land[ty, tx]:= (Land[ty, tx] or lfDamaged) and (not lfIce);
-                LandDirty[ty div 32, tx div 32]:= 1;
-                end;
+        drawSpanEBC(ty, Max(0, ar^[i].Left - Radius), Min(LAND_WIDTH, ar^[i].Right + Radius));
     inc(y, dY)
     end;
 
@@ -514,16 +533,16 @@ for t:= 0 to 7 do
     Y:= Y + dY;
     tx:= hwRound(X);
     ty:= hwRound(Y);
-    if ((ty and LAND_HEIGHT_MASK) = 0) and ((tx and LAND_WIDTH_MASK) = 0) and (((Land[ty, tx] and lfBasic) <> 0)
-    or ((Land[ty, tx] and lfObject) <> 0)) then
+    if ((ty and LAND_HEIGHT_MASK) = 0) and ((tx and LAND_WIDTH_MASK) = 0) and (((Land[ty * LAND_WIDTH + tx] and lfBasic) <> 0)
+    or ((Land[ty * LAND_WIDTH + tx] and lfObject) <> 0)) then
         begin
-        Land[ty, tx]:= (Land[ty, tx] or lfDamaged) and (not lfIce);
+        Land[ty * LAND_WIDTH + tx]:= (Land[ty * LAND_WIDTH + tx] or lfDamaged) and (not lfIce);
         if despeckle then
-            LandDirty[ty div 32, tx div 32]:= 1;
+            MarkLandDirty(tx, ty);
         if (cReducedQuality and rqBlurryLand) = 0 then
-            LandPixels[ty, tx]:= ExplosionBorderColor
+            LandPixels[ty * LAND_PIXELS_WIDTH + tx]:= ExplosionBorderColor
         else
-            LandPixels[ty div 2, tx div 2]:= ExplosionBorderColor
+            LandPixels[(ty div 2) * LAND_PIXELS_WIDTH + (tx div 2)]:= ExplosionBorderColor
         end
     end;
 end;
@@ -562,18 +581,18 @@ for i:= 0 to 7 do
     ty:= hwRound(Y);
     if ((ty and LAND_HEIGHT_MASK) = 0)
     and ((tx and LAND_WIDTH_MASK) = 0)
-    and (((Land[ty, tx] and lfBasic) <> 0) or ((Land[ty, tx] and lfObject) <> 0)) then
+    and (((Land[ty * LAND_WIDTH + tx] and lfBasic) <> 0) or ((Land[ty * LAND_WIDTH + tx] and lfObject) <> 0)) then
         begin
-        Land[ty, tx]:= Land[ty, tx] and (not lfIce);
+        Land[ty * LAND_WIDTH + tx]:= Land[ty * LAND_WIDTH + tx] and (not lfIce);
         if despeckle then
             begin
-            Land[ty, tx]:= Land[ty, tx] or lfDamaged;
-            LandDirty[ty div 32, tx div 32]:= 1
+            Land[ty * LAND_WIDTH + tx]:= Land[ty * LAND_WIDTH + tx] or lfDamaged;
+            MarkLandDirty(tx, ty)
             end;
         if (cReducedQuality and rqBlurryLand) = 0 then
-            LandPixels[ty, tx]:= ExplosionBorderColor
+            LandPixels[ty * LAND_PIXELS_WIDTH + tx]:= ExplosionBorderColor
         else
-            LandPixels[ty div 2, tx div 2]:= ExplosionBorderColor
+            LandPixels[(ty div 2) * LAND_PIXELS_WIDTH + (tx div 2)]:= ExplosionBorderColor
         end
     end;
     nx:= nx - dY;
@@ -593,7 +612,7 @@ for i:= -HalfWidth to HalfWidth do
         Y:= Y + dY;
         tx:= hwRound(X);
         ty:= hwRound(Y);
-        if ((ty and LAND_HEIGHT_MASK) = 0) and ((tx and LAND_WIDTH_MASK) = 0) and ((Land[ty, tx] and lfIndestructible) = 0) then
+        if ((ty and LAND_HEIGHT_MASK) = 0) and ((tx and LAND_WIDTH_MASK) = 0) and ((Land[ty * LAND_WIDTH + tx] and lfIndestructible) = 0) then
             begin
             if (cReducedQuality and rqBlurryLand) = 0 then
                 begin
@@ -603,11 +622,11 @@ for i:= -HalfWidth to HalfWidth do
                 begin
                 by:= ty div 2; bx:= tx div 2;
                 end;
-            if ((Land[ty, tx] and lfBasic) <> 0) and (((LandPixels[by,bx] and AMask) shr AShift) = 255) and (not disableLandBack) then
-                LandPixels[by, bx]:= LandBackPixel(tx, ty)
-            else if ((Land[ty, tx] and lfObject) <> 0) or (((LandPixels[by,bx] and AMask) shr AShift) < 255) then
-                LandPixels[by, bx]:= LandPixels[by, bx] and (not AMASK);
-            Land[ty, tx]:= 0;
+            if ((Land[ty * LAND_WIDTH + tx] and lfBasic) <> 0) and (((LandPixels[by * LAND_PIXELS_WIDTH + bx] and AMask) shr AShift) = 255) and (not disableLandBack) then
+                LandPixels[by * LAND_PIXELS_WIDTH + bx]:= LandBackPixel(tx, ty)
+            else if ((Land[ty * LAND_WIDTH + tx] and lfObject) <> 0) or (((LandPixels[by * LAND_PIXELS_WIDTH + bx] and AMask) shr AShift) < 255) then
+                LandPixels[by * LAND_PIXELS_WIDTH + bx]:= LandPixels[by * LAND_PIXELS_WIDTH + bx] and (not AMASK);
+            Land[ty * LAND_WIDTH + tx]:= 0;
             end
         end;
     DrawExplosionBorder(X, Y, dx, dy, despeckle);
@@ -625,16 +644,16 @@ for i:= 0 to 7 do
     Y:= Y + dY;
     tx:= hwRound(X);
     ty:= hwRound(Y);
-    if ((ty and LAND_HEIGHT_MASK) = 0) and ((tx and LAND_WIDTH_MASK) = 0) and (((Land[ty, tx] and lfBasic) <> 0)
-    or ((Land[ty, tx] and lfObject) <> 0)) then
+    if ((ty and LAND_HEIGHT_MASK) = 0) and ((tx and LAND_WIDTH_MASK) = 0) and (((Land[ty * LAND_WIDTH + tx] and lfBasic) <> 0)
+    or ((Land[ty * LAND_WIDTH + tx] and lfObject) <> 0)) then
         begin
-        Land[ty, tx]:= (Land[ty, tx] or lfDamaged) and (not lfIce);
+        Land[ty * LAND_WIDTH + tx]:= (Land[ty * LAND_WIDTH + tx] or lfDamaged) and (not lfIce);
         if despeckle then
-            LandDirty[ty div 32, tx div 32]:= 1;
+            MarkLandDirty(tx, ty);
         if (cReducedQuality and rqBlurryLand) = 0 then
-            LandPixels[ty, tx]:= ExplosionBorderColor
+            LandPixels[ty * LAND_PIXELS_WIDTH + tx]:= ExplosionBorderColor
         else
-            LandPixels[ty div 2, tx div 2]:= ExplosionBorderColor
+            LandPixels[(ty div 2) * LAND_PIXELS_WIDTH + (tx div 2)]:= ExplosionBorderColor
         end
     end;
     nx:= nx - dY;
@@ -657,6 +676,7 @@ ty:= Max(stY - HalfWidth * 2 - 4 - abs(hwRound(dY * ticks)), 0);
 ddx:= Min(ddx, LAND_WIDTH) - tx;
 ddy:= Min(stY + HalfWidth * 2 + 4 + abs(hwRound(dY * ticks)), LAND_HEIGHT) - ty;
 
+LandTilesCleared(tx, ty, tx + ddx - 1, ty + ddy - 1);
 UpdateLandTexture(tx, ddx, ty, ddy, false)
 end;
 
@@ -698,6 +718,7 @@ var X, Y, bpp, h, w, row, col, gx, gy, numFramesFirstCol: LongInt;
     p: PByteArray;
     Image: PSDL_Surface;
     pixel: LongWord;
+    landFree: boolean;
 begin
 TryPlaceOnLand:= false;
 numFramesFirstCol:= SpritesData[Obj].imageHeight div SpritesData[Obj].Height;
@@ -714,6 +735,9 @@ if flipHoriz then flipSurface(Image, false);
 row:= Frame mod numFramesFirstCol;
 col:= Frame div numFramesFirstCol;
 
+// no need to look at Land pixel by pixel if all of it is air
+landFree:= force or LandRectIsEmpty(cpX, cpY, cpX + w - 1, cpY + h - 1);
+
 if SDL_MustLock(Image) then
     SDLTry(SDL_LockSurface(Image) >= 0, true);
 
@@ -729,12 +753,12 @@ case bpp of
                 if (outOfMap and
                    ((cpY + y) < LAND_HEIGHT) and ((cpY + y) >= 0) and
                    ((cpX + x) < LAND_WIDTH) and ((cpX + x) >= 0) and
-                   ((not force) and (Land[cpY + y, cpX + x] <> 0))) or
+                   ((not landFree) and (Land[(cpY + y) * LAND_WIDTH + (cpX + x)] <> 0))) or
 
                    (not outOfMap and
                        (((cpY + y) <= Longint(topY)) or ((cpY + y) >= LAND_HEIGHT) or
                        ((cpX + x) <= Longint(leftX)) or ((cpX + x) >= Longint(rightX)) or
-                       ((not force) and (Land[cpY + y, cpX + x] <> 0)))) then
+                       ((not landFree) and (Land[(cpY + y) * LAND_WIDTH + (cpX + x)] <> 0)))) then
                    begin
                    if SDL_MustLock(Image) then
                        SDL_UnlockSurface(Image);
@@ -770,22 +794,22 @@ case bpp of
                     gX:= (cpX + x) div 2;
                     gY:= (cpY + y) div 2;
                     end;
-		if not behind or (Land[cpY + y, cpX + x] and lfLandMask = 0) then
+		if not behind or (Land[(cpY + y) * LAND_WIDTH + (cpX + x)] and lfLandMask = 0) then
                     begin
                     if (LandFlags and lfBasic <> 0) or 
-                       (((LandPixels[gY, gX] and AMask) shr AShift = 255) and  // This test assumes lfBasic and lfObject differ only graphically
+                       (((LandPixels[gY * LAND_PIXELS_WIDTH + gX] and AMask) shr AShift = 255) and  // This test assumes lfBasic and lfObject differ only graphically
                          (LandFlags or lfObject = 0)) then
-                         Land[cpY + y, cpX + x]:= lfBasic or LandFlags
-                    else Land[cpY + y, cpX + x]:= lfObject or LandFlags
+                         Land[(cpY + y) * LAND_WIDTH + (cpX + x)]:= lfBasic or LandFlags
+                    else Land[(cpY + y) * LAND_WIDTH + (cpX + x)]:= lfObject or LandFlags
                     end;
-		if not behind or (LandPixels[gY, gX] = 0) then
+		if not behind or (LandPixels[gY * LAND_PIXELS_WIDTH + gX] = 0) then
                     begin
                     if tint = $FFFFFFFF then
-                        LandPixels[gY, gX]:= PLongword(@(p^[x * 4]))^
+                        LandPixels[gY * LAND_PIXELS_WIDTH + gX]:= PLongword(@(p^[x * 4]))^
                     else 
                         begin
                         pixel:= PLongword(@(p^[x * 4]))^;
-                        LandPixels[gY, gX]:= 
+                        LandPixels[gY * LAND_PIXELS_WIDTH + gX]:= 
                            ceil((pixel shr RShift and $FF) * ((tint shr 24) / 255)) shl RShift or
                            ceil((pixel shr GShift and $FF) * ((tint shr 16 and $ff) / 255)) shl GShift or
                            ceil((pixel shr BShift and $FF) * ((tint shr  8 and $ff) / 255)) shl BShift or
@@ -799,6 +823,8 @@ case bpp of
 if SDL_MustLock(Image) then
     SDL_UnlockSurface(Image);
 
+LandTilesAdded(cpX, cpY, cpX + w - 1, cpY + h - 1);
+
 if flipVert then flipSurface(Image, true);
 if flipHoriz then flipSurface(Image, false);
 
@@ -874,15 +900,15 @@ case bpp of
                     gX:= (cpX + x) div 2;
                     gY:= (cpY + y) div 2;
                     end;
-		        if (not eraseOnLFMatch or (Land[cpY + y, cpX + x] and LandFlags <> 0)) and
+		        if (not eraseOnLFMatch or (Land[(cpY + y) * LAND_WIDTH + (cpX + x)] and LandFlags <> 0)) and
                     ((PLongword(@(p^[x * 4]))^) and AMask <> 0) then
                     begin
                     if not onlyEraseLF then
                         begin
-                        LandPixels[gY, gX]:= 0;
-                        Land[cpY + y, cpX + x]:= 0
+                        LandPixels[gY * LAND_PIXELS_WIDTH + gX]:= 0;
+                        Land[(cpY + y) * LAND_WIDTH + (cpX + x)]:= 0
                         end
-                    else Land[cpY + y, cpX + x]:= Land[cpY + y, cpX + x] and (not LandFlags)
+                    else Land[(cpY + y) * LAND_WIDTH + (cpX + x)]:= Land[(cpY + y) * LAND_WIDTH + (cpX + x)] and (not LandFlags)
                     end
                 end;
         p:= PByteArray(@(p^[Image^.pitch]));
@@ -891,6 +917,8 @@ case bpp of
 if SDL_MustLock(Image) then
     SDL_UnlockSurface(Image);
 
+LandTilesCleared(cpX, cpY, cpX + w - 1, cpY + h - 1);
+
 if flipVert then flipSurface(Image, true);
 if flipHoriz then flipSurface(Image, false);
 
@@ -939,7 +967,7 @@ for y:= 0 to Pred(h) do
     for x:= 0 to Pred(w) do
         if ((p^[x] and AMask) <> 0)
             and (((cpY + y) < Longint(topY)) or ((cpY + y) >= LAND_HEIGHT) or
-            ((cpX + x) < Longint(leftX)) or ((cpX + x) > Longint(rightX)) or (Land[cpY + y, cpX + x] <> 0)) then
+            ((cpX + x) < Longint(leftX)) or ((cpX + x) > Longint(rightX)) or (Land[(cpY + y) * LAND_WIDTH + (cpX + x)] <> 0)) then
                 pt^[x]:= cWhiteColor
         else
             (pt^[x]):= cWhiteColor and (not AMask);
@@ -977,8 +1005,9 @@ begin
         yy:= Y div 2;
     end;
 
-    pixelsweep:= (Land[Y, X] <= lfAllObjMask) and ((LandPixels[yy, xx] and AMASK) <> 0);
-    if (((Land[Y, X] and lfDamaged) <> 0) and ((Land[Y, X] and lfIndestructible) = 0)) or pixelsweep then
+    // sweeping stray pixels is only cosmetic, it never touches Land
+    pixelsweep:= (not cOnlyStats) and (Land[Y * LAND_WIDTH + X] <= lfAllObjMask) and ((LandPixels[yy * LAND_PIXELS_WIDTH + xx] and AMASK) <> 0);
+    if (((Land[Y * LAND_WIDTH + X] and lfDamaged) <> 0) and ((Land[Y * LAND_WIDTH + X] and lfIndestructible) = 0)) or pixelsweep then
     begin
         c:= 0;
         for i:= -1 to 1 do
@@ -996,27 +1025,28 @@ begin
                                 ny:= Y div 2 + i;
                                 nx:= X div 2 + j;
                                 if ((ny and (LAND_HEIGHT_MASK div 2)) = 0) and ((nx and (LAND_WIDTH_MASK div 2)) = 0) then
-                                    if (LandPixels[ny, nx] and AMASK) <> 0 then
+                                    if (LandPixels[ny * LAND_PIXELS_WIDTH + nx] and AMASK) <> 0 then
                                         inc(c);
                             end
-                            else if (LandPixels[ny, nx] and AMASK)  <> 0 then
+                            else if (LandPixels[ny * LAND_PIXELS_WIDTH + nx] and AMASK)  <> 0 then
                                     inc(c);
                         end
-                    else if Land[ny, nx] > 255 then
+                    else if Land[ny * LAND_WIDTH + nx] > 255 then
                         inc(c);
                     end
                 end;
 
         if c < 4 then // 0-3 neighbours
         begin
-            if ((Land[Y, X] and lfBasic) <> 0) and (not disableLandBack) then
-                LandPixels[yy, xx]:= LandBackPixel(X, Y)
+            if ((Land[Y * LAND_WIDTH + X] and lfBasic) <> 0) and (not disableLandBack) then
+                LandPixels[yy * LAND_PIXELS_WIDTH + xx]:= LandBackPixel(X, Y)
             else
-                LandPixels[yy, xx]:= LandPixels[yy, xx] and (not AMASK);
+                LandPixels[yy * LAND_PIXELS_WIDTH + xx]:= LandPixels[yy * LAND_PIXELS_WIDTH + xx] and (not AMASK);
 
             if not pixelsweep then
             begin
-                Land[Y, X]:= 0;
+                Land[Y * LAND_WIDTH + X]:= 0;
+                LandTilesCleared(X, Y, X, Y);
                 exit
             end
         end;
@@ -1032,7 +1062,7 @@ var c, r, g, b, a, i: integer;
 begin
 
 // only AA inwards
-if (Land[Y, X] and lfDamaged) = 0 then
+if (Land[Y * LAND_WIDTH + X] and lfDamaged) = 0 then
     exit;
 
 // check location
@@ -1053,9 +1083,9 @@ a:= 0;
 for nx:= X-1 to X+1 do
     for ny:= Y-1 to Y+1 do
         // only consider undamaged neighbors (also leads to skipping itself)
-        if (Land[ny, nx] and lfDamaged) = 0 then
+        if (Land[ny * LAND_WIDTH + nx] and lfDamaged) = 0 then
             begin
-            pixel:= LandPixels[ny, nx];
+            pixel:= LandPixels[ny * LAND_PIXELS_WIDTH + nx];
             inc(r, (pixel and RMask) shr RShift);
             inc(g, (pixel and GMask) shr GShift);
             inc(b, (pixel and BMask) shr BShift);
@@ -1081,28 +1111,28 @@ r:= r div 8;
 g:= g div 8;
 b:= b div 8;
 a:= a div 8;
-LandPixels[y,x]:= (r shl RShift) or (g shl GShift) or (b shl BShift) or (a shl AShift);
+LandPixels[y * LAND_PIXELS_WIDTH + x]:= (r shl RShift) or (g shl GShift) or (b shl BShift) or (a shl AShift);
 
 end;
 
 procedure Smooth_oldImpl(X, Y: LongInt);
 begin
 // a bit of AA for explosions
-if (Land[Y, X] = 0) and (Y > LongInt(topY) + 1) and
+if (Land[Y * LAND_WIDTH + X] = 0) and (Y > LongInt(topY) + 1) and
     (Y < LAND_HEIGHT-2) and (X > LongInt(leftX) + 1) and (X < LongInt(rightX) - 1) then
     begin
-    if ((((Land[y, x-1] and lfDamaged) <> 0) and (((Land[y+1,x] and lfDamaged) <> 0)) or ((Land[y-1,x] and lfDamaged) <> 0))
-    or (((Land[y, x+1] and lfDamaged) <> 0) and (((Land[y-1,x] and lfDamaged) <> 0) or ((Land[y+1,x] and lfDamaged) <> 0)))) then
+    if ((((Land[y * LAND_WIDTH + (x-1)] and lfDamaged) <> 0) and (((Land[(y+1) * LAND_WIDTH + x] and lfDamaged) <> 0)) or ((Land[(y-1) * LAND_WIDTH + x] and lfDamaged) <> 0))
+    or (((Land[y * LAND_WIDTH + (x+1)] and lfDamaged) <> 0) and (((Land[(y-1) * LAND_WIDTH + x] and lfDamaged) <> 0) or ((Land[(y+1) * LAND_WIDTH + x] and lfDamaged) <> 0)))) then
         begin
         if (cReducedQuality and rqBlurryLand) = 0 then
             begin
-            if ((LandPixels[y,x] and AMask) shr AShift) < 10 then
-                LandPixels[y,x]:= (ExplosionBorderColor and (not AMask)) or (128 shl AShift)
+            if ((LandPixels[y * LAND_PIXELS_WIDTH + x] and AMask) shr AShift) < 10 then
+                LandPixels[y * LAND_PIXELS_WIDTH + x]:= (ExplosionBorderColor and (not AMask)) or (128 shl AShift)
             else
-                LandPixels[y,x]:=
-                                (((((LandPixels[y,x] and RMask shr RShift) div 2)+((ExplosionBorderColor and RMask) shr RShift) div 2) and $FF) shl RShift) or
-                                (((((LandPixels[y,x] and GMask shr GShift) div 2)+((ExplosionBorderColor and GMask) shr GShift) div 2) and $FF) shl GShift) or
-                                (((((LandPixels[y,x] and BMask shr BShift) div 2)+((ExplosionBorderColor and BMask) shr BShift) div 2) and $FF) shl BShift) or ($FF shl AShift)
+                LandPixels[y * LAND_PIXELS_WIDTH + x]:=
+                                (((((LandPixels[y * LAND_PIXELS_WIDTH + x] and RMask shr RShift) div 2)+((ExplosionBorderColor and RMask) shr RShift) div 2) and $FF) shl RShift) or
+                                (((((LandPixels[y * LAND_PIXELS_WIDTH + x] and GMask shr GShift) div 2)+((ExplosionBorderColor and GMask) shr GShift) div 2) and $FF) shl GShift) or
+                                (((((LandPixels[y * LAND_PIXELS_WIDTH + x] and BMask shr BShift) div 2)+((ExplosionBorderColor and BMask) shr BShift) div 2) and $FF) shl BShift) or ($FF shl AShift)
             end;
 {
         if (Land[y, x-1] = lfObject) then
@@ -1113,24 +1143,24 @@ if (Land[Y, X] = 0) and (Y > LongInt(topY) + 1) and
             Land[y,x]:= lfBasic;
 }
         end
-    else if ((((Land[y, x-1] and lfDamaged) <> 0) and ((Land[y+1,x-1] and lfDamaged) <> 0) and ((Land[y+2,x] and lfDamaged) <> 0))
-    or (((Land[y, x-1] and lfDamaged) <> 0) and ((Land[y-1,x-1] and lfDamaged) <> 0) and ((Land[y-2,x] and lfDamaged) <> 0))
-    or (((Land[y, x+1] and lfDamaged) <> 0) and ((Land[y+1,x+1] and lfDamaged) <> 0) and ((Land[y+2,x] and lfDamaged) <> 0))
-    or (((Land[y, x+1] and lfDamaged) <> 0) and ((Land[y-1,x+1] and lfDamaged) <> 0) and ((Land[y-2,x] and lfDamaged) <> 0))
-    or (((Land[y+1, x] and lfDamaged) <> 0) and ((Land[y+1,x+1] and lfDamaged) <> 0) and ((Land[y,x+2] and lfDamaged) <> 0))
-    or (((Land[y-1, x] and lfDamaged) <> 0) and ((Land[y-1,x+1] and lfDamaged) <> 0) and ((Land[y,x+2] and lfDamaged) <> 0))
-    or (((Land[y+1, x] and lfDamaged) <> 0) and ((Land[y+1,x-1] and lfDamaged) <> 0) and ((Land[y,x-2] and lfDamaged) <> 0))
-    or (((Land[y-1, x] and lfDamaged) <> 0) and ((Land[y-1,x-1] and lfDamaged) <> 0) and ((Land[y,x-2] and lfDamaged) <> 0))) then
+    else if ((((Land[y * LAND_WIDTH + (x-1)] and lfDamaged) <> 0) and ((Land[(y+1) * LAND_WIDTH + (x-1)] and lfDamaged) <> 0) and ((Land[(y+2) * LAND_WIDTH + x] and lfDamaged) <> 0))
+    or (((Land[y * LAND_WIDTH + (x-1)] and lfDamaged) <> 0) and ((Land[(y-1) * LAND_WIDTH + (x-1)] and lfDamaged) <> 0) and ((Land[(y-2) * LAND_WIDTH + x] and lfDamaged) <> 0))
+    or (((Land[y * LAND_WIDTH + (x+1)] and lfDamaged) <> 0) and ((Land[(y+1) * LAND_WIDTH + (x+1)] and lfDamaged) <> 0) and ((Land[(y+2) * LAND_WIDTH + x] and lfDamaged) <> 0))
+    or (((Land[y * LAND_WIDTH + (x+1)] and lfDamaged) <> 0) and ((Land[(y-1) * LAND_WIDTH + (x+1)] and lfDamaged) <> 0) and ((Land[(y-2) * LAND_WIDTH + x] and lfDamaged) <> 0))
+    or (((Land[(y+1) * LAND_WIDTH + x] and lfDamaged) <> 0) and ((Land[(y+1) * LAND_WIDTH + (x+1)] and lfDamaged) <> 0) and ((Land[y * LAND_WIDTH + (x+2)] and lfDamaged) <> 0))
+    or (((Land[(y-1) * LAND_WIDTH + x] and lfDamaged) <> 0) and ((Land[(y-1) * LAND_WIDTH + (x+1)] and lfDamaged) <> 0) and ((Land[y * LAND_WIDTH + (x+2)] and lfDamaged) <> 0))
+    or (((Land[(y+1) * LAND_WIDTH + x] and lfDamaged) <> 0) and ((Land[(y+1) * LAND_WIDTH + (x-1)] and lfDamaged) <> 0) and ((Land[y * LAND_WIDTH + (x-2)] and lfDamaged) <> 0))
+    or (((Land[(y-1) * LAND_WIDTH + x] and lfDamaged) <> 0) and ((Land[(y-1) * LAND_WIDTH + (x-1)] and lfDamaged) <> 0) and ((Land[y * LAND_WIDTH + (x-2)] and lfDamaged) <> 0))) then
         begin
         if (cReducedQuality and rqBlurryLand) = 0 then
             begin
-            if ((LandPixels[y,x] and AMask) shr AShift) < 10 then
-                LandPixels[y,x]:= (ExplosionBorderColor and (not AMask)) or (64 shl AShift)
+            if ((LandPixels[y * LAND_PIXELS_WIDTH + x] and AMask) shr AShift) < 10 then
+                LandPixels[y * LAND_PIXELS_WIDTH + x]:= (ExplosionBorderColor and (not AMask)) or (64 shl AShift)
             else
-                LandPixels[y,x]:=
-                                (((((LandPixels[y,x] and RMask shr RShift) * 3 div 4)+((ExplosionBorderColor and RMask) shr RShift) div 4) and $FF) shl RShift) or
-                                (((((LandPixels[y,x] and GMask shr GShift) * 3 div 4)+((ExplosionBorderColor and GMask) shr GShift) div 4) and $FF) shl GShift) or
-                                (((((LandPixels[y,x] and BMask shr BShift) * 3 div 4)+((ExplosionBorderColor and BMask) shr BShift) div 4) and $FF) shl BShift) or ($FF shl AShift)
+                LandPixels[y * LAND_PIXELS_WIDTH + x]:=
+                                (((((LandPixels[y * LAND_PIXELS_WIDTH + x] and RMask shr RShift) * 3 div 4)+((ExplosionBorderColor and RMask) shr RShift) div 4) and $FF) shl RShift) or
+                                (((((LandPixels[y * LAND_PIXELS_WIDTH + x] and GMask shr GShift) * 3 div 4)+((ExplosionBorderColor and GMask) shr GShift) div 4) and $FF) shl GShift) or
+                                (((((LandPixels[y * LAND_PIXELS_WIDTH + x] and BMask shr BShift) * 3 div 4)+((ExplosionBorderColor and BMask) shr BShift) div 4) and $FF) shl BShift) or ($FF shl AShift)
             end;
 {
         if (Land[y, x-1] = lfObject) then
@@ -1145,121 +1175,222 @@ if (Land[Y, X] = 0) and (Y > LongInt(topY) + 1) and
 }
         end
     end
-else if ((cReducedQuality and rqBlurryLand) = 0) and ((LandPixels[Y, X] and AMask) = AMask)
-and (Land[Y, X] and (lfDamaged or lfBasic) = lfBasic)
+else if ((cReducedQuality and rqBlurryLand) = 0) and ((LandPixels[Y * LAND_PIXELS_WIDTH + X] and AMask) = AMask)
+and (Land[Y * LAND_WIDTH + X] and (lfDamaged or lfBasic) = lfBasic)
 and (Y > LongInt(topY) + 1) and (Y < LAND_HEIGHT-2) and (X > LongInt(leftX) + 1) and (X < LongInt(rightX) - 1) then
     begin
-    if ((((Land[y, x-1] and lfDamaged) <> 0) and (((Land[y+1,x] and lfDamaged) <> 0)) or ((Land[y-1,x] and lfDamaged) <> 0))
-    or (((Land[y, x+1] and lfDamaged) <> 0) and (((Land[y-1,x] and lfDamaged) <> 0) or ((Land[y+1,x] and lfDamaged) <> 0)))) then
+    if ((((Land[y * LAND_WIDTH + (x-1)] and lfDamaged) <> 0) and (((Land[(y+1) * LAND_WIDTH + x] and lfDamaged) <> 0)) or ((Land[(y-1) * LAND_WIDTH + x] and lfDamaged) <> 0))
+    or (((Land[y * LAND_WIDTH + (x+1)] and lfDamaged) <> 0) and (((Land[(y-1) * LAND_WIDTH + x] and lfDamaged) <> 0) or ((Land[(y+1) * LAND_WIDTH + x] and lfDamaged) <> 0)))) then
         begin
-        LandPixels[y,x]:=
-                        (((((LandPixels[y,x] and RMask shr RShift) div 2)+((ExplosionBorderColor and RMask) shr RShift) div 2) and $FF) shl RShift) or
-                        (((((LandPixels[y,x] and GMask shr GShift) div 2)+((ExplosionBorderColor and GMask) shr GShift) div 2) and $FF) shl GShift) or
-                        (((((LandPixels[y,x] and BMask shr BShift) div 2)+((ExplosionBorderColor and BMask) shr BShift) div 2) and $FF) shl BShift) or ($FF shl AShift)
+        LandPixels[y * LAND_PIXELS_WIDTH + x]:=
+                        (((((LandPixels[y * LAND_PIXELS_WIDTH + x] and RMask shr RShift) div 2)+((ExplosionBorderColor and RMask) shr RShift) div 2) and $FF) shl RShift) or
+                        (((((LandPixels[y * LAND_PIXELS_WIDTH + x] and GMask shr GShift) div 2)+((ExplosionBorderColor and GMask) shr GShift) div 2) and $FF) shl GShift) or
+                        (((((LandPixels[y * LAND_PIXELS_WIDTH + x] and BMask shr BShift) div 2)+((ExplosionBorderColor and BMask) shr BShift) div 2) and $FF) shl BShift) or ($FF shl AShift)
         end
-    else if ((((Land[y, x-1] and lfDamaged) <> 0) and ((Land[y+1,x-1] and lfDamaged) <> 0) and ((Land[y+2,x] and lfDamaged) <> 0))
-    or (((Land[y, x-1] and lfDamaged) <> 0) and ((Land[y-1,x-1] and lfDamaged) <> 0) and ((Land[y-2,x] and lfDamaged) <> 0))
-    or (((Land[y, x+1] and lfDamaged) <> 0) and ((Land[y+1,x+1] and lfDamaged) <> 0) and ((Land[y+2,x] and lfDamaged) <> 0))
-    or (((Land[y, x+1] and lfDamaged) <> 0) and ((Land[y-1,x+1] and lfDamaged) <> 0) and ((Land[y-2,x] and lfDamaged) <> 0))
-    or (((Land[y+1, x] and lfDamaged) <> 0) and ((Land[y+1,x+1] and lfDamaged) <> 0) and ((Land[y,x+2] and lfDamaged) <> 0))
-    or (((Land[y-1, x] and lfDamaged) <> 0) and ((Land[y-1,x+1] and lfDamaged) <> 0) and ((Land[y,x+2] and lfDamaged) <> 0))
-    or (((Land[y+1, x] and lfDamaged) <> 0) and ((Land[y+1,x-1] and lfDamaged) <> 0) and ((Land[y,x-2] and lfDamaged) <> 0))
-    or (((Land[y-1, x] and lfDamaged) <> 0) and ((Land[y-1,x-1] and lfDamaged) <> 0) and ((Land[y,x-2] and lfDamaged) <> 0))) then
+    else if ((((Land[y * LAND_WIDTH + (x-1)] and lfDamaged) <> 0) and ((Land[(y+1) * LAND_WIDTH + (x-1)] and lfDamaged) <> 0) and ((Land[(y+2) * LAND_WIDTH + x] and lfDamaged) <> 0))
+    or (((Land[y * LAND_WIDTH + (x-1)] and lfDamaged) <> 0) and ((Land[(y-1) * LAND_WIDTH + (x-1)] and lfDamaged) <> 0) and ((Land[(y-2) * LAND_WIDTH + x] and lfDamaged) <> 0))
+    or (((Land[y * LAND_WIDTH + (x+1)] and lfDamaged) <> 0) and ((Land[(y+1) * LAND_WIDTH + (x+1)] and lfDamaged) <> 0) and ((Land[(y+2) * LAND_WIDTH + x] and lfDamaged) <> 0))
+    or (((Land[y * LAND_WIDTH + (x+1)] and lfDamaged) <> 0) and ((Land[(y-1) * LAND_WIDTH + (x+1)] and lfDamaged) <> 0) and ((Land[(y-2) * LAND_WIDTH + x] and lfDamaged) <> 0))
+    or (((Land[(y+1) * LAND_WIDTH + x] and lfDamaged) <> 0) and ((Land[(y+1) * LAND_WIDTH + (x+1)] and lfDamaged) <> 0) and ((Land[y * LAND_WIDTH + (x+2)] and lfDamaged) <> 0))
+    or (((Land[(y-1) * LAND_WIDTH + x] and lfDamaged) <> 0) and ((Land[(y-1) * LAND_WIDTH + (x+1)] and lfDamaged) <> 0) and ((Land[y * LAND_WIDTH + (x+2)] and lfDamaged) <> 0))
+    or (((Land[(y+1) * LAND_WIDTH + x] and lfDamaged) <> 0) and ((Land[(y+1) * LAND_WIDTH + (x-1)] and lfDamaged) <> 0) and ((Land[y * LAND_WIDTH + (x-2)] and lfDamaged) <> 0))
+    or (((Land[(y-1) * LAND_WIDTH + x] and lfDamaged) <> 0) and ((Land[(y-1) * LAND_WIDTH + (x-1)] and lfDamaged) <> 0) and ((Land[y * LAND_WIDTH + (x-2)] and lfDamaged) <> 0))) then
         begin
-        LandPixels[y,x]:=
-                        (((((LandPixels[y,x] and RMask shr RShift) * 3 div 4)+((ExplosionBorderColor and RMask) shr RShift) div 4) and $FF) shl RShift) or
-                        (((((LandPixels[y,x] and GMask shr GShift) * 3 div 4)+((ExplosionBorderColor and GMask) shr GShift) div 4) and $FF) shl GShift) or
-                        (((((LandPixels[y,x] and BMask shr BShift) * 3 div 4)+((ExplosionBorderColor and BMask) shr BShift) div 4) and $FF) shl BShift) or ($FF shl AShift)
+        LandPixels[y * LAND_PIXELS_WIDTH + x]:=
+                        (((((LandPixels[y * LAND_PIXELS_WIDTH + x] and RMask shr RShift) * 3 div 4)+((ExplosionBorderColor and RMask) shr RShift) div 4) and $FF) shl RShift) or
+                        (((((LandPixels[y * LAND_PIXELS_WIDTH + x] and GMask shr GShift) * 3 div 4)+((ExplosionBorderColor and GMask) shr GShift) div 4) and $FF) shl GShift) or
+                        (((((LandPixels[y * LAND_PIXELS_WIDTH + x] and BMask shr BShift) * 3 div 4)+((ExplosionBorderColor and BMask) shr BShift) div 4) and $FF) shl BShift) or ($FF shl AShift)
         end
     end
 end;
 
+// puts LandDirtyList into row-major order, the order SweepDirty used to
+// visit the tiles in when it scanned the whole grid
+procedure SortLandDirtyList;
+var i, j, t, x, y: LongInt;
+begin
+if LandDirtyCount > (LAND_HEIGHT div 32) * (LAND_WIDTH div 32) div 16 then
+    begin
+    // that many tiles are collected from the grid faster
+    LandDirtyCount:= 0;
+    for y:= 0 to LAND_HEIGHT div 32 - 1 do
+        for x:= 0 to LAND_WIDTH div 32 - 1 do
+            if (LandDirty[y, x] and ldSweep) <> 0 then
+                begin
+                LandDirtyList[LandDirtyCount]:= y * (LAND_WIDTH div 32) + x;
+                inc(LandDirtyCount)
+                end
+    end
+else
+    for i:= 1 to LandDirtyCount - 1 do
+        begin
+        t:= LandDirtyList[i];
+        j:= i;
+        while (j > 0) and (LandDirtyList[j - 1] > t) do
+            begin
+            LandDirtyList[j]:= LandDirtyList[j - 1];
+            dec(j)
+            end;
+        LandDirtyList[j]:= t
+        end
+end;
+
+// flags tile x, y during a SweepDirty pass, keeping LandDirtyList sorted.
+// current is the position of the tile being swept and moves along if the
+// new tile goes in front of it
+procedure MarkNeighbourDirty(x, y: LongInt; var current: LongInt);
+var i, t, lo, hi, mid: LongInt;
+begin
+if (LandDirty[y, x] and ldSweep) <> 0 then
+    exit;
+LandDirty[y, x]:= LandDirty[y, x] or ldSweep;
+
+t:= y * (LAND_WIDTH div 32) + x;
+lo:= 0;
+hi:= LandDirtyCount;
+while lo < hi do
+    begin
+    mid:= (lo + hi) div 2;
+    if LandDirtyList[mid] < t then
+        lo:= mid + 1
+    else
+        hi:= mid
+    end;
+
+for i:= LandDirtyCount downto lo + 1 do
+    LandDirtyList[i]:= LandDirtyList[i - 1];
+LandDirtyList[lo]:= t;
+inc(LandDirtyCount);
+
+if lo <= current then
+    inc(current)
+end;
+
+procedure SmoothTile(x, y: LongInt);
+var xx, yy: LongInt;
+begin
+for yy:= y * 32 to y * 32 + 31 do
+    for xx:= x * 32 to x * 32 + 31 do
+        Smooth(xx, yy)
+end;
+
 function SweepDirty: boolean;
-var x, y, xx, yy, ty, tx: LongInt;
+var x, y, xx, yy, ty, tx, k: LongInt;
     bRes, resweep, recheck: boolean;
 begin
 bRes:= false;
 reCheck:= true;
 
+// only tiles flagged since the last sweep are visited, in the same order
+// as a scan of the whole grid would
+SortLandDirtyList;
+
 while recheck do
     begin
     recheck:= false;
-    for y:= 0 to LAND_HEIGHT div 32 - 1 do
+    k:= 0;
+    while k < LandDirtyCount do
         begin
-        for x:= 0 to LAND_WIDTH div 32 - 1 do
+        y:= LandDirtyList[k] div (LAND_WIDTH div 32);
+        x:= LandDirtyList[k] mod (LAND_WIDTH div 32);
+        resweep:= true;
+        ty:= y * 32;
+        tx:= x * 32;
+        while(resweep) do
             begin
-            if LandDirty[y, x] = 1 then
-                begin
-                resweep:= true;
-                ty:= y * 32;
-                tx:= x * 32;
-                while(resweep) do
-                    begin
-                    resweep:= false;
-                    for yy:= ty to ty + 31 do
-                        for xx:= tx to tx + 31 do
-                            if Despeckle(xx, yy) then
-                                begin
-                                bRes:= true;
-                                resweep:= true;
-                                if (yy = ty) and (y > 0) then
-                                    begin
-                                    LandDirty[y-1, x]:= 1;
-                                    recheck:= true;
-                                    end
-                                else if (yy = ty+31) and (y < LAND_HEIGHT div 32 - 1) then
-                                    begin
-                                    LandDirty[y+1, x]:= 1;
-                                    recheck:= true;
-                                    end;
-                                if (xx = tx) and (x > 0) then
-                                    begin
-                                    LandDirty[y, x-1]:= 1;
-                                    recheck:= true;
-                                    end
-                                else if (xx = tx+31) and (x < LAND_WIDTH div 32 - 1) then
-                                    begin
-                                    LandDirty[y, x+1]:= 1;
-                                    recheck:= true;
-                                    end
-                                end;
-                    end;
-                end;
+            resweep:= false;
+            for yy:= ty to ty + 31 do
+                for xx:= tx to tx + 31 do
+                    if Despeckle(xx, yy) then
+                        begin
+                        bRes:= true;
+                        resweep:= true;
+                        if (yy = ty) and (y > 0) then
+                            begin
+                            MarkNeighbourDirty(x, y-1, k);
+                            recheck:= true;
+                            end
+                        else if (yy = ty+31) and (y < LAND_HEIGHT div 32 - 1) then
+                            begin
+                            MarkNeighbourDirty(x, y+1, k);
+                            recheck:= true;
+                            end;
+                        if (xx = tx) and (x > 0) then
+                            begin
+                            MarkNeighbourDirty(x-1, y, k);
+                            recheck:= true;
+                            end
+                        else if (xx = tx+31) and (x < LAND_WIDTH div 32 - 1) then
+                            begin
+                            MarkNeighbourDirty(x+1, y, k);
+                            recheck:= true;
+                            end
+                        end;
             end;
+        inc(k)
         end;
-     end;
-
-// smooth explosion borders (except if land is blurry)
-if (cReducedQuality and rqBlurryLand) = 0 then
-    for y:= 0 to LAND_HEIGHT div 32 - 1 do
-        for x:= 0 to LAND_WIDTH div 32 - 1 do
-            if LandDirty[y, x] <> 0 then
-                begin
-                ty:= y * 32;
-                tx:= x * 32;
-                for yy:= ty to ty + 31 do
-                    for xx:= tx to tx + 31 do
-                        Smooth(xx,yy)
-                end;
+    end;
 
-for y:= 0 to LAND_HEIGHT div 32 - 1 do
-    for x:= 0 to LAND_WIDTH div 32 - 1 do
-        if LandDirty[y, x] <> 0 then
-            begin
-            LandDirty[y, x]:= 0;
-            ty:= y * 32;
-            tx:= x * 32;
-            UpdateLandTexture(tx, 32, ty, 32, false);
-            end;
+for k:= 0 to LandDirtyCount - 1 do
+    begin
+    y:= LandDirtyList[k] div (LAND_WIDTH div 32);
+    x:= LandDirtyList[k] mod (LAND_WIDTH div 32);
+    LandDirty[y, x]:= LandDirty[y, x] and (not ldSweep);
+
+    // the rest is purely cosmetic
+    if cOnlyStats then
+        continue;
+
+    // smooth explosion borders (except if land is blurry), with a time
+    // budget set the smoothing is left to SmoothDirtyLand
+    if (cReducedQuality and rqBlurryLand) <> 0 then
+        UpdateLandTexture(x * 32, 32, y * 32, 32, false)
+    else if cLandSmoothBudget = 0 then
+        begin
+        SmoothTile(x, y);
+        UpdateLandTexture(x * 32, 32, y * 32, 32, false)
+        end
+    else if (LandDirty[y, x] and ldSmooth) = 0 then
+        begin
+        LandDirty[y, x]:= LandDirty[y, x] or ldSmooth;
+        LandSmoothList[LandSmoothCount]:= LandDirtyList[k];
+        inc(LandSmoothCount)
+        end
+    end;
+LandDirtyCount:= 0;
 
 SweepDirty:= bRes;
 end;
 
+procedure SmoothDirtyLand;
+var x, y, k: LongInt;
+    startTicks: LongWord;
+begin
+if LandSmoothCount = 0 then
+    exit;
+
+startTicks:= SDL_GetTicks();
+k:= 0;
+repeat
+    y:= LandSmoothList[k] div (LAND_WIDTH div 32);
+    x:= LandSmoothList[k] mod (LAND_WIDTH div 32);
+    LandDirty[y, x]:= LandDirty[y, x] and (not ldSmooth);
+    SmoothTile(x, y);
+    UpdateLandTexture(x * 32, 32, y * 32, 32, false);
+    inc(k)
+until (k = LandSmoothCount) or (SDL_GetTicks() - startTicks >= cLandSmoothBudget);
+
+// keep the rest for the next frame
+for x:= k to LandSmoothCount - 1 do
+    LandSmoothList[x - k]:= LandSmoothList[x];
+dec(LandSmoothCount, k)
+end;
+
 
 // Return true if outside of land or not the value tested, used right now for some X/Y movement that does not use normal hedgehog movement in GSHandlers.inc
 function CheckLandValue(X, Y: LongInt; LandFlag: Word): boolean; inline;
 begin
-    CheckLandValue:= ((X and LAND_WIDTH_MASK <> 0) or (Y and LAND_HEIGHT_MASK <> 0)) or ((Land[Y, X] and LandFlag) = 0)
+    CheckLandValue:= ((X and LAND_WIDTH_MASK <> 0) or (Y and LAND_HEIGHT_MASK <> 0)) or ((Land[Y * LAND_WIDTH + X] and LandFlag) = 0)
 end;
 
 function LandBackPixel(x, y: LongInt): LongWord; inline;
@@ -1331,30 +1462,32 @@ for i:= 0 to d do
         end;
 
     if ((x and LAND_WIDTH_MASK) = 0) and ((y and LAND_HEIGHT_MASK) = 0) then
-        Land[y, x]:= Color;
-    end
+        Land[y * LAND_WIDTH + x]:= Color;
+    end;
+
+UpdateLandTiles(Min(X1, X2), Min(Y1, Y2), Max(X1, X2), Max(Y1, Y2), Color)
 end;
 
 function DrawDots(x, y, xx, yy: Longint; Color: Longword): Longword; inline;
 begin
     DrawDots:= 0;
 
-    if (((x + xx) and LAND_WIDTH_MASK) = 0) and (((y + yy) and LAND_HEIGHT_MASK) = 0) and (Land[y + yy, x + xx] <> Color) then
-        begin inc(DrawDots); Land[y + yy, x + xx]:= Color; end;
-    if (((x + xx) and LAND_WIDTH_MASK) = 0) and (((y - yy) and LAND_HEIGHT_MASK) = 0) and (Land[y - yy, x + xx] <> Color) then
-        begin inc(DrawDots); Land[y - yy, x + xx]:= Color; end;
-    if (((x - xx) and LAND_WIDTH_MASK) = 0) and (((y + yy) and LAND_HEIGHT_MASK) = 0) and (Land[y + yy, x - xx] <> Color) then
-        begin inc(DrawDots); Land[y + yy, x - xx]:= Color; end;
-    if (((x - xx) and LAND_WIDTH_MASK) = 0) and (((y - yy) and LAND_HEIGHT_MASK) = 0) and (Land[y - yy, x - xx] <> Color) then
-        begin inc(DrawDots); Land[y - yy, x - xx]:= Color; end;
-    if (((x + yy) and LAND_WIDTH_MASK) = 0) and (((y + xx) and LAND_HEIGHT_MASK) = 0) and (Land[y + xx, x + yy] <> Color) then
-        begin inc(DrawDots); Land[y + xx, x + yy]:= Color; end;
-    if (((x + yy) and LAND_WIDTH_MASK) = 0) and (((y - xx) and LAND_HEIGHT_MASK) = 0) and (Land[y - xx, x + yy] <> Color) then
-        begin inc(DrawDots); Land[y - xx, x + yy]:= Color; end;
-    if (((x - yy) and LAND_WIDTH_MASK) = 0) and (((y + xx) and LAND_HEIGHT_MASK) = 0) and (Land[y + xx, x - yy] <> Color) then
-        begin inc(DrawDots); Land[y + xx, x - yy]:= Color; end;
-    if (((x - yy) and LAND_WIDTH_MASK) = 0) and (((y - xx) and LAND_HEIGHT_MASK) = 0) and (Land[y - xx, x - yy] <> Color) then
-        begin inc(DrawDots); Land[y - xx, x - yy]:= Color; end;
+    if (((x + xx) and LAND_WIDTH_MASK) = 0) and (((y + yy) and LAND_HEIGHT_MASK) = 0) and (Land[(y + yy) * LAND_WIDTH + (x + xx)] <> Color) then
+        begin inc(DrawDots); Land[(y + yy) * LAND_WIDTH + (x + xx)]:= Color; end;
+    if (((x + xx) and LAND_WIDTH_MASK) = 0) and (((y - yy) and LAND_HEIGHT_MASK) = 0) and (Land[(y - yy) * LAND_WIDTH + (x + xx)] <> Color) then
+        begin inc(DrawDots); Land[(y - yy) * LAND_WIDTH + (x + xx)]:= Color; end;
+    if (((x - xx) and LAND_WIDTH_MASK) = 0) and (((y + yy) and LAND_HEIGHT_MASK) = 0) and (Land[(y + yy) * LAND_WIDTH + (x - xx)] <> Color) then
+        begin inc(DrawDots); Land[(y + yy) * LAND_WIDTH + (x - xx)]:= Color; end;
+    if (((x - xx) and LAND_WIDTH_MASK) = 0) and (((y - yy) and LAND_HEIGHT_MASK) = 0) and (Land[(y - yy) * LAND_WIDTH + (x - xx)] <> Color) then
+        begin inc(DrawDots); Land[(y - yy) * LAND_WIDTH + (x - xx)]:= Color; end;
+    if (((x + yy) and LAND_WIDTH_MASK) = 0) and (((y + xx) and LAND_HEIGHT_MASK) = 0) and (Land[(y + xx) * LAND_WIDTH + (x + yy)] <> Color) then
+        begin inc(DrawDots); Land[(y + xx) * LAND_WIDTH + (x + yy)]:= Color; end;
+    if (((x + yy) and LAND_WIDTH_MASK) = 0) and (((y - xx) and LAND_HEIGHT_MASK) = 0) and (Land[(y - xx) * LAND_WIDTH + (x + yy)] <> Color) then
+        begin inc(DrawDots); Land[(y - xx) * LAND_WIDTH + (x + yy)]:= Color; end;
+    if (((x - yy) and LAND_WIDTH_MASK) = 0) and (((y + xx) and LAND_HEIGHT_MASK) = 0) and (Land[(y + xx) * LAND_WIDTH + (x - yy)] <> Color) then
+        begin inc(DrawDots); Land[(y + xx) * LAND_WIDTH + (x - yy)]:= Color; end;
+    if (((x - yy) and LAND_WIDTH_MASK) = 0) and (((y - xx) and LAND_HEIGHT_MASK) = 0) and (Land[(y - xx) * LAND_WIDTH + (x - yy)] <> Color) then
+        begin inc(DrawDots); Land[(y - xx) * LAND_WIDTH + (x - yy)]:= Color; end;
 end;
 
 function DrawLines(X1, Y1, X2, Y2, XX, YY: LongInt; color: Longword): Longword;
@@ -1446,6 +1579,8 @@ begin
         end;
     if (dx = dy) then
         inc(DrawThickLine, DrawLines(x1, y1, x2, y2, dx, dy, color));
+
+    UpdateLandTiles(Min(X1, X2) - radius, Min(Y1, Y2) - radius, Max(X1, X2) + radius, Max(Y1, Y2) + radius, color)
 end;
 
 
@@ -1461,9 +1596,9 @@ begin
             xx:= dx - r + x;
             if (xx = x) and (yy = y) then
                 s[dx + 1]:= 'X'
-            else if Land[yy, xx] > 255 then
+            else if Land[yy * LAND_WIDTH + xx] > 255 then
                 s[dx + 1]:= 'O'
-            else if Land[yy, xx] > 0 then
+            else if Land[yy * LAND_WIDTH + xx] > 0 then
                 s[dx + 1]:= '*'
             else
                 s[dx + 1]:= '.'
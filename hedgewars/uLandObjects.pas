@@ -34,7 +34,7 @@ procedure SetLand(var LandWord: Word; Pixel: LongWord); inline;
 implementation
 uses uStore, uConsts, uConsole, uRandom, uSound
      , uTypes, uVariables, uUtils, uDebug, SysUtils
-     , uPhysFSLayer;
+     , uPhysFSLayer, uLandUtils;
 
 const MaxRects = 512;
       MAXOBJECTRECTS = 16;
@@ -119,19 +119,20 @@ for y:= 0 to Pred(Image^.h) do
             begin
             if (cReducedQuality and rqBlurryLand) = 0 then
                 begin
-                if (LandPixels[cpY + y, cpX + x] = 0)
-                or (((p^[x] and AMask) <> 0) and (((LandPixels[cpY + y, cpX + x] and AMask) shr AShift) < 255)) then
-                    LandPixels[cpY + y, cpX + x]:= p^[x];
+                if (LandPixels[(cpY + y) * LAND_PIXELS_WIDTH + (cpX + x)] = 0)
+                or (((p^[x] and AMask) <> 0) and (((LandPixels[(cpY + y) * LAND_PIXELS_WIDTH + (cpX + x)] and AMask) shr AShift) < 255)) then
+                    LandPixels[(cpY + y) * LAND_PIXELS_WIDTH + (cpX + x)]:= p^[x];
                 end
             else
-                if LandPixels[(cpY + y) div 2, (cpX + x) div 2] = 0 then
-                    LandPixels[(cpY + y) div 2, (cpX + x) div 2]:= p^[x];
+                if LandPixels[((cpY + y) div 2) * LAND_PIXELS_WIDTH + ((cpX + x) div 2)] = 0 then
+                    LandPixels[((cpY + y) div 2) * LAND_PIXELS_WIDTH + ((cpX + x) div 2)]:= p^[x];
 
-            if (Land[cpY + y, cpX + x] <= lfAllObjMask) and ((p^[x] and AMask) <> 0) then
-                Land[cpY + y, cpX + x]:= lfObject or LandFlags
+            if (Land[(cpY + y) * LAND_WIDTH + (cpX + x)] <= lfAllObjMask) and ((p^[x] and AMask) <> 0) then
+                Land[(cpY + y) * LAND_WIDTH + (cpX + x)]:= lfObject or LandFlags
             end;
     p:= PLongwordArray(@(p^[Image^.pitch shr 2]))
     end;
+LandTilesAdded(cpX, cpY, cpX + Width - 1, cpY + Image^.h - 1);
 
 if SDL_MustLock(Image) then
     SDL_UnlockSurface(Image);
@@ -159,20 +160,21 @@ for y:= 0 to Pred(Image^.h) do
         begin
         if (cReducedQuality and rqBlurryLand) = 0 then
             begin
-            if (LandPixels[cpY + y, cpX + x] = 0)
-            or (((p^[x] and AMask) <> 0) and (((LandPixels[cpY + y, cpX + x] and AMask) shr AShift) < 255)) then
-                LandPixels[cpY + y, cpX + x]:= p^[x];
+            if (LandPixels[(cpY + y) * LAND_PIXELS_WIDTH + (cpX + x)] = 0)
+            or (((p^[x] and AMask) <> 0) and (((LandPixels[(cpY + y) * LAND_PIXELS_WIDTH + (cpX + x)] and AMask) shr AShift) < 255)) then
+                LandPixels[(cpY + y) * LAND_PIXELS_WIDTH + (cpX + x)]:= p^[x];
             end
         else
-            if LandPixels[(cpY + y) div 2, (cpX + x) div 2] = 0 then
-                LandPixels[(cpY + y) div 2, (cpX + x) div 2]:= p^[x];
+            if LandPixels[((cpY + y) div 2) * LAND_PIXELS_WIDTH + ((cpX + x) div 2)] = 0 then
+                LandPixels[((cpY + y) div 2) * LAND_PIXELS_WIDTH + ((cpX + x) div 2)]:= p^[x];
 
-        if (Land[cpY + y, cpX + x] <= lfAllObjMask) or (Land[cpY + y, cpX + x] and lfObject <> 0)  then
-            SetLand(Land[cpY + y, cpX + x], mp^[x]);
+        if (Land[(cpY + y) * LAND_WIDTH + (cpX + x)] <= lfAllObjMask) or (Land[(cpY + y) * LAND_WIDTH + (cpX + x)] and lfObject <> 0)  then
+            SetLand(Land[(cpY + y) * LAND_WIDTH + (cpX + x)], mp^[x]);
         end;
     p:= PLongwordArray(@(p^[Image^.pitch shr 2]));
     mp:= PLongwordArray(@(mp^[Mask^.pitch shr 2]))
     end;
+LandTilesAdded(cpX, cpY, cpX + Image^.w - 1, cpY + Image^.h - 1);
 
 if SDL_MustLock(Image) then
     SDL_UnlockSurface(Image);
@@ -225,7 +227,7 @@ var i: LongInt;
 begin
     lRes:= 0;
     for i:= y to y + 15 do
-        if Land[i, x] <> 0 then
+        if Land[i * LAND_WIDTH + x] <> 0 then
             inc(lRes);
     CountNonZeroz:= lRes;
 end;
@@ -306,8 +308,8 @@ while (tmpx <= bx - rect.w div 2 - 1) and bRes do
     begin
     bRes:= ((rect.y and LAND_HEIGHT_MASK) = 0) and ((by and LAND_HEIGHT_MASK) = 0)
     and ((tmpx and LAND_WIDTH_MASK) = 0) and ((tmpx2 and LAND_WIDTH_MASK) = 0)
-    and (Land[rect.y, tmpx] = Color) and (Land[by, tmpx] = Color)
-    and (Land[rect.y, tmpx2] = Color) and (Land[by, tmpx2] = Color);
+    and (Land[rect.y * LAND_WIDTH + tmpx] = Color) and (Land[by * LAND_WIDTH + tmpx] = Color)
+    and (Land[rect.y * LAND_WIDTH + tmpx2] = Color) and (Land[by * LAND_WIDTH + tmpx2] = Color);
     inc(tmpx);
     dec(tmpx2)
     end;
@@ -317,8 +319,8 @@ while (tmpy <= by - rect.h div 2 - 1) and bRes do
     begin
     bRes:= ((tmpy and LAND_HEIGHT_MASK) = 0) and ((tmpy2 and LAND_HEIGHT_MASK) = 0)
     and ((rect.x and LAND_WIDTH_MASK) = 0) and ((bx and LAND_WIDTH_MASK) = 0)
-    and (Land[tmpy, rect.x] = Color) and (Land[tmpy, bx] = Color)
-    and (Land[tmpy2, rect.x] = Color) and (Land[tmpy2, bx] = Color);
+    and (Land[tmpy * LAND_WIDTH + rect.x] = Color) and (Land[tmpy * LAND_WIDTH + bx] = Color)
+    and (Land[tmpy2 * LAND_WIDTH + rect.x] = Color) and (Land[tmpy2 * LAND_WIDTH + bx] = Color);
     inc(tmpy);
     dec(tmpy2)
     end;
@@ -68,18 +68,18 @@ begin
     while Stack.Count > 0 do
         begin
         Pop(xl, xr, y, dir);
-        while (xl > 0) and (Land[y, xl] <> border) and (Land[y, xl] <> value) do
+        while (xl > 0) and (Land[y * LAND_WIDTH + xl] <> border) and (Land[y * LAND_WIDTH + xl] <> value) do
             dec(xl);
-        while (xr < LAND_WIDTH - 1) and (Land[y, xr] <> border) and (Land[y, xr] <> value) do
+        while (xr < LAND_WIDTH - 1) and (Land[y * LAND_WIDTH + xr] <> border) and (Land[y * LAND_WIDTH + xr] <> value) do
             inc(xr);
         while (xl < xr) do
             begin
-            while (xl <= xr) and ((Land[y, xl] = border) or (Land[y, xl] = value)) do
+            while (xl <= xr) and ((Land[y * LAND_WIDTH + xl] = border) or (Land[y * LAND_WIDTH + xl] = value)) do
                 inc(xl);
             x:= xl;
-            while (xl <= xr) and (Land[y, xl] <> border) and (Land[y, xl] <> value) do
+            while (xl <= xr) and (Land[y * LAND_WIDTH + xl] <> border) and (Land[y * LAND_WIDTH + xl] <> value) do
                 begin
-                Land[y, xl]:= value;
+                Land[y * LAND_WIDTH + xl]:= value;
                 inc(xl)
                 end;
             if x < xl then
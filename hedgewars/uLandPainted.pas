@@ -143,6 +143,8 @@ begin
         pe:= pe^.next;
         dispose(pp);
         end;
+    pointsListHead:= nil;
+    pointsListLast:= nil;
 end;
 
 end.
@@ -50,7 +50,7 @@ function Pixels(x, y: Longword): Pointer;
 var ty: Longword;
 begin
 for ty:= 0 to TEXSIZE - 1 do
-    Move(LandPixels[y * TEXSIZE + ty, x * TEXSIZE], tmpPixels[ty, 0], sizeof(Longword) * TEXSIZE);
+    Move(LandPixels[(y * TEXSIZE + ty) * LAND_PIXELS_WIDTH + (x * TEXSIZE)], tmpPixels[ty, 0], sizeof(Longword) * TEXSIZE);
 
 Pixels:= @tmpPixels
 end;
@@ -60,7 +60,7 @@ var tx, ty: Longword;
 begin
 for ty:= 0 to TEXSIZE - 1 do
     for tx:= 0 to TEXSIZE - 1 do
-        tmpPixels[ty, tx]:= Land[y * TEXSIZE + ty, x * TEXSIZE + tx] or AMask;
+        tmpPixels[ty, tx]:= Land[(y * TEXSIZE + ty) * LAND_WIDTH + (x * TEXSIZE + tx)] or AMask;
 
 Pixels2:= @tmpPixels
 end;
@@ -128,14 +128,14 @@ else
                     // first check edges
                     while isEmpty and (ty < TEXSIZE) do
                         begin
-                        isEmpty:= LandPixels[ly + ty, lx] and AMask = 0;
-                        if isEmpty then isEmpty:= LandPixels[ly + ty, Pred(lx + TEXSIZE)] and AMask = 0;
+                        isEmpty:= LandPixels[(ly + ty) * LAND_PIXELS_WIDTH + lx] and AMask = 0;
+                        if isEmpty then isEmpty:= LandPixels[(ly + ty) * LAND_PIXELS_WIDTH + Pred(lx + TEXSIZE)] and AMask = 0;
                         inc(ty)
                         end;
                     while isEmpty and (tx < TEXSIZE-1) do
                         begin
-                        isEmpty:= LandPixels[ly, lx + tx] and AMask = 0;
-                        if isEmpty then isEmpty:= LandPixels[Pred(ly + TEXSIZE), lx + tx] and AMask = 0;
+                        isEmpty:= LandPixels[ly * LAND_PIXELS_WIDTH + (lx + tx)] and AMask = 0;
+                        if isEmpty then isEmpty:= LandPixels[Pred(ly + TEXSIZE) * LAND_PIXELS_WIDTH + (lx + tx)] and AMask = 0;
                         inc(tx)
                         end;
                     // then search every other remaining. does this sort of stuff defeat compiler opts?
@@ -145,7 +145,7 @@ else
                         tx:= 2;
                         while isEmpty and (tx < TEXSIZE-1) do
                             begin
-                            isEmpty:= LandPixels[ly + ty, lx + tx] and AMask = 0;
+                            isEmpty:= LandPixels[(ly + ty) * LAND_PIXELS_WIDTH + (lx + tx)] and AMask = 0;
                             inc(tx,2)
                             end;
                         inc(ty,2);
@@ -157,7 +157,7 @@ else
                         tx:= 1;
                         while isEmpty and (tx < TEXSIZE-1) do
                             begin
-                            isEmpty:= LandPixels[ly + ty, lx + tx] and AMask = 0;
+                            isEmpty:= LandPixels[(ly + ty) * LAND_PIXELS_WIDTH + (lx + tx)] and AMask = 0;
                             inc(tx,2)
                             end;
                         inc(ty,2);
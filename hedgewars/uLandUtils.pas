@@ -3,10 +3,29 @@ interface
 
 procedure ResizeLand(width, height: LongWord);
 procedure InitWorldEdges();
+procedure MarkLandDirty(x, y: LongInt); inline;
+
+// LandTiles keeps one byte per 32x32 tile of Land telling whether the tile
+// may hold any non-zero pixel, LandTileRows counts such tiles per row of
+// tiles. The summary is only ever too pessimistic: code writing non-zero
+// values to Land after the map is generated has to report the area with
+// LandTilesAdded, areas that were (partially) cleared are reported with
+// LandTilesCleared and get recounted lazily when queried.
+procedure RebuildLandTiles;
+procedure LandTilesAdded(x1, y1, x2, y2: LongInt);
+procedure LandTilesCleared(x1, y1, x2, y2: LongInt);
+function  LandTileIsEmpty(tx, ty: LongInt): boolean;
+function  LandRectIsEmpty(x1, y1, x2, y2: LongInt): boolean;
+function  SkipEmptyLandRows(x1, x2, y, yMax: LongInt): LongInt;
 
 implementation
 uses uUtils, uConsts, uVariables, uTypes;
 
+const cLandTileShift = 5;
+      cLandTileSize = 1 shl cLandTileShift;
+      ltSolid = $01; // tile may contain non-zero Land
+      ltStale = $02; // something got cleared, recount before trusting ltSolid
+
 procedure ResizeLand(width, height: LongWord);
 var potW, potH: LongInt;
 begin
@@ -20,18 +39,50 @@ if (potW <> LAND_WIDTH) or (potH <> LAND_HEIGHT) then
     LAND_HEIGHT_MASK:= not(LAND_HEIGHT-1);
     cWaterLine:= LAND_HEIGHT;
     if (cReducedQuality and rqBlurryLand) = 0 then
-        SetLength(LandPixels, LAND_HEIGHT, LAND_WIDTH)
+        LAND_PIXELS_WIDTH:= LAND_WIDTH
     else
-        SetLength(LandPixels, LAND_HEIGHT div 2, LAND_WIDTH div 2);
+        LAND_PIXELS_WIDTH:= LAND_WIDTH div 2;
 
-    SetLength(Land, LAND_HEIGHT, LAND_WIDTH);
+    // one contiguous block each, reallocated so nothing of the old
+    // layout is left over in the rows
+    SetLength(LandPixels, 0);
+    SetLength(Land, 0);
+    if (cReducedQuality and rqBlurryLand) = 0 then
+        SetLength(LandPixels, LAND_HEIGHT * LAND_WIDTH)
+    else
+        SetLength(LandPixels, (LAND_HEIGHT div 2) * (LAND_WIDTH div 2));
+    SetLength(Land, LAND_HEIGHT * LAND_WIDTH);
     SetLength(LandDirty, (LAND_HEIGHT div 32), (LAND_WIDTH div 32));
+    // every tile is at most once in each of the lists
+    SetLength(LandDirtyList, (LAND_HEIGHT div 32) * (LAND_WIDTH div 32));
+    SetLength(LandSmoothList, (LAND_HEIGHT div 32) * (LAND_WIDTH div 32));
+    LandDirtyCount:= 0;
+    LandSmoothCount:= 0;
+    SetLength(LandTiles, 0);
+    SetLength(LandTiles, (LAND_HEIGHT shr cLandTileShift) * (LAND_WIDTH shr cLandTileShift));
+    SetLength(LandTileRows, 0);
+    SetLength(LandTileRows, LAND_HEIGHT shr cLandTileShift);
+    LandTilesValid:= false;
     // 0.5 is already approaching on unplayable
     if (width div 4096 >= 2) or (height div 2048 >= 2) then cMaxZoomLevel:= 0.5;
     cMinMaxZoomLevelDelta:= cMaxZoomLevel - cMinZoomLevel
     end;
 end;
 
+// flags the tile of Land pixel x, y for the next SweepDirty
+procedure MarkLandDirty(x, y: LongInt); inline;
+var tx, ty: LongInt;
+begin
+tx:= x div 32;
+ty:= y div 32;
+if (LandDirty[ty, tx] and ldSweep) = 0 then
+    begin
+    LandDirty[ty, tx]:= LandDirty[ty, tx] or ldSweep;
+    LandDirtyList[LandDirtyCount]:= ty * (LAND_WIDTH div 32) + tx;
+    inc(LandDirtyCount)
+    end
+end;
+
 procedure InitWorldEdges();
 var cy, cx, lx, ly: LongInt;
     found: boolean;
@@ -56,7 +107,7 @@ found:= false;
 for cx:= 0 to lx do
     begin
     for cy:= ly downto 0 do
-        if Land[cy, cx] <> 0 then
+        if Land[cy * LAND_WIDTH + cx] <> 0 then
             begin
             leftX:= max(0, cx - cWorldEdgeDist);
             // break out of both loops
@@ -71,7 +122,7 @@ found:= false;
 for cx:= lx downto 0 do
     begin
     for cy:= ly downto 0 do
-        if Land[cy, cx] <> 0 then
+        if Land[cy * LAND_WIDTH + cx] <> 0 then
             begin
             rightX:= min(lx, cx + cWorldEdgeDist);
             // break out of both loops
@@ -84,4 +135,164 @@ for cx:= lx downto 0 do
 playWidth := rightX + 1 - leftX;
 end;
 
+procedure RecountLandTile(tx, ty: LongInt);
+var x, y, i, ly: LongInt;
+    isEmpty: boolean;
+begin
+isEmpty:= true;
+ly:= ty shl cLandTileShift;
+y:= ly;
+while isEmpty and (y < ly + cLandTileSize) do
+    begin
+    i:= y * LAND_WIDTH + (tx shl cLandTileShift);
+    for x:= 0 to cLandTileSize - 1 do
+        if Land[i + x] <> 0 then
+            begin
+            isEmpty:= false;
+            break
+            end;
+    inc(y)
+    end;
+
+i:= ty * (LAND_WIDTH shr cLandTileShift) + tx;
+if isEmpty then
+    begin
+    if LandTiles[i] and ltSolid <> 0 then
+        dec(LandTileRows[ty]);
+    LandTiles[i]:= 0
+    end
+else
+    begin
+    if LandTiles[i] and ltSolid = 0 then
+        inc(LandTileRows[ty]);
+    LandTiles[i]:= ltSolid
+    end
+end;
+
+procedure RebuildLandTiles;
+var tx, ty: LongInt;
+begin
+FillChar(LandTiles[0], Length(LandTiles), 0);
+FillChar(LandTileRows[0], Length(LandTileRows) * SizeOf(LongInt), 0);
+for ty:= 0 to Pred(LAND_HEIGHT shr cLandTileShift) do
+    for tx:= 0 to Pred(LAND_WIDTH shr cLandTileShift) do
+        RecountLandTile(tx, ty);
+LandTilesValid:= true
+end;
+
+// clamps the rectangle to Land and converts it to tile coordinates,
+// returns false if nothing of it is inside of Land
+function ClampToTiles(var x1, y1, x2, y2: LongInt): boolean; inline;
+begin
+x1:= max(x1, 0);
+y1:= max(y1, 0);
+x2:= min(x2, LAND_WIDTH - 1);
+y2:= min(y2, LAND_HEIGHT - 1);
+ClampToTiles:= (x1 <= x2) and (y1 <= y2);
+x1:= x1 shr cLandTileShift;
+y1:= y1 shr cLandTileShift;
+x2:= x2 shr cLandTileShift;
+y2:= y2 shr cLandTileShift
+end;
+
+procedure LandTilesAdded(x1, y1, x2, y2: LongInt);
+var tx, ty, i: LongInt;
+begin
+if (not LandTilesValid) or (not ClampToTiles(x1, y1, x2, y2)) then
+    exit;
+
+for ty:= y1 to y2 do
+    begin
+    i:= ty * (LAND_WIDTH shr cLandTileShift);
+    for tx:= x1 to x2 do
+        if LandTiles[i + tx] and ltSolid = 0 then
+            begin
+            // the area is only a bounding box, so let the first query
+            // check whether anything actually landed in this tile
+            LandTiles[i + tx]:= ltSolid or ltStale;
+            inc(LandTileRows[ty])
+            end
+    end
+end;
+
+procedure LandTilesCleared(x1, y1, x2, y2: LongInt);
+var tx, ty, i: LongInt;
+begin
+if (not LandTilesValid) or (not ClampToTiles(x1, y1, x2, y2)) then
+    exit;
+
+for ty:= y1 to y2 do
+    if LandTileRows[ty] <> 0 then
+        begin
+        i:= ty * (LAND_WIDTH shr cLandTileShift);
+        for tx:= x1 to x2 do
+            if LandTiles[i + tx] <> 0 then
+                LandTiles[i + tx]:= ltSolid or ltStale
+        end
+end;
+
+// true if the tile has no non-zero Land for sure
+function LandTileIsEmpty(tx, ty: LongInt): boolean;
+var i: LongInt;
+begin
+if not LandTilesValid then
+    exit(false);
+
+i:= ty * (LAND_WIDTH shr cLandTileShift) + tx;
+if LandTiles[i] and ltStale <> 0 then
+    RecountLandTile(tx, ty);
+LandTileIsEmpty:= LandTiles[i] = 0
+end;
+
+// true if there is no non-zero Land inside of the rectangle for sure,
+// parts outside of Land count as empty
+function LandRectIsEmpty(x1, y1, x2, y2: LongInt): boolean;
+var tx, ty: LongInt;
+begin
+if not LandTilesValid then
+    exit(false);
+if not ClampToTiles(x1, y1, x2, y2) then
+    exit(true);
+
+for ty:= y1 to y2 do
+    if LandTileRows[ty] <> 0 then
+        for tx:= x1 to x2 do
+            if not LandTileIsEmpty(tx, ty) then
+                exit(false);
+
+LandRectIsEmpty:= true
+end;
+
+// returns the first row from y on which might have non-zero Land between
+// x1 and x2, every row in between is empty. The result is capped at yMax.
+function SkipEmptyLandRows(x1, x2, y, yMax: LongInt): LongInt;
+var tx, ty: LongInt;
+    isEmpty: boolean;
+begin
+SkipEmptyLandRows:= y;
+if (not LandTilesValid) or (y < 0) or (y >= yMax) then
+    exit;
+
+x1:= max(x1, 0);
+x2:= min(x2, LAND_WIDTH - 1);
+if x1 > x2 then
+    exit;
+x1:= x1 shr cLandTileShift;
+x2:= x2 shr cLandTileShift;
+
+isEmpty:= true;
+while isEmpty and (y < yMax) and (y < LAND_HEIGHT) do
+    begin
+    ty:= y shr cLandTileShift;
+    if LandTileRows[ty] <> 0 then
+        for tx:= x1 to x2 do
+            if isEmpty and (not LandTileIsEmpty(tx, ty)) then
+                isEmpty:= false;
+    if isEmpty then
+        y:= (ty + 1) shl cLandTileShift
+    end;
+
+SkipEmptyLandRows:= min(y, yMax)
+end;
+
 end.
@@ -256,18 +256,18 @@ if dump > 0 then
     for y:= 0 to LAND_HEIGHT-1 do
         for x:= 0 to LAND_WIDTH-1 do
             if dump = 2 then
-                PLongWordArray(p)^[y*LAND_WIDTH+x]:= LandPixels[LAND_HEIGHT-1-y, x]
+                PLongWordArray(p)^[y*LAND_WIDTH+x]:= LandPixels[(LAND_HEIGHT-1-y) * LAND_PIXELS_WIDTH + x]
             else
                 begin
-                if Land[LAND_HEIGHT-1-y, x] and lfIndestructible = lfIndestructible then
+                if Land[(LAND_HEIGHT-1-y) * LAND_WIDTH + x] and lfIndestructible = lfIndestructible then
                     PLongWordArray(p)^[y*LAND_WIDTH+x]:= (AMask or RMask)
-                else if Land[LAND_HEIGHT-1-y, x] and lfIce = lfIce then
+                else if Land[(LAND_HEIGHT-1-y) * LAND_WIDTH + x] and lfIce = lfIce then
                     PLongWordArray(p)^[y*LAND_WIDTH+x]:= (AMask or BMask)
-                else if Land[LAND_HEIGHT-1-y, x] and lfBouncy = lfBouncy then
+                else if Land[(LAND_HEIGHT-1-y) * LAND_WIDTH + x] and lfBouncy = lfBouncy then
                     PLongWordArray(p)^[y*LAND_WIDTH+x]:= (AMask or GMask)
-                else if Land[LAND_HEIGHT-1-y, x] and lfObject = lfObject then
+                else if Land[(LAND_HEIGHT-1-y) * LAND_WIDTH + x] and lfObject = lfObject then
                     PLongWordArray(p)^[y*LAND_WIDTH+x]:= $FFFFFFFF
-                else if Land[LAND_HEIGHT-1-y, x] and lfBasic = lfBasic then
+                else if Land[(LAND_HEIGHT-1-y) * LAND_WIDTH + x] and lfBasic = lfBasic then
                     PLongWordArray(p)^[y*LAND_WIDTH+x]:= AMask
                 else
                     PLongWordArray(p)^[y*LAND_WIDTH+x]:= 0
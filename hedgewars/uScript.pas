@@ -151,7 +151,10 @@ begin
     WriteLnToConsole(s);
     AddChatString(#5 + s);
     if cTestLua then
+        begin
+        FlushFileLog;
         halt(HaltTestLuaError);
+        end;
 end;
 
 procedure LuaCallError(error, call, paramsyntax: shortstring);
@@ -723,7 +726,6 @@ begin
             t:= lua_tointeger(L, 7);
 
             gear:= AddGear(x, y, gt, s, dx, dy, t);
-            lastGearByUID:= gear;
             lua_pushinteger(L, gear^.uid)
             end
         else
@@ -778,7 +780,6 @@ begin
 
             if vg <> nil then
                 begin
-                lastVisualGearByUID:= vg;
                 uid:= vg^.uid;
                 lua_pushinteger(L, uid);
                 end;
@@ -2526,6 +2527,7 @@ begin
         if cTestLua then
             begin
             WriteLnToConsole('Lua test finished, result: ' + rstring);
+            FlushFileLog;
             halt(lua_tointeger(L, 1));
             end
         else LuaError('Not in lua test mode, engine will keep running. Reported test result: ' + rstring);
@@ -2555,12 +2557,6 @@ begin
     lua_settop(luaState, 0)
 end;
 
-procedure ScriptSetNil(name : shortstring);
-begin
-    lua_pushnil(luaState);
-    lua_setglobal(luaState, Str2PChar(name));
-end;
-
 procedure ScriptSetInteger(name : shortstring; value : LongInt);
 begin
     lua_pushinteger(luaState, value);
@@ -2767,12 +2763,189 @@ else
 hedgewarsMountPackage(Str2PChar(copy(s, 1, length(s)-4)+'.hwp'));
 end;
 
+// Engine hooks and the globals set before each hook call never live in the
+// raw globals table, so every assignment to them passes the metatable of _G.
+// That way the engine knows which hooks a script defines and which of those
+// globals it changed, without looking anything up by name.
+const cScriptHooks: array[0..42] of shortstring = (
+    'onGameInit', 'onGameStart', 'onGameTick', 'onGameTick20',
+    'onNewTurn', 'onPreviewInit', 'onParameters', 'onScreenResize',
+    'onAmmoStoreInit', 'onNewAmmoStore', 'onAchievementsDeclaration', 'onGearAdd',
+    'onGearDelete', 'onGearDamage', 'onGearResurrect', 'onGearStep',
+    'onGearWaterSkip', 'onHogAttack', 'onHogHide', 'onHogRestore',
+    'onSpecialPoint', 'onGirderPlacement', 'onRubberPlacement', 'onSpritePlacement',
+    'onSetWeapon', 'onSlot', 'onSwitch', 'onTaunt',
+    'onTimer', 'onLeft', 'onLeftUp', 'onRight',
+    'onRightUp', 'onUp', 'onUpUp', 'onDown',
+    'onDownUp', 'onAttack', 'onAttackUp', 'onHJump',
+    'onLJump', 'onPrecise', 'onPreciseUp');
+    cHookSlots = 128;
+
+    egTurnTimeLeft    = 0;
+    egGameTime        = 1;
+    egTotalRounds     = 2;
+    egWaterLine       = 3;
+    egCurrentHedgehog = 4;
+    cEngineGlobals: array[0..4] of shortstring = (
+        'TurnTimeLeft', 'GameTime', 'TotalRounds', 'WaterLine', 'CurrentHedgehog');
+
+var HookRefs: array[0..42] of LongInt; // registry refs, LUA_NOREF if not defined
+    HookSlots: array[0..Pred(cHookSlots)] of LongInt;
+    EngineGlobalsRef: LongInt; // table holding the values of cEngineGlobals
+    EngineGlobals: array[0..4] of LongInt; // what the script currently sees
+    EngineGlobalsStale: array[0..4] of boolean; // assigned by the script or never set
+
+function HookHash(const fname: shortstring): LongInt; inline;
+var h: LongInt;
+begin
+h:= Length(fname);
+if h > 2 then
+    h:= h * 31 + ord(fname[3]) * 7 + ord(fname[Length(fname)]);
+HookHash:= h and Pred(cHookSlots)
+end;
+
+function HookIndex(const fname: shortstring): LongInt;
+var h: LongInt;
+begin
+h:= HookHash(fname);
+while HookSlots[h] >= 0 do
+    begin
+    if cScriptHooks[HookSlots[h]] = fname then
+        exit(HookSlots[h]);
+    h:= (h + 1) and Pred(cHookSlots)
+    end;
+HookIndex:= -1
+end;
+
+// upvalue 1 maps names to ids, i + 1 for cScriptHooks[i] and -(i + 1) for
+// cEngineGlobals[i], upvalue 2 is the table with the engine globals
+function lc_globalsindex(L : Plua_State) : LongInt; Cdecl;
+var id: LongInt;
+begin
+    lc_globalsindex:= 1;
+    lua_pushvalue(L, 2);
+    lua_rawget(L, lua_upvalueindex(1));
+    if lua_isnil(L, -1) then
+        exit;
+    id:= lua_tointeger(L, -1);
+    lua_pop(L, 1);
+    if id > 0 then
+        lua_rawgeti(L, LUA_REGISTRYINDEX, HookRefs[id - 1])
+    else
+        lua_rawgeti(L, lua_upvalueindex(2), -id);
+end;
+
+function lc_globalsnewindex(L : Plua_State) : LongInt; Cdecl;
+var id: LongInt;
+begin
+    lc_globalsnewindex:= 0;
+    lua_pushvalue(L, 2);
+    lua_rawget(L, lua_upvalueindex(1));
+    id:= lua_tointeger(L, -1);
+    lua_pop(L, 1);
+    if id = 0 then
+        lua_rawset(L, 1)
+    else if id > 0 then
+        begin
+        luaL_unref(L, LUA_REGISTRYINDEX, HookRefs[id - 1]);
+        if lua_isnil(L, 3) then
+            HookRefs[id - 1]:= LUA_NOREF
+        else
+            HookRefs[id - 1]:= luaL_ref(L, LUA_REGISTRYINDEX)
+        end
+    else
+        begin
+        lua_rawseti(L, lua_upvalueindex(2), -id);
+        EngineGlobalsStale[-id - 1]:= true
+        end
+end;
+
+procedure InitHookRegistry;
+var i, h: LongInt;
+begin
+for i:= 0 to Pred(cHookSlots) do
+    HookSlots[i]:= -1;
+for i:= 0 to High(cScriptHooks) do
+    begin
+    HookRefs[i]:= LUA_NOREF;
+    h:= HookHash(cScriptHooks[i]);
+    while HookSlots[h] >= 0 do
+        h:= (h + 1) and Pred(cHookSlots);
+    HookSlots[h]:= i
+    end;
+for i:= 0 to High(cEngineGlobals) do
+    EngineGlobalsStale[i]:= true;
+
+// metatable for _G
+lua_newtable(luaState);
+
+lua_newtable(luaState);
+for i:= 0 to High(cScriptHooks) do
+    begin
+    lua_pushinteger(luaState, i + 1);
+    lua_setfield(luaState, -2, Str2PChar(cScriptHooks[i]))
+    end;
+for i:= 0 to High(cEngineGlobals) do
+    begin
+    lua_pushinteger(luaState, -(i + 1));
+    lua_setfield(luaState, -2, Str2PChar(cEngineGlobals[i]))
+    end;
+
+lua_newtable(luaState);
+lua_pushvalue(luaState, -1);
+EngineGlobalsRef:= luaL_ref(luaState, LUA_REGISTRYINDEX);
+
+lua_pushvalue(luaState, -2);
+lua_pushvalue(luaState, -2);
+lua_pushcclosure(luaState, @lc_globalsindex, 2);
+lua_setfield(luaState, -4, _P'__index');
+lua_pushcclosure(luaState, @lc_globalsnewindex, 2);
+lua_setfield(luaState, -2, _P'__newindex');
+
+lua_setmetatable(luaState, LUA_GLOBALSINDEX)
+end;
+
+// pushes the function of hook fname, false if the script doesn't define it
+function ScriptPushHook(fname : shortstring) : boolean;
+var h: LongInt;
+begin
+h:= HookIndex(fname);
+if h < 0 then
+    begin
+    if not ScriptExists(fname) then
+        exit(false);
+    lua_getglobal(luaState, Str2PChar(fname))
+    end
+else if HookRefs[h] = LUA_NOREF then
+    exit(false)
+else
+    lua_rawgeti(luaState, LUA_REGISTRYINDEX, HookRefs[h]);
+ScriptPushHook:= true
+end;
+
+procedure SetEngineGlobal(g, value: LongInt);
+begin
+if EngineGlobalsStale[g] or (EngineGlobals[g] <> value) then
+    begin
+    lua_rawgeti(luaState, LUA_REGISTRYINDEX, EngineGlobalsRef);
+    // gear uids start at 1, 0 stands for no current hedgehog
+    if (g = egCurrentHedgehog) and (value = 0) then
+        lua_pushnil(luaState)
+    else
+        lua_pushinteger(luaState, value);
+    lua_rawseti(luaState, -2, g + 1);
+    lua_pop(luaState, 1);
+    EngineGlobals[g]:= value;
+    EngineGlobalsStale[g]:= false
+    end
+end;
+
 procedure SetGlobals;
 begin
-ScriptSetInteger('TurnTimeLeft', TurnTimeLeft);
-ScriptSetInteger('GameTime', GameTicks);
-ScriptSetInteger('TotalRounds', TotalRounds);
-ScriptSetInteger('WaterLine', cWaterLine);
+SetEngineGlobal(egTurnTimeLeft, TurnTimeLeft);
+SetEngineGlobal(egGameTime, GameTicks);
+SetEngineGlobal(egTotalRounds, TotalRounds);
+SetEngineGlobal(egWaterLine, cWaterLine);
 if not mapDims then
     begin
     mapDims:= true;
@@ -2783,22 +2956,30 @@ if not mapDims then
     ScriptSetInteger('TopY', topY)
     end;
 if (CurrentHedgehog <> nil) and (CurrentHedgehog^.Gear <> nil) then
-    ScriptSetInteger('CurrentHedgehog', CurrentHedgehog^.Gear^.UID)
+    SetEngineGlobal(egCurrentHedgehog, CurrentHedgehog^.Gear^.UID)
 else
-    ScriptSetNil('CurrentHedgehog');
+    SetEngineGlobal(egCurrentHedgehog, 0);
 end;
 
 procedure GetGlobals;
 begin
-TurnTimeLeft:= ScriptGetInteger('TurnTimeLeft');
+// TurnTimeLeft can only have changed if the script assigned it
+if EngineGlobalsStale[egTurnTimeLeft] then
+    begin
+    lua_rawgeti(luaState, LUA_REGISTRYINDEX, EngineGlobalsRef);
+    lua_rawgeti(luaState, -1, egTurnTimeLeft + 1);
+    TurnTimeLeft:= lua_tointeger(luaState, -1);
+    lua_pop(luaState, 2);
+    EngineGlobals[egTurnTimeLeft]:= TurnTimeLeft;
+    EngineGlobalsStale[egTurnTimeLeft]:= false
+    end
 end;
 
 procedure ScriptCall(fname : shortstring);
 begin
-if (not ScriptLoaded) or (not ScriptExists(fname)) then
+if (not ScriptLoaded) or (not ScriptPushHook(fname)) then
     exit;
 SetGlobals;
-lua_getglobal(luaState, Str2PChar(fname));
 if lua_pcall(luaState, 0, 0, 0) <> 0 then
     begin
     LuaError('Error while calling ' + fname + ': ' + lua_tostring(luaState, -1));
@@ -2846,10 +3027,9 @@ end;
 
 function ScriptCall(fname : shortstring; par1, par2, par3, par4 : LongInt) : LongInt;
 begin
-if (not ScriptLoaded) or (not ScriptExists(fname)) then
+if (not ScriptLoaded) or (not ScriptPushHook(fname)) then
     exit(0);
 SetGlobals;
-lua_getglobal(luaState, Str2PChar(fname));
 lua_pushinteger(luaState, par1);
 lua_pushinteger(luaState, par2);
 lua_pushinteger(luaState, par3);
@@ -2869,12 +3049,16 @@ GetGlobals;
 end;
 
 function ScriptExists(fname : shortstring) : boolean;
+var h: LongInt;
 begin
 if not ScriptLoaded then
     begin
     ScriptExists:= false;
     exit
     end;
+h:= HookIndex(fname);
+if h >= 0 then
+    exit(HookRefs[h] <> LUA_NOREF);
 lua_getglobal(luaState, Str2PChar(fname));
 ScriptExists:= not lua_isnoneornil(luaState, -1);
 lua_pop(luaState, -1)
@@ -2995,6 +3179,8 @@ luaopen_string(luaState);
 luaopen_math(luaState);
 luaopen_table(luaState);
 
+InitHookRegistry;
+
 // import some variables
 ScriptSetString(_S'L', cLocale);
 
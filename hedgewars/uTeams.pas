@@ -858,7 +858,7 @@ if TeamsCount > 0 then
 //                if Gear <> nil then
 //                    DeleteGearStage(Gear, true);
                 if GearHidden <> nil then
-                    Dispose(GearHidden);
+                    DisposeGear(GearHidden);
 //                    DeleteGearStage(GearHidden, true);
 
                 FreeAndNilTexture(NameTagTex);
@@ -199,10 +199,10 @@ begin
     lx:= width - 1;
     for y:= 0 to sly do
         begin
-        PrettifyAlpha(PLongWordArray(pixels[y]), PLongWordArray(pixels[y+1]), 0, lx, 0);
+        PrettifyAlpha(PLongWordArray(@pixels[y * width]), PLongWordArray(@pixels[(y + 1) * width]), 0, lx, 0);
         end;
     // don't forget last row
-    PrettifyAlpha(PLongWordArray(pixels[sly+1]), nil, 0, lx, 0);
+    PrettifyAlpha(PLongWordArray(@pixels[(sly + 1) * width]), nil, 0, lx, 0);
 end;
 
 function Surface2Tex(surf: PSDL_Surface; enableClamp: boolean): PTexture;
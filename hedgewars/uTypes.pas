@@ -180,6 +180,7 @@ type
     TWorldEdge = (weNone, weWrap, weBounce, weSea, weSky);
     TUIDisplay = (uiAll, uiNoTeams, uiNone);
     TMapGen = (mgRandom, mgMaze, mgPerlin, mgDrawn);
+    TLogLevel = (llError, llWarning, llInfo, llDebug);
 
 
     THHFont = record
@@ -250,6 +251,7 @@ type
             CollisionIndex: LongInt;    // Position in collision array
             Message: LongWord;          // Game messages are stored here. See gm bitmasks in uConsts
             uid: Longword;              // Lua use this to reference gears
+            NextByUID: PGear;           // Next gear in the same GearsByUID bucket
             Hedgehog: PHedgehog;        // set to CurrentHedgehog on gear creation.  uStats damage code appears to assume it will never be nil and never be changed.  If you override it, make sure it is set to a non-nil PHedgehog before dealing damage.
 // Strongly recommended not to override these.  Will mess up generic operations like portaling
             X : hwFloat;              // X/Y/dX/dY are position/velocity. People count on these having semi-normal values
@@ -315,6 +317,7 @@ type
         Text: shortstring;
         Tint: Longword;
         uid: Longword;
+        NextByUID: PVisualGear;
         Layer: byte;
         end;
 
@@ -469,8 +472,10 @@ type
             gidInfAttack, gidResetWeps, gidPerHogAmmo, gidTagTeam);
 
 
-    TLandArray = packed array of array of LongWord;
-    TCollisionArray = packed array of array of Word;
+    // Land and LandPixels are stored row after row in one block,
+    // see LAND_WIDTH and LAND_PIXELS_WIDTH for the row strides
+    TLandArray = packed array of LongWord;
+    TCollisionArray = packed array of Word;
     TDirtyTag = packed array of array of byte;
 
     TPreview  = packed array[0..127, 0..31] of byte;
@@ -62,8 +62,11 @@ function  endian(independent: LongWord): LongWord; inline;
 
 function  CheckCJKFont(s: ansistring; font: THWFont): THWFont;
 
-procedure AddFileLog(s: shortstring);
+procedure AddFileLog(s: shortstring); overload;
+procedure AddFileLog(level: TLogLevel; s: shortstring); overload;
 procedure AddFileLogRaw(s: pchar); cdecl;
+function  LogEnabled(level: TLogLevel): boolean; inline;
+procedure FlushFileLog;
 
 function  CheckNoTeamOrHH: boolean; inline;
 
@@ -95,12 +98,29 @@ procedure freeModule;
 
 
 implementation
-uses {$IFNDEF PAS2C}typinfo, {$ENDIF}Math, uConsts, uVariables, SysUtils;
+uses {$IFNDEF PAS2C}typinfo, {$ENDIF}Math, uConsts, uVariables, SysUtils{$IFNDEF PAS2C}, SDLh{$ENDIF};
 
 {$IFDEF DEBUGFILE}
 var logFile: textfile;
-{$IFDEF USE_VIDEO_RECORDING}
-    logMutex: TRTLCriticalSection; // mutex for debug file
+{$IFNDEF PAS2C}
+// Log lines are queued in a ring and written by a background thread, so
+// logging costs the caller a copy instead of a write and a flush.
+// Producers claim slots with an atomic increment of LogHead; a slot may be
+// read once its Seq is one past its position and may be reused once Seq has
+// moved a full ring further.
+const cLogRingSize = 1024; // power of 2
+
+type TLogSlot = record
+        Seq: LongInt;
+        Raw: boolean;
+        Line: shortstring;
+        end;
+
+var LogRing: array[0..Pred(cLogRingSize)] of TLogSlot;
+    LogHead, LogTail: LongInt;
+    LogLock: PSDL_mutex; // taken by whoever empties the ring
+    LogWriter: PSDL_Thread;
+    LogStop: boolean;
 {$ENDIF}
 {$ENDIF}
 var CharArray: array[0..255] of Char;
@@ -231,10 +251,8 @@ begin
 val(s, StrToInt);
 {$ELSE}
 val(s, StrToInt, c);
-{$IFDEF DEBUGFILE}
 if c <> 0 then
-    writeln(logFile, 'Error at position ' + IntToStr(c) + ' : ' + s[c])
-{$ENDIF}
+    AddFileLog(llWarning, 'Error at position ' + IntToStr(c) + ' : ' + s[c])
 {$ENDIF}
 end;
 
@@ -353,21 +371,90 @@ endian:= (((independent and $FF000000) shr 24) or
 end;
 
 
+{$IFDEF DEBUGFILE}
+{$IFNDEF PAS2C}
+// writes out everything queued so far, false if there was nothing
+function DrainFileLog: boolean;
+var slot: ^TLogSlot;
+    wrote: boolean;
+begin
+wrote:= false;
+SDL_LockMutex(LogLock);
+slot:= @LogRing[LogTail and Pred(cLogRingSize)];
+while slot^.Seq = LogTail + 1 do
+    begin
+    ReadBarrier;
+    if slot^.Raw then
+        write(logFile, slot^.Line)
+    else
+        writeln(logFile, slot^.Line);
+    slot^.Seq:= LogTail + cLogRingSize;
+    inc(LogTail);
+    wrote:= true;
+    slot:= @LogRing[LogTail and Pred(cLogRingSize)]
+    end;
+if wrote then
+    flush(logFile);
+SDL_UnlockMutex(LogLock);
+DrainFileLog:= wrote
+end;
+
+procedure QueueFileLog(const s: shortstring; isRaw: boolean);
+var pos: LongInt;
+    slot: ^TLogSlot;
+begin
+repeat
+    pos:= LogHead;
+    slot:= @LogRing[pos and Pred(cLogRingSize)];
+    if slot^.Seq = pos then
+        begin
+        if InterlockedCompareExchange(LogHead, pos + 1, pos) = pos then
+            begin
+            slot^.Raw:= isRaw;
+            slot^.Line:= s;
+            WriteBarrier;
+            slot^.Seq:= pos + 1;
+            exit
+            end
+        end
+    else if slot^.Seq - pos < 0 then
+        // ring is full, don't wait for the writer
+        DrainFileLog
+until false
+end;
+
+function LogWriterThread(param: Pointer): LongInt; cdecl; export;
+begin
+param:= param; // avoid compiler hint
+while not LogStop do
+    if not DrainFileLog then
+        SDL_Delay(5);
+LogWriterThread:= 0
+end;
+{$ENDIF}
+{$ENDIF}
+
+function LogEnabled(level: TLogLevel): boolean; inline;
+begin
+LogEnabled:= level <= cLogLevel
+end;
+
+procedure AddFileLog(level: TLogLevel; s: shortstring);
+begin
+if level <= cLogLevel then
+    AddFileLog(s)
+end;
+
 procedure AddFileLog(s: shortstring);
 begin
 // s:= s;
 {$IFDEF DEBUGFILE}
-
-{$IFDEF USE_VIDEO_RECORDING}
-EnterCriticalSection(logMutex);
-{$ENDIF}
+{$IFDEF PAS2C}
 writeln(logFile, inttostr(GameTicks)  + ': ' + s);
 flush(logFile);
-
-{$IFDEF USE_VIDEO_RECORDING}
-LeaveCriticalSection(logMutex);
+{$ELSE}
+QueueFileLog(inttostr(GameTicks)  + ': ' + s, false);
 {$ENDIF}
-
 {$ENDIF}
 end;
 
@@ -376,14 +463,17 @@ begin
 s:= s;
 {$IFNDEF PAS2C}
 {$IFDEF DEBUGFILE}
-{$IFDEF USE_VIDEO_RECORDING}
-EnterCriticalSection(logMutex);
+QueueFileLog(s, true);
 {$ENDIF}
-write(logFile, s);
-flush(logFile);
-{$IFDEF USE_VIDEO_RECORDING}
-LeaveCriticalSection(logMutex);
 {$ENDIF}
+end;
+
+// writes out queued lines right away, for use before halting
+procedure FlushFileLog;
+begin
+{$IFDEF DEBUGFILE}
+{$IFNDEF PAS2C}
+DrainFileLog;
 {$ENDIF}
 {$ENDIF}
 end;
@@ -542,9 +632,6 @@ begin
         {$ELSE}
         logfileBase:= 'preview';
         {$ENDIF}
-{$IFDEF USE_VIDEO_RECORDING}
-    InitCriticalSection(logMutex);
-{$ENDIF}
 {$I-}
     rwfailed:= false;
     if (length(UserPathPrefix) > 0) then
@@ -572,6 +659,14 @@ begin
     // if everything fails, write to stderr
     if (length(UserPathPrefix) = 0) or (rwfailed) then
         logFile:= stderr;
+
+    for i:= 0 to Pred(cLogRingSize) do
+        LogRing[i].Seq:= i;
+    LogHead:= 0;
+    LogTail:= 0;
+    LogStop:= false;
+    LogLock:= SDL_CreateMutex();
+    LogWriter:= SDL_CreateThread(@LogWriterThread{$IFDEF SDL2}, 'log'{$ENDIF}, nil);
 {$ENDIF}
 {$I+}
 {$ENDIF}
@@ -594,12 +689,17 @@ end;
 procedure freeModule;
 begin
 {$IFDEF DEBUGFILE}
+{$IFNDEF PAS2C}
+    LogStop:= true;
+    if LogWriter <> nil then
+        SDL_WaitThread(LogWriter, nil);
+    LogWriter:= nil;
+    DrainFileLog;
+    SDL_DestroyMutex(LogLock);
+{$ENDIF}
     writeln(logFile, 'halt at ' + inttostr(GameTicks) + ' ticks. TurnTimeLeft = ' + inttostr(TurnTimeLeft));
     flush(logFile);
     close(logFile);
-{$IFDEF USE_VIDEO_RECORDING}
-    DoneCriticalSection(logMutex);
-{$ENDIF}
 {$ENDIF}
 end;
 
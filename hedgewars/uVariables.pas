@@ -37,6 +37,7 @@ var
     cNewScreenHeight   : LongInt;
     cScreenResizeDelay : LongWord;
     ipcPort            : Word;
+    ipcSocketPath      : shortstring;
     AprilOne           : boolean;
     cFullScreen        : boolean;
     cLocaleFName       : shortstring;
@@ -45,6 +46,7 @@ var
     PathPrefix         : ansistring;
     UserPathPrefix     : ansistring;
     cShowFPS           : boolean;
+    cLogLevel          : TLogLevel; // messages above this level are not logged
     cFlattenFlakes     : boolean;
     cFlattenClouds     : boolean;
     cIce               : boolean;
@@ -52,11 +54,13 @@ var
 
     cAltDamage         : boolean;
     cReducedQuality    : LongWord;
+    cLandSmoothBudget  : LongWord;  // ms per frame for smoothing explosion borders, 0 for no limit
     UserNick           : shortstring;
     recordFileName     : shortstring;
     cReadyDelay        : Longword;
     cStereoMode        : TStereoMode;
     cOnlyStats         : boolean;
+    cPreviewWorker     : boolean;
 {$IFDEF USE_VIDEO_RECORDING}
     RecPrefix          : shortstring;
     cAVFormat          : shortstring;
@@ -142,6 +146,7 @@ var
     LAND_HEIGHT      : LongInt;
     LAND_WIDTH_MASK  : LongWord;
     LAND_HEIGHT_MASK : LongWord;
+    LAND_PIXELS_WIDTH: LongInt;  // row stride of LandPixels, half of LAND_WIDTH with rqBlurryLand
 
     ChefHatTexture : PTexture;
     CrosshairTexture : PTexture;
@@ -2343,13 +2348,21 @@ var
     Land: TCollisionArray;
     LandPixels: TLandArray;
     LandDirty: TDirtyTag;
+    // tiles of LandDirty that are flagged ldSweep and ldSmooth, as y * (LAND_WIDTH div 32) + x
+    LandDirtyList, LandSmoothList: array of LongInt;
+    LandDirtyCount, LandSmoothCount: LongInt;
+    // coarse summary of Land in 32x32 tiles, maintained by uLandUtils
+    LandTiles: array of Byte;
+    LandTileRows: array of LongInt;
+    LandTilesValid: boolean;
     hasBorder: boolean;
     hasGirders: boolean;
     playHeight, playWidth, leftX, rightX, topY, MaxHedgehogs: Longword;  // idea is that a template can specify height/width.  Or, a map, a height/width by the dimensions of the image.  If the map has pixels near top of image, it triggers border.
     LandBackSurface: PSDL_Surface;
     CurAmmoGear: PGear;
-    lastGearByUID: PGear;
     GearsList: PGear;
+    // gears in GearsList hashed by uid, see GearByUID
+    GearsByUID: array[0..Pred(cGearsByUIDSize)] of PGear;
     AllInactive: boolean;
     PrvInactive: boolean;
     KilledHHs: Longword;
@@ -2406,7 +2419,6 @@ var
     defaultFrame, depthv: GLuint;
     texv: GLuint;
 
-    lastVisualGearByUID: PVisualGear;
     vobFrameTicks, vobFramesCount, vobCount: Longword;
     vobVelocity, vobFallSpeed: LongInt;
     vobSDFrameTicks, vobSDFramesCount, vobSDCount: Longword;
@@ -2458,14 +2470,17 @@ begin
     cScreenHeight     := cWindowedHeight;
 
     cShowFPS        := false;
+    cLogLevel       := llDebug;
     cAltDamage      := true;
     cTimerInterval  := 8;
     cReducedQuality := rqNone;
+    cLandSmoothBudget:= 0;
     cLocaleFName    := 'en.txt';
     cFullScreen     := false;
 
     UserPathPrefix  := '';
     ipcPort         := 0;
+    ipcSocketPath   := '';
     recordFileName  := '';
     UserNick        := '';
     cStereoMode     := smNone;
@@ -2473,6 +2488,7 @@ begin
     PathPrefix      := './';
     GameType        := gmtLocal;
     cOnlyStats      := False;
+    cPreviewWorker  := False;
     cScriptName     := '';
     cScriptParam    := '';
     cTestLua        := False;
@@ -2500,8 +2516,7 @@ begin
     cFlattenClouds      := false;
     cIce                := false;
     cSnow               := false;
-    lastVisualGearByUID := nil;
-    lastGearByUID       := nil;
+    FillChar(GearsByUID, sizeof(GearsByUID), 0);
     cReadyDelay         := 5000;
 
         {*  REFERENCE
@@ -529,6 +529,7 @@ begin
 VGCounter:= 0;
 for i:= 0 to 6 do
     VisualGearLayers[i]:= nil;
+FillChar(VisualGearsByUID, sizeof(VisualGearsByUID), 0);
 end;
 
 procedure freeModule;
@@ -537,6 +538,7 @@ begin
 VGCounter:= 0;
 for i:= 0 to 6 do
     while VisualGearLayers[i] <> nil do DeleteVisualGear(VisualGearLayers[i]);
+FreeVisualGearsPool;
 end;
 
 end.
@@ -20,7 +20,7 @@
 
 unit uVisualGearsList;
 interface
-uses uTypes;
+uses uTypes, uConsts;
 
 function  AddVisualGear(X, Y: LongInt; Kind: TVisualGearType): PVisualGear; inline;
 function  AddVisualGear(X, Y: LongInt; Kind: TVisualGearType; State: LongWord): PVisualGear; inline;
@@ -28,15 +28,87 @@ function  AddVisualGear(X, Y: LongInt; Kind: TVisualGearType; State: LongWord; C
 function  AddVisualGear(X, Y: LongInt; Kind: TVisualGearType; State: LongWord; Critical: Boolean; Layer: LongInt): PVisualGear;
 procedure DeleteVisualGear(Gear: PVisualGear);
 function  VisualGearByUID(uid : Longword) : PVisualGear;
+procedure FreeVisualGearsPool;
 
 const
     cExplFrameTicks = 110;
 
 var VGCounter: LongWord;
     VisualGearLayers: array[0..6] of PVisualGear;
+    // all visual gears hashed by uid, see VisualGearByUID
+    VisualGearsByUID: array[0..Pred(cVisualGearsByUIDSize)] of PVisualGear;
 
 implementation
-uses uCollisions, uFloat, uVariables, uConsts, uTextures, uVisualGearsHandlers;
+uses uCollisions, uFloat, uVariables, uTextures, uVisualGearsHandlers, uUtils;
+
+// Visual gears come and go by the thousands (smoke, flames, bubbles,
+// damage tags), so their records are recycled from slabs like gears are.
+const cVisualGearsSlabSize = 256;
+
+type PVisualGearsSlab = ^TVisualGearsSlab;
+    TVisualGearsSlab = array[0..Pred(cVisualGearsSlabSize)] of TVisualGear;
+
+var VisualGearsSlabs: array of PVisualGearsSlab;
+    VisualGearsSlabsCount: LongWord;
+    FreeVisualGears: PVisualGear;
+    // pool statistics, written to the debug log by FreeVisualGearsPool
+    VisualGearsAllocated, VisualGearsInUse, VisualGearsPeak: LongWord;
+
+function NewVisualGear: PVisualGear;
+var slab: PVisualGearsSlab;
+    i: LongInt;
+    gear: PVisualGear;
+begin
+    if FreeVisualGears = nil then
+        begin
+        New(slab);
+        if VisualGearsSlabsCount = LongWord(Length(VisualGearsSlabs)) then
+            SetLength(VisualGearsSlabs, VisualGearsSlabsCount * 2 + 4);
+        VisualGearsSlabs[VisualGearsSlabsCount]:= slab;
+        inc(VisualGearsSlabsCount);
+        for i:= Pred(cVisualGearsSlabSize) downto 0 do
+            begin
+            slab^[i].NextGear:= FreeVisualGears;
+            FreeVisualGears:= @slab^[i]
+            end;
+        AddFileLog('Visual gears pool: added slab #' + inttostr(VisualGearsSlabsCount) + ', ' + inttostr(VisualGearsInUse) + ' visual gears in use')
+        end;
+
+    gear:= FreeVisualGears;
+    FreeVisualGears:= gear^.NextGear;
+    FillChar(gear^, sizeof(TVisualGear), 0);
+
+    inc(VisualGearsAllocated);
+    inc(VisualGearsInUse);
+    if VisualGearsInUse > VisualGearsPeak then
+        VisualGearsPeak:= VisualGearsInUse;
+
+    NewVisualGear:= gear
+end;
+
+procedure DisposeVisualGear(Gear: PVisualGear);
+begin
+    Gear^.NextGear:= FreeVisualGears;
+    FreeVisualGears:= Gear;
+    dec(VisualGearsInUse)
+end;
+
+procedure FreeVisualGearsPool;
+var i: LongInt;
+begin
+    AddFileLog('Visual gears pool: ' + inttostr(VisualGearsAllocated) + ' allocations, peak ' + inttostr(VisualGearsPeak)
+        + ' in use, ' + inttostr(VisualGearsSlabsCount) + ' slabs, ' + inttostr(VisualGearsInUse) + ' not returned');
+
+    for i:= 0 to Pred(LongInt(VisualGearsSlabsCount)) do
+        Dispose(VisualGearsSlabs[i]);
+    SetLength(VisualGearsSlabs, 0);
+    VisualGearsSlabsCount:= 0;
+    FreeVisualGears:= nil;
+
+    VisualGearsAllocated:= 0;
+    VisualGearsInUse:= 0;
+    VisualGearsPeak:= 0
+end;
 
 function AddVisualGear(X, Y: LongInt; Kind: TVisualGearType): PVisualGear; inline;
 begin
@@ -84,8 +156,7 @@ if ((cReducedQuality and rqAntiBoom) <> 0) and
         exit;
 
 inc(VGCounter);
-New(gear);
-FillChar(gear^, sizeof(TVisualGear), 0);
+gear:= NewVisualGear;
 gear^.X:= real(X);
 gear^.Y:= real(Y);
 gear^.Kind := Kind;
@@ -428,10 +499,16 @@ if VisualGearLayers[gear^.Layer] <> nil then
     end;
 VisualGearLayers[gear^.Layer]:= gear;
 
+t:= gear^.uid and Pred(cVisualGearsByUIDSize);
+gear^.NextByUID:= VisualGearsByUID[t];
+VisualGearsByUID[t]:= gear;
+
 AddVisualGear:= gear;
 end;
 
 procedure DeleteVisualGear(Gear: PVisualGear);
+var t: PVisualGear;
+    bucket: LongWord;
 begin
     FreeAndNilTexture(Gear^.Tex);
 
@@ -442,38 +519,36 @@ begin
     else
         VisualGearLayers[Gear^.Layer]:= Gear^.NextGear;
 
-    if lastVisualGearByUID = Gear then
-        lastVisualGearByUID:= nil;
+    bucket:= Gear^.uid and Pred(cVisualGearsByUIDSize);
+    if VisualGearsByUID[bucket] = Gear then
+        VisualGearsByUID[bucket]:= Gear^.NextByUID
+    else
+        begin
+        t:= VisualGearsByUID[bucket];
+        while (t <> nil) and (t^.NextByUID <> Gear) do
+            t:= t^.NextByUID;
+        if t <> nil then
+            t^.NextByUID:= Gear^.NextByUID
+        end;
 
-    Dispose(Gear);
+    DisposeVisualGear(Gear);
 end;
 
 function  VisualGearByUID(uid : Longword) : PVisualGear;
 var vg: PVisualGear;
-    i: LongWord;
 begin
 VisualGearByUID:= nil;
 if uid = 0 then
     exit;
-if (lastVisualGearByUID <> nil) and (lastVisualGearByUID^.uid = uid) then
-    begin
-    VisualGearByUID:= lastVisualGearByUID;
-    exit
-    end;
-// search in an order that is more likely to return layers they actually use.  Could perhaps track statistically AddVisualGear in uScript, since that is most likely the ones they want
-for i:= 2 to 5 do
+vg:= VisualGearsByUID[uid and Pred(cVisualGearsByUIDSize)];
+while vg <> nil do
     begin
-    vg:= VisualGearLayers[i mod 4];
-    while vg <> nil do
+    if vg^.uid = uid then
         begin
-        if vg^.uid = uid then
-            begin
-            lastVisualGearByUID:= vg;
-            VisualGearByUID:= vg;
-            exit
-            end;
-        vg:= vg^.NextGear
-        end
+        VisualGearByUID:= vg;
+        exit
+        end;
+    vg:= vg^.NextByUID
     end
 end;
 
@@ -18,6 +18,7 @@
  */
 
 #include "ipcbase.h"
+#include "../util/buffer.h"
 #include "../util/logging.h"
 #include "../util/util.h"
 #include "../socket.h"
@@ -32,11 +33,15 @@
  * the messages are at most 256 bytes, but the map preview contains 4097 bytes (4096 for a
  * bitmap, 1 for the number of hogs which fit on the map).
  *
- * We don't need to worry about wasting a few kb though, and I like powers of two...
+ * It may grow beyond that so a burst of engine messages is received in one go, messages
+ * are then taken out of it one by one without moving the rest.
  */
+#define IPC_READBUFFER_INITIAL 8192
+#define IPC_READBUFFER_LIMIT (64*1024)
+#define IPC_RECV_CHUNK 4096
+
 struct _flib_ipcbase {
-    uint8_t readBuffer[8192];
-    int readBufferSize;
+    flib_readbuffer *readBuffer;
 
     flib_acceptor *acceptor;
     uint16_t port;
@@ -46,17 +51,19 @@ struct _flib_ipcbase {
 
 flib_ipcbase *flib_ipcbase_create() {
     flib_ipcbase *result = flib_calloc(1, sizeof(flib_ipcbase));
+    flib_readbuffer *readBuffer = flib_readbuffer_create(IPC_READBUFFER_INITIAL, IPC_READBUFFER_LIMIT);
     flib_acceptor *acceptor = flib_acceptor_create(0);
 
-    if(!result || !acceptor) {
+    if(!result || !readBuffer || !acceptor) {
         free(result);
+        flib_readbuffer_destroy(readBuffer);
         flib_acceptor_close(acceptor);
         return NULL;
     }
 
     result->acceptor = acceptor;
     result->sock = NULL;
-    result->readBufferSize = 0;
+    result->readBuffer = readBuffer;
     result->port = flib_acceptor_listenport(acceptor);
 
     flib_log_i("Started listening for IPC connections on port %u", (unsigned)result->port);
@@ -77,6 +84,7 @@ void flib_ipcbase_destroy(flib_ipcbase *ipc) {
         if(ipc->sock) {
             flib_log_d("IPC connection closed.");
         }
+        flib_readbuffer_destroy(ipc->readBuffer);
         free(ipc);
     }
 }
@@ -95,10 +103,7 @@ IpcState flib_ipcbase_state(flib_ipcbase *ipc) {
 
 static void receiveToBuffer(flib_ipcbase *ipc) {
     if(ipc->sock) {
-        int size = flib_socket_nbrecv(ipc->sock, ipc->readBuffer+ipc->readBufferSize, sizeof(ipc->readBuffer)-ipc->readBufferSize);
-        if(size>=0) {
-            ipc->readBufferSize += size;
-        } else {
+        if(flib_socket_nbrecv_buffer(ipc->sock, ipc->readBuffer, IPC_RECV_CHUNK) < 0) {
             flib_log_d("IPC connection lost.");
             flib_socket_close(ipc->sock);
             ipc->sock = NULL;
@@ -107,7 +112,8 @@ static void receiveToBuffer(flib_ipcbase *ipc) {
 }
 
 static bool isMessageReady(flib_ipcbase *ipc) {
-    return ipc->readBufferSize >= ipc->readBuffer[0]+1;
+    size_t size = flib_readbuffer_size(ipc->readBuffer);
+    return size > 0 && size >= flib_readbuffer_data(ipc->readBuffer)[0]+1;
 }
 
 static void logSentMsg(const uint8_t *data, size_t len) {
@@ -134,9 +140,8 @@ static void logRecvMsg(const uint8_t *data) {
 }
 
 static void popFromReadBuffer(flib_ipcbase *ipc, uint8_t *outbuf, size_t size) {
-    memcpy(outbuf, ipc->readBuffer, size);
-    memmove(ipc->readBuffer, ipc->readBuffer+size, ipc->readBufferSize-size);
-    ipc->readBufferSize -= size;
+    memcpy(outbuf, flib_readbuffer_data(ipc->readBuffer), size);
+    flib_readbuffer_consume(ipc->readBuffer, size);
 }
 
 int flib_ipcbase_recv_message(flib_ipcbase *ipc, void *data) {
@@ -149,13 +154,13 @@ int flib_ipcbase_recv_message(flib_ipcbase *ipc, void *data) {
     }
 
     if(isMessageReady(ipc)) {
-        int msgsize = ipc->readBuffer[0]+1;
+        int msgsize = flib_readbuffer_data(ipc->readBuffer)[0]+1;
         popFromReadBuffer(ipc, data, msgsize);
         logRecvMsg(data);
         return msgsize;
-    } else if(!ipc->sock && ipc->readBufferSize>0) {
-        flib_log_w("Last message from engine data stream is incomplete (received %u of %u bytes)", (unsigned)ipc->readBufferSize, (unsigned)(ipc->readBuffer[0])+1);
-        ipc->readBufferSize = 0;
+    } else if(!ipc->sock && flib_readbuffer_size(ipc->readBuffer)>0) {
+        flib_log_w("Last message from engine data stream is incomplete (received %u of %u bytes)", (unsigned)flib_readbuffer_size(ipc->readBuffer), (unsigned)(flib_readbuffer_data(ipc->readBuffer)[0])+1);
+        flib_readbuffer_clear(ipc->readBuffer);
         return -1;
     } else {
         return -1;
@@ -169,7 +174,7 @@ int flib_ipcbase_recv_map(flib_ipcbase *ipc, void *data) {
 
     receiveToBuffer(ipc);
 
-    if(ipc->readBufferSize >= IPCBASE_MAPMSG_BYTES) {
+    if(flib_readbuffer_size(ipc->readBuffer) >= IPCBASE_MAPMSG_BYTES) {
         popFromReadBuffer(ipc, data, IPCBASE_MAPMSG_BYTES);
         return IPCBASE_MAPMSG_BYTES;
     } else {
@@ -28,10 +28,12 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+#define NET_READBUFFER_INITIAL (16*1024)
 #define NET_READBUFFER_LIMIT (1024*1024)
+#define NET_RECV_CHUNK 4096
 
 struct _flib_netbase {
-    flib_vector *readBuffer;
+    flib_readbuffer *readBuffer;
     flib_tcpsocket *sock;
 };
 
@@ -44,7 +46,7 @@ flib_netbase *flib_netbase_create(const char *server, uint16_t port) {
     flib_netbase *newNet =  flib_calloc(1, sizeof(flib_netbase));
 
     if(newNet) {
-        newNet->readBuffer = flib_vector_create();
+        newNet->readBuffer = flib_readbuffer_create(NET_READBUFFER_INITIAL, NET_READBUFFER_LIMIT);
         newNet->sock = flib_socket_connect(server, port);
         if(newNet->readBuffer && newNet->sock) {
             flib_log_i("Connected to server %s:%u", server, (unsigned)port);
@@ -60,7 +62,7 @@ flib_netbase *flib_netbase_create(const char *server, uint16_t port) {
 void flib_netbase_destroy(flib_netbase *net) {
     if(net) {
         flib_socket_close(net->sock);
-        flib_vector_destroy(net->readBuffer);
+        flib_readbuffer_destroy(net->readBuffer);
         free(net);
     }
 }
@@ -73,11 +75,13 @@ bool flib_netbase_connected(flib_netbase *net) {
 }
 
 /**
- * Parses and returns a message, and removes it from the vector.
+ * Parses and returns a message, and consumes it from the buffer.
+ * The parts are copied out directly, the rest of the buffer stays in place.
  */
-static flib_netmsg *parseMessage(flib_vector *vec) {
-    const uint8_t *partStart = flib_vector_data(vec);
-    const uint8_t *end = partStart+flib_vector_size(vec);
+static flib_netmsg *parseMessage(flib_readbuffer *buf) {
+    const uint8_t *bufStart = flib_readbuffer_data(buf);
+    const uint8_t *partStart = bufStart;
+    const uint8_t *end = bufStart+flib_readbuffer_size(buf);
     flib_netmsg *result = flib_netmsg_create();
     if(!result) {
         return NULL;
@@ -90,11 +94,8 @@ static flib_netmsg *parseMessage(flib_vector *vec) {
             flib_netmsg_destroy(result);
             return NULL;
         } else if(partEnd-partStart == 0) {
-            // Zero-length part, message end marker. Remove the message from the vector.
-            uint8_t *vectorStart = flib_vector_data(vec);
-            size_t msgLen = partEnd+1-vectorStart;
-            memmove(vectorStart, partEnd+1, flib_vector_size(vec)-msgLen);
-            flib_vector_resize(vec, flib_vector_size(vec)-msgLen);
+            // Zero-length part, message end marker. Consume the message.
+            flib_readbuffer_consume(buf, partEnd+1-bufStart);
             return result;
         } else {
             if(flib_netmsg_append_part(result, partStart, partEnd-partStart)) {
@@ -108,23 +109,22 @@ static flib_netmsg *parseMessage(flib_vector *vec) {
 }
 
 /**
- * Receive some bytes and add them to the buffer.
+ * Receive everything available and add it to the buffer.
  * Returns the number of bytes received.
  * Automatically closes the socket if an error occurs
  * and sets sock=NULL.
  */
 static int receiveToBuffer(flib_netbase *net) {
-    uint8_t buffer[256];
     if(!net->sock) {
         return 0;
-    } else if(flib_vector_size(net->readBuffer) > NET_READBUFFER_LIMIT) {
+    } else if(flib_readbuffer_size(net->readBuffer) >= NET_READBUFFER_LIMIT) {
         flib_log_e("Net connection closed: Net message too big");
         flib_socket_close(net->sock);
         net->sock = NULL;
         return 0;
     } else {
-        int size = flib_socket_nbrecv(net->sock, buffer, sizeof(buffer));
-        if(size>=0 && !flib_vector_append(net->readBuffer, buffer, size)) {
+        int size = flib_socket_nbrecv_buffer(net->sock, net->readBuffer, NET_RECV_CHUNK);
+        if(size>=0) {
             return size;
         } else {
             flib_socket_close(net->sock);
@@ -145,9 +145,9 @@ flib_netmsg *flib_netbase_recv_message(flib_netbase *net) {
 
     if(msg) {
         return msg;
-    } else if(!net->sock && flib_vector_size(net->readBuffer)>0) {
+    } else if(!net->sock && flib_readbuffer_size(net->readBuffer)>0) {
         // Connection is down and we didn't get a complete message, just flush the rest.
-        flib_vector_resize(net->readBuffer, 0);
+        flib_readbuffer_clear(net->readBuffer);
     }
     return NULL;
 }
@@ -21,6 +21,7 @@
 #include "util/logging.h"
 #include "util/util.h"
 #include <stdlib.h>
+#include <limits.h>
 #include <SDL_net.h>
 #include <time.h>
 
@@ -182,6 +183,33 @@ int flib_socket_nbrecv(flib_tcpsocket *sock, void *data, int maxlen) {
     }
 }
 
+int flib_socket_nbrecv_buffer(flib_tcpsocket *sock, flib_readbuffer *buf, size_t chunkSize) {
+    if(!sock || !buf) {
+        flib_log_e("Call to flib_socket_nbrecv_buffer with sock==null or buf==null");
+        return -1;
+    }
+    int total = 0;
+    while(1) {
+        flib_buffer space = flib_readbuffer_prepare(buf, chunkSize);
+        if(space.size == 0) {
+            break; // buffer full, leave the rest to the next call
+        }
+        int maxlen = space.size > INT_MAX ? INT_MAX : (int)space.size;
+        int size = flib_socket_nbrecv(sock, space.data, maxlen);
+        if(size < 0) {
+            return -1;
+        } else if(size == 0) {
+            break;
+        }
+        flib_readbuffer_commit(buf, size);
+        total += size;
+        if(size < maxlen) {
+            break; // a short read means the socket is drained
+        }
+    }
+    return total;
+}
+
 int flib_socket_send(flib_tcpsocket *sock, const void *data, int len) {
     if(!sock || (len>0 && !data)) {
         flib_log_e("Call to flib_socket_send with sock==null or data==null");
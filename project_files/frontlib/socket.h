@@ -33,6 +33,9 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stddef.h>
+
+#include "util/buffer.h"
 
 typedef struct _flib_tcpsocket flib_tcpsocket;
 typedef struct _flib_acceptor flib_acceptor;
@@ -81,6 +84,16 @@ void flib_socket_close(flib_tcpsocket *socket);
  */
 int flib_socket_nbrecv(flib_tcpsocket *sock, void *data, int maxlen);
 
+/**
+ * Receive everything that is available from the socket into the read buffer,
+ * with reads of at least chunkSize bytes, until nothing more is available or
+ * the buffer can't grow any further. Does not block.
+ * Returns the ammount of data received, or a negative number if the
+ * connection was closed or an error occurred. Data received before that
+ * remains in the buffer.
+ */
+int flib_socket_nbrecv_buffer(flib_tcpsocket *sock, flib_readbuffer *buf, size_t chunkSize);
+
 /**
  * Blocking send all the data in the data buffer. Returns the actual ammount
  * of data sent, or a negative value on error. If the value returned here
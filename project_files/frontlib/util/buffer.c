@@ -175,3 +175,107 @@ size_t flib_vector_size(flib_vector *vec) {
         return vec->size;
     }
 }
+
+struct _flib_readbuffer {
+    uint8_t *data;
+    size_t start;       // first unconsumed byte
+    size_t end;         // end of the received data
+    size_t capacity;
+    size_t maxCapacity;
+};
+
+flib_readbuffer *flib_readbuffer_create(size_t initialCapacity, size_t maxCapacity) {
+    if(log_badargs_if2(initialCapacity==0, maxCapacity<initialCapacity)) {
+        return NULL;
+    }
+
+    flib_readbuffer *result = NULL;
+    flib_readbuffer *tmpBuffer = flib_calloc(1, sizeof(flib_readbuffer));
+    if(tmpBuffer) {
+        tmpBuffer->data = flib_malloc(initialCapacity);
+        if(tmpBuffer->data) {
+            tmpBuffer->capacity = initialCapacity;
+            tmpBuffer->maxCapacity = maxCapacity;
+            result = tmpBuffer;
+            tmpBuffer = NULL;
+        }
+    }
+    flib_readbuffer_destroy(tmpBuffer);
+    return result;
+}
+
+void flib_readbuffer_destroy(flib_readbuffer *buf) {
+    if(buf) {
+        free(buf->data);
+        free(buf);
+    }
+}
+
+const uint8_t *flib_readbuffer_data(flib_readbuffer *buf) {
+    if(log_badargs_if(buf==NULL)) {
+        return NULL;
+    }
+    return buf->data + buf->start;
+}
+
+size_t flib_readbuffer_size(flib_readbuffer *buf) {
+    if(log_badargs_if(buf==NULL)) {
+        return 0;
+    }
+    return buf->end - buf->start;
+}
+
+void flib_readbuffer_consume(flib_readbuffer *buf, size_t len) {
+    if(!log_badargs_if(buf==NULL) && !log_badargs_if(len > buf->end - buf->start)) {
+        buf->start += len;
+        if(buf->start == buf->end) {
+            // Everything consumed, start over at the front for free
+            buf->start = 0;
+            buf->end = 0;
+        }
+    }
+}
+
+void flib_readbuffer_clear(flib_readbuffer *buf) {
+    if(!log_badargs_if(buf==NULL)) {
+        buf->start = 0;
+        buf->end = 0;
+    }
+}
+
+flib_buffer flib_readbuffer_prepare(flib_readbuffer *buf, size_t minFree) {
+    flib_buffer result = {NULL, 0};
+    if(log_badargs_if(buf==NULL)) {
+        return result;
+    }
+
+    if(buf->capacity - buf->end < minFree && buf->start > 0) {
+        memmove(buf->data, buf->data + buf->start, buf->end - buf->start);
+        buf->end -= buf->start;
+        buf->start = 0;
+    }
+
+    if(buf->capacity - buf->end < minFree && buf->capacity < buf->maxCapacity) {
+        size_t newCapacity = buf->capacity;
+        while(newCapacity - buf->end < minFree && newCapacity < buf->maxCapacity) {
+            newCapacity = newCapacity <= buf->maxCapacity/2 ? newCapacity*2 : buf->maxCapacity;
+        }
+        uint8_t *newData = flib_realloc(buf->data, newCapacity);
+        if(newData) {
+            buf->data = newData;
+            buf->capacity = newCapacity;
+        }
+    }
+
+    if(buf->capacity > buf->end) {
+        result.data = buf->data + buf->end;
+        result.size = buf->capacity - buf->end;
+    }
+    return result;
+}
+
+void flib_readbuffer_commit(flib_readbuffer *buf, size_t len) {
+    if(!log_badargs_if(buf==NULL) && !log_badargs_if(len > buf->capacity - buf->end)) {
+        buf->end += len;
+    }
+}
@@ -101,4 +101,60 @@ flib_buffer flib_vector_as_buffer(flib_vector *vec);
  */
 flib_constbuffer flib_vector_as_constbuffer(flib_vector *vec);
 
+/**
+ * Receive buffer for stream protocols. New data is written at the end, and
+ * messages are parsed in place and consumed from the front by advancing an
+ * offset, so taking out a message never moves the rest of the data. The
+ * space of consumed data is reclaimed only when more room is needed at the
+ * end, which usually means moving just the start of one incomplete message.
+ */
+typedef struct _flib_readbuffer flib_readbuffer;
+
+/**
+ * Create a new read buffer which starts out with initialCapacity bytes and
+ * grows up to maxCapacity bytes if needed. Needs to be destroyed again later
+ * with flib_readbuffer_destroy. May return NULL if memory runs out.
+ */
+flib_readbuffer *flib_readbuffer_create(size_t initialCapacity, size_t maxCapacity);
+
+/**
+ * Free the memory of this read buffer. NULL-safe.
+ */
+void flib_readbuffer_destroy(flib_readbuffer *buf);
+
+/**
+ * Return a pointer to the first unconsumed byte. This pointer becomes
+ * invalid with the next call to flib_readbuffer_prepare.
+ */
+const uint8_t *flib_readbuffer_data(flib_readbuffer *buf);
+
+/**
+ * Return the number of unconsumed bytes.
+ */
+size_t flib_readbuffer_size(flib_readbuffer *buf);
+
+/**
+ * Mark the first len unconsumed bytes as consumed.
+ */
+void flib_readbuffer_consume(flib_readbuffer *buf, size_t len);
+
+/**
+ * Drop all data in the buffer.
+ */
+void flib_readbuffer_clear(flib_readbuffer *buf);
+
+/**
+ * Return the free space at the end of the buffer, making room for at least
+ * minFree bytes if the capacity limit allows it. The returned buffer may be
+ * smaller than minFree, or empty if the buffer is full. After writing to it,
+ * call flib_readbuffer_commit with the number of bytes actually written.
+ */
+flib_buffer flib_readbuffer_prepare(flib_readbuffer *buf, size_t minFree);
+
+/**
+ * Append len bytes which were written to the space returned by
+ * flib_readbuffer_prepare.
+ */
+void flib_readbuffer_commit(flib_readbuffer *buf, size_t len);
+
 #endif
@@ -0,0 +1,71 @@
+-- Benchmark for dispatching engine commands.
+--
+-- Feeds the command stream of a long replay through ParseCommand: every
+-- tick a batch of movement, aiming and weapon commands as they appear in
+-- demos. Those are among the first commands registered, which made them
+-- the slowest ones to look up.
+--
+-- Every command has to end up in its own handler, which is told by the
+-- hook the handler calls and the parameter it passes.
+
+HedgewarsScriptLoad("/lib/bench.lua")
+
+local commandsPerTick = 200
+local firstTick = 1000
+local lastTick = 10000
+
+-- a replay's worth of hog input, repeated over and over, with the hook
+-- each command's handler calls and the parameter it passes to it
+local script = {
+	{"+right", "onRight"}, {"-right", "onRightUp"}, {"+left", "onLeft"}, {"-left", "onLeftUp"},
+	{"+up", "onUp"}, {"-up", "onUpUp"}, {"+down", "onDown"}, {"-down", "onDownUp"},
+	{"+precise", "onPrecise"}, {"-precise", "onPreciseUp"},
+	{"+left", "onLeft"}, {"+precise", "onPrecise"}, {"-precise", "onPreciseUp"}, {"-left", "onLeftUp"},
+	{"setweap \1", "onSetWeapon", amGrenade}, {"slot 1", "onSlot", 0}, {"timer 3", "onTimer", 3},
+	{"+up", "onUp"}, {"+precise", "onPrecise"}, {"-precise", "onPreciseUp"}, {"-up", "onUpUp"},
+}
+
+local calledHook = nil
+local calledParam = nil
+
+for i = 1, #script, 1 do
+	local hook = script[i][2]
+	_G[hook] = function(param)
+		calledHook = hook
+		calledParam = param
+	end
+end
+
+local nCommands = 0
+local nextCommand = 1
+
+function onGameInit()
+	BenchGameInit(function()
+		AddPoint(500, 1400, 63)
+		AddPoint(3500, 1400)
+	end)
+	-- lots of room to walk around
+	SetGearPosition(player, 2000, 1000)
+end
+
+function onGameTick()
+	if GameTime < firstTick then
+		return
+	end
+
+	if GameTime > lastTick then
+		BenchEnd('Dispatched ' .. nCommands .. ' commands')
+		return
+	end
+
+	for i = 1, commandsPerTick, 1 do
+		local command = script[nextCommand]
+		calledHook = nil
+		calledParam = nil
+		ParseCommand(command[1])
+		BenchCheck((calledHook == command[2]) and (calledParam == command[3]),
+			'"%s" called %s(%s)', command[1], calledHook, calledParam)
+		nextCommand = nextCommand % #script + 1
+		nCommands = nCommands + 1
+	end
+end
@@ -0,0 +1,105 @@
+-- Benchmark for looking up gears and visual gears by uid.
+--
+-- Spawns lots of gears and visual gears, deletes a third of them and then,
+-- every tick, looks up a few hundred uids via GetX and GetVisualGearValues,
+-- which is what mission scripts do all the time.
+--
+-- A lookup has to find the gear exactly as long as it exists, which the
+-- script knows from onGearAdd and onGearDelete, and visual gears as long
+-- as they have not been deleted. Uids of gears that never existed are
+-- looked up as well.
+
+HedgewarsScriptLoad("/lib/bench.lua")
+
+local nGears = 1000
+local nVisualGears = 2000
+local lookupsPerTick = 200
+local firstTick = 1000
+local lastTick = 10000
+
+local gears = {}
+local visualGears = {}
+local visualGearDeleted = {}
+local nextGear = 1
+local nextVisualGear = 1
+local nLookups = 0
+
+-- every gear that currently exists, by uid
+local existing = {}
+local maxUid = 0
+
+function onGearAdd(gear)
+	existing[gear] = true
+	if gear > maxUid then
+		maxUid = gear
+	end
+end
+
+function onGearDelete(gear)
+	existing[gear] = nil
+end
+
+function onGameInit()
+	BenchGameInit(function()
+		-- floor for the mines
+		AddPoint(500, 1400, 63)
+		AddPoint(3500, 1400)
+	end)
+end
+
+function onGameStart()
+	for i = 1, nGears, 1 do
+		gears[i] = AddGear(600 + (i * 7) % 2800, 900 - 10 * math.floor(i * 7 / 2800), gtMine, 0, 0, 0, 0)
+	end
+	for i = 1, nVisualGears, 1 do
+		local vg = AddVisualGear(600 + i, 500, vgtCircle, 0, true)
+		-- visual gears might be disabled altogether
+		if vg ~= nil then
+			table.insert(visualGears, vg)
+		end
+	end
+	nVisualGears = #visualGears
+
+	-- leave holes in the chains of uids
+	for i = 1, nGears, 3 do
+		DeleteGear(gears[i])
+	end
+	for i = 1, nVisualGears, 3 do
+		visualGearDeleted[i] = DeleteVisualGear(visualGears[i])
+	end
+
+	-- and look up some that never were
+	for i = 1, nGears / 10, 1 do
+		table.insert(gears, maxUid + i * 13)
+	end
+	nGears = #gears
+end
+
+function onGameTick()
+	if GameTime < firstTick then
+		return
+	end
+
+	if GameTime > lastTick then
+		BenchEnd('Looked up ' .. nLookups .. ' gears and visual gears')
+		return
+	end
+
+	for i = 1, lookupsPerTick, 1 do
+		local gear = gears[nextGear]
+		local found = GetX(gear) ~= nil
+		BenchCheck(found == (existing[gear] == true), 'gear %s found: %s', gear, found)
+		-- stride through the arrays so consecutive lookups hit different gears
+		nextGear = (nextGear + 36) % nGears + 1
+
+		nLookups = nLookups + 1
+
+		if nVisualGears > 0 then
+			local vg = visualGears[nextVisualGear]
+			found = GetVisualGearValues(vg) ~= nil
+			BenchCheck(found ~= (visualGearDeleted[nextVisualGear] == true), 'visual gear %s found: %s', vg, found)
+			nextVisualGear = (nextVisualGear + 36) % nVisualGears + 1
+			nLookups = nLookups + 1
+		end
+	end
+end
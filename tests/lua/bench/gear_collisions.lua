@@ -0,0 +1,210 @@
+-- Benchmark for gear vs. gear collision checks.
+--
+-- Buries a row of mines on top of a thick slab of land and then keeps
+-- firing bullets through the slab far below them. Every bullet step calls
+-- AmmoShove (and so CheckGearsCollision) while the mines sit in the
+-- collision registry, so the time of this test is dominated by how fast
+-- nearby collision entries are looked up.
+--
+-- Next to the mines stands a row of invulnerable hogs, and every few ticks
+-- one of them gets shot at. Which gears the probe bullet has to hit, and
+-- which ones it must not, is decided by scanning all of them for their
+-- distance to the bullet's path, and then compared to which hogs got
+-- pushed away. Gear collisions are only looked for once a bullet went
+-- through a few pixels of land, which a hog's own collision mask is, so
+-- probes come out of thin air diagonally down through the middle of their
+-- target and end in the slab behind it.
+
+HedgewarsScriptLoad("/lib/bench.lua")
+
+local nMines = 2000
+local nBulletsPerTick = 4
+local firstShotTime = 5000
+local lastShotTime = 15000
+
+local nTeams = 4
+local nHogsPerTeam = 8
+local probeInterval = 8
+-- ticks until a probe surely went through its target and that got pushed
+local probeFlightTicks = 3
+local probeDistance = 28
+
+-- bullet radius + 2, how much further gear collisions reach
+local shotReach = 3
+-- what a probe's target is pushed away with at least by the time it's
+-- checked, in GetGearVelocity units
+local minPushSpeed = 20000
+
+local nShots = 0
+local nProbes = 0
+local nSkippedProbes = 0
+
+local hogs = {}
+local nextTarget = 1
+local mines = {}
+local minePos = {}
+local nMinesGone = 0
+
+local probe = nil
+local ticksToProbe = 0
+
+function onGameInit()
+	BenchGameInit(function()
+		-- slab of land, roughly y 1080 to 1720
+		AddPoint(500, 1400, 63)
+		AddPoint(3500, 1400)
+	end)
+
+	-- the targets, far enough from the mines to not set them off
+	for t = 1, nTeams, 1 do
+		AddTeam("'Target Team " .. t, 14483456, "Simple", "Island", "Default")
+		for h = 1, nHogsPerTeam, 1 do
+			local hog = AddHog("Target " .. t .. "." .. h, 0, 100, "NoHat")
+			SetEffect(hog, heInvulnerable, 1)
+			SetGearPosition(hog, 600 + 40 * #hogs, 1000)
+			table.insert(hogs, hog)
+		end
+	end
+end
+
+function onGameStart()
+	-- drop the mines on top of the slab
+	for i = 0, nMines - 1, 1 do
+		local mine = AddGear(2100 + (i * 7) % 1300, 900 - 10 * math.floor(i * 7 / 1300), gtMine, 0, 0, 0, 0)
+		mines[mine] = true
+	end
+end
+
+function onGearDelete(gear)
+	if mines[gear] then
+		nMinesGone = nMinesGone + 1
+	end
+end
+
+-- whether the hog is standing still in the collision registry, which it
+-- only joins after waiting a bit
+local function isResting(hog)
+	local dx, dy = GetGearVelocity(hog)
+	return (band(GetState(hog), bor(gstMoving, gstWait)) == 0)
+		and (math.abs(dx) < 1000) and (math.abs(dy) < 1000)
+end
+
+-- distance between (px, py) and the segment from (ax, ay) to (bx, by)
+local function segmentDistance(px, py, ax, ay, bx, by)
+	local dx = bx - ax
+	local dy = by - ay
+	local t = ((px - ax) * dx + (py - ay) * dy) / (dx * dx + dy * dy)
+	t = math.max(0, math.min(1, t))
+	local ex = ax + t * dx - px
+	local ey = ay + t * dy - py
+	return math.sqrt(ex * ex + ey * ey)
+end
+
+-- Fires a probe at the hog if the scan over all gears says for sure what
+-- it will hit, returns whether it did.
+local function fireProbe(target)
+	if not isResting(target) then
+		return false
+	end
+
+	local tx, ty = GetGearPosition(target)
+	local ax = tx - probeDistance
+	local ay = ty - probeDistance
+	-- a bullet is out of health long before this
+	local bx = ax + 100
+	local by = ay + 100
+
+	local resting = {}
+	for i = 1, #hogs, 1 do
+		local hog = hogs[i]
+		local x, y = GetGearPosition(hog)
+		local d = segmentDistance(x, y, ax, ay, bx, by)
+		if hog == target then
+			if d > 2 then
+				return false
+			end
+		elseif d <= GetGearRadius(hog) + shotReach + 2 then
+			-- might be grazed, don't bother
+			return false
+		elseif isResting(hog) then
+			table.insert(resting, hog)
+		end
+	end
+	local mineReach = 2 + shotReach + 2
+	for mine, _ in pairs(mines) do
+		local pos = minePos[mine]
+		-- mines gone already are counted at the end
+		if (pos[1] ~= nil) and (pos[1] >= ax - mineReach) and (pos[1] <= bx + mineReach)
+			and (segmentDistance(pos[1], pos[2], ax, ay, bx, by) <= mineReach) then
+			return false
+		end
+	end
+
+	local v = math.floor(math.sqrt(0.5) * 1000000)
+	AddGear(ax, ay, gtDEagleShot, 0, v, v, 0)
+	probe = {target = target, x = tx, y = ty, resting = resting, ticks = probeFlightTicks}
+	return true
+end
+
+local function checkProbe()
+	local dx = GetGearVelocity(probe.target)
+	BenchCheck(dx >= minPushSpeed, 'hog %s at %s,%s was not hit by the probe', probe.target, probe.x, probe.y)
+	for i = 1, #probe.resting, 1 do
+		local hog = probe.resting[i]
+		BenchCheck(isResting(hog), 'hog %s was hit by the probe at %s,%s', hog, probe.x, probe.y)
+	end
+	nProbes = nProbes + 1
+end
+
+function onGameTick()
+	if GameTime < firstShotTime then
+		return
+	end
+
+	if GameTime > lastShotTime then
+		BenchCheck(nMinesGone == 0, '%s mines went off', nMinesGone)
+		BenchCheck(nProbes > nSkippedProbes, 'only %s probes fired, %s skipped', nProbes, nSkippedProbes)
+		BenchEnd('Fired ' .. nShots .. ' bullets next to ' .. nMines .. ' mines, '
+			.. nProbes .. ' probes at ' .. #hogs .. ' hogs, ' .. nSkippedProbes .. ' skipped')
+		return
+	end
+
+	-- nothing touches the mines, so they stay where they are
+	if next(minePos) == nil then
+		for mine, _ in pairs(mines) do
+			minePos[mine] = {GetGearPosition(mine)}
+		end
+	end
+
+	if probe ~= nil then
+		probe.ticks = probe.ticks - 1
+		if probe.ticks == 0 then
+			checkProbe()
+			probe = nil
+		end
+	end
+
+	ticksToProbe = ticksToProbe - 1
+	if (probe == nil) and (ticksToProbe <= 0) then
+		ticksToProbe = probeInterval
+		-- try every hog once at most
+		local fired = false
+		for i = 1, #hogs, 1 do
+			local target = hogs[nextTarget]
+			nextTarget = nextTarget % #hogs + 1
+			if fireProbe(target) then
+				fired = true
+				break
+			end
+		end
+		if not fired then
+			nSkippedProbes = nSkippedProbes + 1
+		end
+	end
+
+	-- horizontal bullets deep inside of the slab
+	for i = 0, nBulletsPerTick - 1, 1 do
+		AddGear(600 + 700 * i, 1500 + 40 * i, gtDEagleShot, 0, 1000000, 0, 0)
+		nShots = nShots + 1
+	end
+end
@@ -0,0 +1,61 @@
+-- Benchmark for land carving and land collision checks.
+--
+-- Keeps dropping short fused grenades into a thick slab of land, so most
+-- of the time is spent in DrawExplosion, the land collision tests of the
+-- falling grenades and the follow-up texture updates.
+--
+-- Every grenade has to go off, and where it did there must not be any
+-- land left.
+
+HedgewarsScriptLoad("/lib/bench.lua")
+
+local nGrenadesPerTick = 2
+local firstDropTime = 5000
+local lastDropTime = 15000
+-- well inside of the crater of a grenade
+local craterSize = 20
+
+local nGrenades = 0
+local nExploded = 0
+local grenades = {}
+
+function onGameInit()
+	BenchGameInit(function()
+		-- slab of land, roughly y 1080 to 1720
+		AddPoint(500, 1400, 63)
+		AddPoint(3500, 1400)
+	end, true)
+end
+
+function onGearDelete(gear)
+	if not grenades[gear] then
+		return
+	end
+	grenades[gear] = nil
+
+	-- the land got carved right before the grenade is deleted
+	local x, y = GetGearPosition(gear)
+	if BenchCheck(GetTimer(gear) == 0, 'grenade at %s,%s gone before its time', x, y) then
+		BenchCheck(not TestRectForObstacle(x - craterSize, y - craterSize, x + craterSize, y + craterSize, true),
+			'land left in the crater at %s,%s', x, y)
+		nExploded = nExploded + 1
+	end
+end
+
+function onGameTick()
+	if GameTime < firstDropTime then
+		return
+	end
+
+	if GameTime > lastDropTime then
+		BenchEnd('Dropped ' .. nGrenades .. ' grenades, ' .. nExploded .. ' went off')
+		return
+	end
+
+	-- spread the drops over the whole slab so the land gets riddled
+	for i = 0, nGrenadesPerTick - 1, 1 do
+		local grenade = AddGear(600 + (nGrenades * 37) % 2800, 1000 + (nGrenades * 13) % 600, gtGrenade, 0, 0, 0, 200)
+		grenades[grenade] = true
+		nGrenades = nGrenades + 1
+	end
+end
@@ -0,0 +1,120 @@
+-- Benchmark for queries looking for free space in the land.
+--
+-- A mostly empty map with a few thin platforms, on which lots of mines get
+-- placed with FindPlace while big rectangles of air are tested for
+-- obstacles. Both have to look through a lot of empty land, so the time of
+-- this test is dominated by how fast empty areas can be skipped.
+--
+-- The answers are checked against the drawn map: a rectangle has to be
+-- found blocked exactly if it reaches into the land drawn, leaving out the
+-- ones just grazing its rounded edges, and mines have to be placed right
+-- on top of a platform.
+
+HedgewarsScriptLoad("/lib/bench.lua")
+
+local nPlacesPerTick = 2
+local nRectsPerTick = 20
+local firstTime = 5000
+local lastTime = 10000
+
+local nPlaces = 0
+local nRects = 0
+local nUnsureRects = 0
+
+-- the platforms, as drawn and as far as their rounded edges reach
+local platformY = 1900
+local platformWidth = 4
+local platformRadius = (platformWidth * 10 + 6) / 2
+local platforms = {}
+for i = 0, 5, 1 do
+	table.insert(platforms, {200 + i * 650, 600 + i * 650})
+end
+-- the spawn platform
+local spawnX = 10
+local spawnY = 30
+local spawnRadius = 3
+
+-- whether the rectangles from (x1, y1) to (x2, y2) and from (l, t) to
+-- (r, b) overlap
+local function overlaps(x1, y1, x2, y2, l, t, r, b)
+	return (x1 <= r) and (x2 >= l) and (y1 <= b) and (y2 >= t)
+end
+
+-- whether the rectangle reaches into the map's land for sure, whether it
+-- might graze it, both false if it is far from it
+local function landInRect(x1, y1, x2, y2)
+	local sure = false
+	local maybe = false
+	local r = platformRadius
+	for i = 1, #platforms, 1 do
+		local p = platforms[i]
+		-- the core of the line and the box around it with its round caps
+		sure = sure or overlaps(x1, y1, x2, y2, p[1], platformY - r + 2, p[2], platformY + r - 2)
+		maybe = maybe or overlaps(x1, y1, x2, y2, p[1] - r - 2, platformY - r - 2, p[2] + r + 2, platformY + r + 2)
+	end
+	sure = sure or overlaps(x1, y1, x2, y2, spawnX, spawnY, spawnX, spawnY)
+	maybe = maybe or overlaps(x1, y1, x2, y2, spawnX - spawnRadius - 2, spawnY - spawnRadius - 2,
+		spawnX + spawnRadius + 2, spawnY + spawnRadius + 2)
+	return sure, maybe
+end
+
+-- whether a gear of the radius at (x, y) stands right on top of land
+local function onTopOfLand(x, y, radius)
+	local bottom = y + radius
+	for i = 1, #platforms, 1 do
+		local p = platforms[i]
+		if (x >= p[1] - platformRadius) and (x <= p[2] + platformRadius)
+			and (bottom >= platformY - platformRadius - 1) and (bottom <= platformY + platformRadius) then
+			return true
+		end
+	end
+	return (math.abs(x - spawnX) <= spawnRadius + radius) and (math.abs(bottom - spawnY) <= spawnRadius + 1)
+end
+
+function onGameInit()
+	BenchGameInit(function()
+		-- a few thin platforms far down, lots of air above them
+		for i = 1, #platforms, 1 do
+			AddPoint(platforms[i][1], platformY, platformWidth)
+			AddPoint(platforms[i][2], platformY)
+		end
+	end)
+end
+
+function onGameTick()
+	if GameTime < firstTime then
+		return
+	end
+
+	if GameTime > lastTime then
+		BenchEnd('Placed ' .. nPlaces .. ' mines, tested ' .. nRects .. ' rectangles, '
+			.. nUnsureRects .. ' of them too close to the land to tell')
+		return
+	end
+
+	for i = 0, nPlacesPerTick - 1, 1 do
+		local mine = AddGear(0, 0, gtMine, 0, 0, 0, 0)
+		if BenchCheck(FindPlace(mine, false, 0, LAND_WIDTH) ~= nil, 'no place found for a mine') then
+			local x, y = GetGearPosition(mine)
+			local r = GetGearRadius(mine)
+			BenchCheck(onTopOfLand(x, y, r), 'mine placed at %s,%s', x, y)
+			-- don't let them pile up and change the land collision too much
+			DeleteGear(mine)
+		end
+		nPlaces = nPlaces + 1
+	end
+
+	for i = 0, nRectsPerTick - 1, 1 do
+		-- reaching down to the platforms now and then
+		local x = (nRects * 97) % 3600
+		local y = (nRects * 61) % 1700
+		local sure, maybe = landInRect(x, y, x + 400, y + 300)
+		local blocked = TestRectForObstacle(x, y, x + 400, y + 300, true)
+		if sure or (not maybe) then
+			BenchCheck(blocked == sure, 'rectangle %s,%s blocked: %s', x, y, blocked)
+		else
+			nUnsureRects = nUnsureRects + 1
+		end
+		nRects = nRects + 1
+	end
+end
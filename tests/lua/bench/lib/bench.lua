@@ -0,0 +1,73 @@
+-- Shared parts of the benchmark tests.
+--
+-- Run the benchmarks with "make test_bench" to see their timing. Each of
+-- them also checks the results of the code it keeps busy against a slow
+-- but obvious answer, so a benchmark that got fast by getting things wrong
+-- fails instead.
+--
+-- Load with HedgewarsScriptLoad("/lib/bench.lua").
+
+local nChecks = 0
+local nFailed = 0
+
+-- Sets up the game of a benchmark: a drawn map with the points added by
+-- drawLand, no randomly placed extras and a single hog, the player, on a
+-- small spawn platform in the top left corner, far away from the action.
+-- The land is indestructible unless destructible is true.
+function BenchGameInit(drawLand, destructible)
+	Seed = 1
+	MapGen = mgDrawn
+	Theme = "Bamboo"
+	EnableGameFlags(gfOneClanMode, gfDisableWind, gfDisableLandObjects, gfDisableGirders, gfInfAttack)
+	if not destructible then
+		EnableGameFlags(gfSolidLand)
+	end
+	CaseFreq = 0
+	MinesNum = 0
+	Explosives = 0
+	TurnTime = 9999000
+
+	-- No damage please
+	DamagePercent = 1
+
+	-- hog spawn platform
+	AddPoint(10, 30, 0)
+	drawLand()
+
+	FlushPoints()
+
+	AddTeam("'Zooka Team", 14483456, "Simple", "Island", "Default")
+	player = AddHog("Hunter", 0, 1, "NoHat")
+	SetGearPosition(player, 10, 10)
+end
+
+-- Counts a check, ok is its outcome. If it failed, the message made of
+-- format and the remaining arguments, which go through tostring and so
+-- belong to %s, is logged. Only the first few failures are, and only then
+-- the message gets built.
+function BenchCheck(ok, format, ...)
+	nChecks = nChecks + 1
+	if not ok then
+		nFailed = nFailed + 1
+		if nFailed <= 10 then
+			local n = select('#', ...)
+			local args = {...}
+			for i = 1, n, 1 do
+				args[i] = tostring(args[i])
+			end
+			WriteLnToConsole('Check failed: ' .. string.format(format, unpack(args, 1, n)))
+		end
+	end
+	return ok
+end
+
+-- Ends the benchmark, summary tells what it did. A benchmark that did not
+-- get to check anything fails as well.
+function BenchEnd(summary)
+	WriteLnToConsole(summary .. ', ' .. nFailed .. ' of ' .. nChecks .. ' checks failed')
+	if (nFailed > 0) or (nChecks == 0) then
+		EndLuaTest(TEST_FAILED)
+	else
+		EndLuaTest(TEST_SUCCESSFUL)
+	end
+end
@@ -0,0 +1,148 @@
+-- Checks the circles drawn into Land pixel by pixel.
+--
+-- Blows craters into the slab, one overlapping another and some cut off
+-- by the edges of Land, and compares every pixel around them to the model
+-- of the land. Then checks the round collision areas of two resting hogs,
+-- the current one and another one, which are drawn by the same code, and
+-- that they are moved along with the hogs without leaving anything behind.
+
+HedgewarsScriptLoad("/lib/land.lua")
+
+local startTime = 100
+local timeout = 20000
+
+-- land reaching the right and the top edge of Land, as {x1, x2, y, width}
+local edgeLines = {{3800, 4095, 300, 30}, {3300, 3600, 40, 10}}
+
+local bombSpots = {
+	{716, slabTop}, {916, slabTop},       -- surface craters
+	{1500, 1450}, {1720, 1450},           -- holes inside of the slab
+	{2000, 1450}, {2060, 1450},           -- overlapping holes
+	{4085, 300}, {3450, 5},               -- cut off by the edges of Land
+}
+
+-- the hogs and where they get moved to
+local hogRadius = 9
+local moves = {{2700, 2850}, {2900, 3050}}
+local hogs = {}
+
+local phase = 0
+local nPixels = 0
+
+function onGameInit()
+	LandTestGameInit(edgeLines)
+
+	SetGearPosition(player, moves[1][1], slabTop - 30)
+	table.insert(hogs, player)
+	AddTeam("'Other Team", 14483456, "Simple", "Island", "Default")
+	local hog = AddHog("Other", 0, 100, "NoHat")
+	SetGearPosition(hog, moves[2][1], slabTop - 30)
+	table.insert(hogs, hog)
+end
+
+local function isLandPixel(x, y)
+	return TestRectForObstacle(x, y, x, y, true)
+end
+
+local function isSetPixel(x, y)
+	return TestRectForObstacle(x, y, x, y, false)
+end
+
+local function inLand(x, y)
+	return (x >= 0) and (x < LAND_WIDTH) and (y >= 0) and (y < LAND_HEIGHT)
+end
+
+local function checkCrater(cx, cy)
+	local m = bombRadius + 8
+	for y = cy - m, cy + m, 1 do
+		for x = cx - m, cx + m, 1 do
+			if inLand(x, y) then
+				local expected = LandAt(x, y)
+				if expected ~= nil then
+					local found = isLandPixel(x, y)
+					LandTestCheck(found == (expected == 1), 'pixel %s,%s near the crater at %s,%s is land: %s',
+						x, y, cx, cy, found)
+					nPixels = nPixels + 1
+				end
+			end
+		end
+	end
+end
+
+-- whether the hog is standing still in the collision registry, which it
+-- only joins after waiting a bit
+local function isResting(hog)
+	local dx, dy = GetGearVelocity(hog)
+	return (band(GetState(hog), bor(gstMoving, gstWait)) == 0)
+		and (math.abs(dx) < 1000) and (math.abs(dy) < 1000)
+end
+
+-- Checks the collision area of a hog at (cx, cy) is there, or is gone
+-- without leaving anything behind. Only air is looked at, so the land the
+-- hog stands on doesn't get in the way.
+local function checkHogArea(cx, cy, there)
+	-- the area has the radius of the hog minus one
+	local inner = hogRadius - 1 - 2
+	local outer = hogRadius - 1 + 2
+	for y = cy - outer - 4, cy + outer + 4, 1 do
+		for x = cx - outer - 4, cx + outer + 4, 1 do
+			if LandAt(x, y) == 0 then
+				local d = math.sqrt((x - cx) * (x - cx) + (y - cy) * (y - cy))
+				-- the hog doesn't count as land
+				LandTestCheck(not isLandPixel(x, y), 'collision pixel %s,%s counts as land', x, y)
+				if d <= inner then
+					LandTestCheck(isSetPixel(x, y) == there, 'collision pixel %s,%s of the hog at %s,%s set: %s',
+						x, y, cx, cy, not there)
+				elseif d > outer then
+					LandTestCheck(not isSetPixel(x, y), 'pixel %s,%s next to the hog at %s,%s set', x, y, cx, cy)
+				end
+				nPixels = nPixels + 1
+			end
+		end
+	end
+end
+
+local function checkHogs()
+	for i = 1, #hogs, 1 do
+		local x, y = GetGearPosition(hogs[i])
+		checkHogArea(x, y, true)
+	end
+
+	-- moving a resting hog moves its collision area right away
+	for i = 1, #hogs, 1 do
+		local hog = hogs[i]
+		local x, y = GetGearPosition(hog)
+		SetGearPosition(hog, moves[i][2], y)
+		checkHogArea(x, y, false)
+		checkHogArea(moves[i][2], y, true)
+	end
+end
+
+function onGameTick()
+	if GameTime < startTime then
+		return
+	end
+
+	if GameTime > timeout then
+		LandTestCheck(false, 'test timed out')
+		LandTestEnd('Timed out')
+		return
+	end
+
+	if phase == 0 then
+		for i = 1, #bombSpots, 1 do
+			DropBomb(bombSpots[i][1], bombSpots[i][2])
+		end
+		phase = 1
+	elseif phase == 1 then
+		if BombsLeft() == 0 then
+			for i = 1, #craters, 1 do
+				checkCrater(craters[i][1], craters[i][2])
+			end
+			phase = 2
+		end
+	elseif (phase == 2) and isResting(hogs[1]) and isResting(hogs[2]) then
+		checkHogs()
+		LandTestEnd('Checked ' .. nPixels .. ' pixels around ' .. #craters .. ' craters and ' .. #hogs .. ' hogs')
+	end
+end
@@ -0,0 +1,118 @@
+-- Checks that sweeping the tiles flagged dirty leaves no stray land behind.
+--
+-- Blows rows of holes into the slab, so close to each other that only thin
+-- walls and spikes of land are left between them, and waits for the land
+-- to be swept during the turn, as it is with infinite attack. After that
+-- no land pixel the explosions went over may have less than 4 of its 8
+-- neighbours in land, which is what despeckling removes. Before the sweep
+-- there have to be some, or the test would check nothing.
+
+HedgewarsScriptLoad("/lib/land.lua")
+
+local startTime = 100
+-- the land is swept every 5 seconds during the turn, give it two chances
+local sweepWait = 11000
+local timeout = 40000
+
+-- rows of bombs, as x of the first one, y and the distances between them
+local rows = {
+	{800, 1450, {100, 101, 102, 103, 104, 105, 106}},
+	{700, slabTop + 20, {60, 70, 80, 90}},
+	{1000, 1600, {99, 100, 101}},
+}
+local nBombsPerRow = 21
+
+local bombSpots = {}
+local nextBomb = 1
+local sweepTime = nil
+local nSpecklesBefore = 0
+
+function onGameInit()
+	LandTestGameInit(nil, gfInfAttack)
+end
+
+-- Calls f(x, y) for every land pixel explosions went over, leaving out
+-- the ones right at the edge of a crater.
+local function forLandInCraterEdges(f)
+	local cache = {}
+	local function isLand(x, y)
+		local k = y * LAND_WIDTH + x
+		local v = cache[k]
+		if v == nil then
+			v = TestRectForObstacle(x, y, x, y, true)
+			cache[k] = v
+		end
+		return v
+	end
+
+	local seen = {}
+	local rIn = bombRadius - 2
+	local rOut = bombRadius + 2
+	for i = 1, #craters, 1 do
+		local cx = craters[i][1]
+		local cy = craters[i][2]
+		for y = cy - rOut, cy + rOut, 1 do
+			for x = cx - rOut, cx + rOut, 1 do
+				local d = math.sqrt((x - cx) * (x - cx) + (y - cy) * (y - cy))
+				local k = y * LAND_WIDTH + x
+				if (d >= rIn) and (d <= rOut) and (not seen[k]) and isLand(x, y) then
+					seen[k] = true
+					local n = 0
+					for dy = -1, 1, 1 do
+						for dx = -1, 1, 1 do
+							if ((dx ~= 0) or (dy ~= 0)) and isLand(x + dx, y + dy) then
+								n = n + 1
+							end
+						end
+					end
+					f(x, y, n)
+				end
+			end
+		end
+	end
+end
+
+function onGameTick()
+	if GameTime < startTime then
+		return
+	end
+
+	if GameTime > timeout then
+		LandTestCheck(false, 'test timed out')
+		LandTestEnd('Timed out')
+		return
+	end
+
+	if #bombSpots == 0 then
+		for i = 1, #rows, 1 do
+			local x = rows[i][1]
+			local steps = rows[i][3]
+			for j = 0, nBombsPerRow - 1, 1 do
+				table.insert(bombSpots, {x, rows[i][2]})
+				x = x + steps[j % #steps + 1]
+			end
+		end
+	end
+
+	-- one at a time, so they don't push each other around
+	if nextBomb <= #bombSpots then
+		DropBomb(bombSpots[nextBomb][1], bombSpots[nextBomb][2])
+		nextBomb = nextBomb + 1
+	elseif (sweepTime == nil) and (BombsLeft() == 0) then
+		forLandInCraterEdges(function(x, y, n)
+			if n < 4 then
+				nSpecklesBefore = nSpecklesBefore + 1
+			end
+		end)
+		LandTestCheck(nSpecklesBefore > 0, 'no stray land pixels left by the explosions')
+		sweepTime = GameTime + sweepWait
+	elseif (sweepTime ~= nil) and (GameTime >= sweepTime) then
+		local nPixels = 0
+		forLandInCraterEdges(function(x, y, n)
+			LandTestCheck(n >= 4, 'land pixel %s,%s left with %s neighbours', x, y, n)
+			nPixels = nPixels + 1
+		end)
+		LandTestEnd('Checked ' .. nPixels .. ' land pixels around ' .. #craters .. ' craters, with '
+			.. nSpecklesBefore .. ' stray ones before the sweep')
+	end
+end
@@ -0,0 +1,165 @@
+-- Checks the land queries that skip empty areas by the tile summary of
+-- Land against the land actually there.
+--
+-- Blows craters into the surface of a slab and whole tiles out of its
+-- inside, places girders in the air and inside of a hole and erases one of
+-- them again, so tiles go from solid to empty and back. After that
+-- TestRectForObstacle has to find land in a rectangle exactly when the
+-- model of the land has some there, PlaceGirder has to fail exactly where
+-- a girder would overlap land, and mines placed with FindPlace have to end
+-- up in the air right on top of land.
+
+HedgewarsScriptLoad("/lib/land.lua")
+
+local nRandomRects = 400
+local nMinesPerTick = 20
+local nMineTicks = 10
+local startTime = 100
+local timeout = 20000
+
+-- surface craters, and holes inside of the slab centered on a 32x32 tile
+-- each, so that tile gets cleared completely
+local surfaceCraters = {{716, slabTop}, {916, slabTop}, {1116, slabTop}, {1316, slabTop}}
+local holes = {{1808, 1424}, {2032, 1424}, {2256, 1424}}
+
+-- girders to place: x, y and whether they fit
+local girders = {
+	{1808, 1424, true},  -- inside of a hole
+	{2072, 1424, false}, -- across the edge of a hole
+	{2600, 1500, false}, -- inside of the slab
+	{2600, 900, true},
+	{2800, 900, true},
+	{3000, 900, true},
+}
+-- and where the girder to erase again is
+local erasedGirder = {2800, 900}
+
+local phase = 0
+local nRects = 0
+local nUnsureRects = 0
+local nMines = 0
+local nMineTicksLeft = nMineTicks
+
+function onGameInit()
+	LandTestGameInit()
+end
+
+local function checkRect(x1, y1, x2, y2, mustBeSure)
+	local expected = LandInRect(x1, y1, x2, y2)
+	if expected == nil then
+		LandTestCheck(not mustBeSure, 'rectangle %s,%s - %s,%s too close to the land edge to check', x1, y1, x2, y2)
+		nUnsureRects = nUnsureRects + 1
+	else
+		local blocked = TestRectForObstacle(x1, y1, x2, y2, true)
+		LandTestCheck(blocked == expected, 'rectangle %s,%s - %s,%s blocked: %s', x1, y1, x2, y2, blocked)
+	end
+	nRects = nRects + 1
+end
+
+local function placeGirders()
+	for i = 1, #girders, 1 do
+		local g = girders[i]
+		local placed = PlaceGirder(g[1], g[2], 0)
+		LandTestCheck(placed == g[3], 'girder at %s,%s placed: %s', g[1], g[2], placed)
+		if placed then
+			AddLandGirder(g[1], g[2], 1)
+		end
+	end
+
+	EraseSprite(erasedGirder[1], erasedGirder[2], sprAmGirder, 0)
+	AddLandGirder(erasedGirder[1], erasedGirder[2], 0)
+end
+
+local function checkRects()
+	-- the air above everything and between the girders and the slab
+	checkRect(100, 0, 4000, 850, true)
+	checkRect(100, 920, 4000, slabTop - 10, true)
+
+	for i = 1, #girders, 1 do
+		local g = girders[i]
+		checkRect(g[1] - 60, g[2] - 30, g[1] + 60, g[2] + 30, true)
+	end
+
+	for i = 1, #craters, 1 do
+		local x = craters[i][1]
+		local y = craters[i][2]
+		-- inside of the crater, all of it and a single row
+		checkRect(x - 30, y - 30, x + 30, y + 30, true)
+		checkRect(x - 40, y + 20, x + 40, y + 20, true)
+		-- and reaching out of it
+		checkRect(x - 60, y - 60, x + 60, y + 60, true)
+		checkRect(x - 60, y + 20, x + 60, y + 20, true)
+	end
+
+	-- all over the place, big and small
+	for i = 0, nRandomRects - 1, 1 do
+		local x = 450 + (i * 211) % 3100
+		local y = 820 + (i * 97) % 900
+		checkRect(x, y, x + (i * 37) % 150, y + (i * 53) % 100, false)
+	end
+
+	-- and around the changes made to the land
+	local spots = {}
+	for i = 1, #craters, 1 do
+		table.insert(spots, craters[i])
+	end
+	for i = 1, #girders, 1 do
+		table.insert(spots, girders[i])
+	end
+	for i = 0, nRandomRects - 1, 1 do
+		local spot = spots[i % #spots + 1]
+		local x = spot[1] - 70 + (i * 29) % 100
+		local y = spot[2] - 70 + (i * 31) % 100
+		checkRect(x, y, x + (i * 13) % 90, y + (i * 17) % 90, false)
+	end
+end
+
+local function placeMine()
+	local mine = AddGear(0, 0, gtMine, 0, 0, 0, 0)
+	if LandTestCheck(FindPlace(mine, false, slabLeft, slabRight) ~= nil, 'no place found for a mine') then
+		local x, y = GetGearPosition(mine)
+		local r = GetGearRadius(mine)
+		-- air all the way down to the mine's bottom, land right below it
+		LandTestCheck(LandInRect(x - r + 1, y - r, x + r - 1, y + r - 1) ~= true, 'mine placed in land at %s,%s', x, y)
+		LandTestCheck(LandInRect(x - r + 1, y + r, x + r - 1, y + r) ~= false, 'mine placed in the air at %s,%s', x, y)
+		DeleteGear(mine)
+	end
+	nMines = nMines + 1
+end
+
+function onGameTick()
+	if GameTime < startTime then
+		return
+	end
+
+	if GameTime > timeout then
+		LandTestCheck(false, 'test timed out')
+		LandTestEnd('Timed out')
+		return
+	end
+
+	if phase == 0 then
+		for i = 1, #surfaceCraters, 1 do
+			DropBomb(surfaceCraters[i][1], surfaceCraters[i][2])
+		end
+		for i = 1, #holes, 1 do
+			DropBomb(holes[i][1], holes[i][2])
+		end
+		phase = 1
+	elseif phase == 1 then
+		if BombsLeft() == 0 then
+			placeGirders()
+			checkRects()
+			phase = 2
+		end
+	elseif phase == 2 then
+		for i = 1, nMinesPerTick, 1 do
+			placeMine()
+		end
+		nMineTicksLeft = nMineTicksLeft - 1
+		if nMineTicksLeft == 0 then
+			LandTestEnd('Tested ' .. nRects .. ' rectangles, ' .. nUnsureRects
+				.. ' of them too close to the land edge to tell, and placed ' .. nMines .. ' mines')
+		end
+	end
+end
@@ -0,0 +1,244 @@
+-- Shared parts of the tests checking what the engine sees of the land.
+--
+-- The tests draw a thick slab of destructible land, change it with
+-- explosions and girders, and then compare the engine's answers to a model
+-- of the land built from the same shapes. Pixels right at the edge of a
+-- shape depend on how exactly it got rasterized, the model doesn't tell
+-- those and the tests leave them out.
+--
+-- Load with HedgewarsScriptLoad("/lib/land.lua").
+
+-- the slab, roughly y 1080 to 1720
+slabLeft = 500
+slabRight = 3500
+slabY = 1400
+slabRadius = (63 * 10 + 6) / 2
+slabTop = slabY - slabRadius
+
+-- what a grenade carves out
+bombRadius = 50
+
+-- explosions set off with DropBomb, as {x, y}, in the order they went off
+craters = {}
+
+-- how close to the edge of a round shape pixels can't be told
+local edgeMargin = 2
+
+-- the shapes the land is made of, in the order they got drawn; each one
+-- either sets land (value 1) or clears it (value 0)
+local shapes = {}
+
+local nChecks = 0
+local nFailed = 0
+
+local bombs = {}
+local nBombs = 0
+
+-- 2 if (x, y) is inside of the shape for sure, 1 if it's too close to its
+-- edge to tell, 0 if it's outside
+local function roundShapeCovers(d, radius)
+	if d <= radius - edgeMargin then
+		return 2
+	elseif d <= radius + edgeMargin then
+		return 1
+	end
+	return 0
+end
+
+local function addShape(shape, value, l, t, r, b)
+	shape.value = value
+	shape.l = l
+	shape.t = t
+	shape.r = r
+	shape.b = b
+	table.insert(shapes, shape)
+end
+
+-- a line from (x1, y) to (x2, y) as drawn with AddPoint, radius included
+function AddLandLine(x1, x2, y, radius, value)
+	local m = radius + edgeMargin
+	addShape({covers = function(x, py)
+		local dx = math.max(x1 - x, 0, x - x2)
+		local dy = py - y
+		return roundShapeCovers(math.sqrt(dx * dx + dy * dy), radius)
+	end}, value, x1 - m, y - m, x2 + m, y + m)
+end
+
+function AddLandDisc(cx, cy, radius, value)
+	AddLandLine(cx, cx, cy, radius, value)
+end
+
+-- a rectangle of opaque sprite pixels, which are placed exactly
+function AddLandRect(x1, y1, x2, y2, value)
+	addShape({covers = function(x, y)
+		if (x >= x1) and (x <= x2) and (y >= y1) and (y <= y2) then
+			return 2
+		end
+		return 0
+	end}, value, x1, y1, x2, y2)
+end
+
+-- the land a girder placed with PlaceGirder(x, y, 0) covers, its frame is
+-- all opaque there and nowhere else
+function AddLandGirder(x, y, value)
+	AddLandRect(x - 40, y - 8, x + 39, y + 7, value)
+end
+
+-- the model's answer for the pixel: 1 for land, 0 for air, nil if it
+-- can't tell
+local function landAt(list, x, y)
+	local v = 0
+	for i = 1, #list, 1 do
+		local s = list[i]
+		local c = s.covers(x, y)
+		if c == 2 then
+			v = s.value
+		elseif (c == 1) and (v ~= s.value) then
+			v = nil
+		end
+	end
+	return v
+end
+
+local function shapesInRect(x1, y1, x2, y2)
+	local list = {}
+	local anyLand = false
+	for i = 1, #shapes, 1 do
+		local s = shapes[i]
+		if (x1 <= s.r) and (x2 >= s.l) and (y1 <= s.b) and (y2 >= s.t) then
+			table.insert(list, s)
+			anyLand = anyLand or (s.value == 1)
+		end
+	end
+	return list, anyLand
+end
+
+function LandAt(x, y)
+	return landAt(shapesInRect(x, y, x, y), x, y)
+end
+
+-- The model's answer to TestRectForObstacle(x1, y1, x2, y2, true): true if
+-- there is land in the rectangle, false if there is none, nil if it can't
+-- tell.
+function LandInRect(x1, y1, x2, y2)
+	local list, anyLand = shapesInRect(x1, y1, x2, y2)
+	if not anyLand then
+		return false
+	end
+	local unsure = false
+	for y = y1, y2, 1 do
+		for x = x1, x2, 1 do
+			local v = landAt(list, x, y)
+			if v == 1 then
+				return true
+			elseif v == nil then
+				unsure = true
+			end
+		end
+	end
+	if unsure then
+		return nil
+	end
+	return false
+end
+
+-- Counts the check and logs it if it failed. The message is only
+-- formatted for failed checks. Returns ok.
+function LandTestCheck(ok, format, ...)
+	nChecks = nChecks + 1
+	if not ok then
+		nFailed = nFailed + 1
+		if nFailed <= 10 then
+			local args = {...}
+			for i = 1, select('#', ...), 1 do
+				args[i] = tostring(args[i])
+			end
+			WriteLnToConsole('Check failed: ' .. string.format(format, unpack(args, 1, select('#', ...))))
+		end
+	end
+	return ok
+end
+
+function LandTestEnd(summary)
+	WriteLnToConsole('TESTRESULT: ' .. summary .. ', ' .. nFailed .. ' of ' .. nChecks .. ' checks failed')
+	if (nFailed > 0) or (nChecks == 0) then
+		EndLuaTest(TEST_FAILED)
+	else
+		EndLuaTest(TEST_SUCCESSFUL)
+	end
+end
+
+-- Sets up the game with the slab and the lines given as {x1, x2, y, width}
+-- drawn next to it. Game flags passed are enabled on top of the usual
+-- ones.
+function LandTestGameInit(lines, ...)
+	lines = lines or {}
+	Seed = 1
+	MapGen = mgDrawn
+	Theme = "Bamboo"
+	EnableGameFlags(gfOneClanMode, gfDisableWind, gfDisableLandObjects, gfDisableGirders)
+	if select('#', ...) > 0 then
+		EnableGameFlags(...)
+	end
+	CaseFreq = 0
+	MinesNum = 0
+	Explosives = 0
+	-- don't let the turn end in the middle of the test
+	TurnTime = 9999000
+
+	-- No damage please
+	DamagePercent = 1
+
+	-- Draw Map
+	AddPoint(10, 30, 0) -- hog spawn platform
+	AddPoint(slabLeft, slabY, 63)
+	AddPoint(slabRight, slabY)
+	for i = 1, #lines, 1 do
+		local l = lines[i]
+		AddPoint(l[1], l[3], l[4])
+		AddPoint(l[2], l[3])
+	end
+	FlushPoints()
+
+	AddLandDisc(10, 30, 3, 1)
+	AddLandLine(slabLeft, slabRight, slabY, slabRadius, 1)
+	for i = 1, #lines, 1 do
+		local l = lines[i]
+		AddLandLine(l[1], l[2], l[3], (l[4] * 10 + 6) / 2, 1)
+	end
+
+	-- Create the player team
+	AddTeam("'Zooka Team", 14483456, "Simple", "Island", "Default")
+	-- And add a hog to it
+	player = AddHog("Hunter", 0, 1, "NoHat")
+	-- place it on its spawn platform
+	SetGearPosition(player, 10, 10)
+end
+
+-- Blows a crater into the land at (x, y) with a grenade going off the
+-- first time it's stepped. The crater is added to the model once it did.
+function DropBomb(x, y)
+	bombs[AddGear(x, y, gtGrenade, 0, 0, 0, 1)] = true
+	nBombs = nBombs + 1
+end
+
+-- how many bombs dropped didn't go off yet
+function BombsLeft()
+	return nBombs
+end
+
+function onGearDelete(gear)
+	if not bombs[gear] then
+		return
+	end
+	bombs[gear] = nil
+	nBombs = nBombs - 1
+
+	-- the land got carved right before the grenade is deleted, wherever
+	-- other explosions might have pushed it
+	local x, y = GetGearPosition(gear)
+	if LandTestCheck(GetTimer(gear) == 0, 'bomb at %s,%s gone before its time', x, y) then
+		AddLandDisc(x, y, bombRadius, 0)
+		table.insert(craters, {x, y})
+	end
+end
@@ -0,0 +1,96 @@
+
+-- * hooks defined, replaced and removed while the game runs must be called
+--   (or not called) accordingly
+-- * globals set by the engine before each hook must be current, also after
+--   the script assigned them
+
+local nFails = 0
+
+local function fail(msg)
+	WriteLnToConsole("FAIL: " .. msg)
+	nFails = nFails + 1
+end
+
+function onGameInit()
+	Seed = 1
+	Map = "Ruler"
+	Theme = "Bamboo"
+	EnableGameFlags(gfOneClanMode, gfInvulnerable)
+	CaseFreq = 0
+	MinesNum = 0
+	Explosives = 0
+
+	AddTeam("O_o", 14483456, "Simple", "Island", "Default")
+	player = AddHog("o_O", 0, 1, "NoHat")
+	SetGearPosition(player, 100, 100)
+end
+
+local ticks = 0
+local ticks20 = 0
+local lastGameTime = nil
+local stage = 0
+local turnTimeSet = nil
+
+local function firstTick20()
+	ticks20 = ticks20 + 1
+end
+
+local function secondTick20()
+	ticks20 = ticks20 + 1000
+end
+
+function onGameStart()
+	-- defined at runtime, not when the script was loaded
+	onGameTick20 = firstTick20
+	_G.onGameTick = function()
+		ticks = ticks + 1
+
+		if lastGameTime ~= nil and GameTime <= lastGameTime then
+			fail("GameTime didn't advance: " .. GameTime)
+		end
+		lastGameTime = GameTime
+
+		if turnTimeSet ~= nil then
+			-- the value assigned by the script must have reached the engine
+			if TurnTimeLeft > turnTimeSet or TurnTimeLeft < turnTimeSet - 100 then
+				fail("TurnTimeLeft is " .. TurnTimeLeft .. ", expected about " .. turnTimeSet)
+			end
+			turnTimeSet = nil
+		end
+
+		if ticks == 100 then
+			turnTimeSet = 23456
+			TurnTimeLeft = turnTimeSet
+			-- the engine value must come back with the next hook
+			TotalRounds = -7
+		elseif ticks == 101 then
+			if TotalRounds == -7 then
+				fail("TotalRounds assigned by the script wasn't restored")
+			end
+		elseif ticks == 200 then
+			if ticks20 == 0 then
+				fail("onGameTick20 defined in onGameStart was never called")
+			end
+			onGameTick20 = secondTick20
+			stage = ticks20
+		elseif ticks == 400 then
+			if ticks20 - stage < 1000 then
+				fail("replaced onGameTick20 was never called")
+			end
+			onGameTick20 = nil
+			stage = ticks20
+		elseif ticks == 600 then
+			if ticks20 ~= stage then
+				fail("onGameTick20 was called after it was removed")
+			end
+			if onGameTick20 ~= nil then
+				fail("removed onGameTick20 is still visible to the script")
+			end
+			if nFails > 0 then
+				EndLuaTest(TEST_FAILED)
+			else
+				EndLuaTest(TEST_SUCCESSFUL)
+			end
+		end
+	end
+end
@@ -0,0 +1,161 @@
+/*
+ * Hedgewars, a free turn based strategy game
+ * Copyright (c) 2004-2014 Andrey Korotaev <unC0Rr@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/*
+ * Acts as the frontend of a preview worker engine and asks it for the same
+ * map twice on one connection. Both previews have the same land size, so
+ * the second one runs on land the engine has to allocate again after
+ * resetting. The replies must arrive and be identical.
+ *
+ * usage: same_size_twice <hwengine> <data dir>
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* alpha preview (256x128) followed by the hedgehogs limit */
+#define PREVIEW_REPLY_SIZE (128 * 256 + 1)
+
+static const char * request[] = {
+    "eseed {b2e5c4f0-preview-worker-test}",
+    "e$template_filter 0",
+    "e$mapgen 0",
+    "e$feature_size 12",
+    "!",
+    NULL
+};
+
+static int sendRequest(int sock)
+{
+    int i;
+
+    for (i = 0; request[i]; ++i)
+    {
+        unsigned char msg[256];
+        size_t len = strlen(request[i]);
+
+        msg[0] = (unsigned char)len;
+        memcpy(msg + 1, request[i], len);
+        if (send(sock, msg, len + 1, 0) != (ssize_t)(len + 1))
+            return -1;
+    }
+
+    return 0;
+}
+
+static int readReply(int sock, unsigned char * buf)
+{
+    size_t got = 0;
+
+    while (got < PREVIEW_REPLY_SIZE)
+    {
+        ssize_t n = recv(sock, buf + got, PREVIEW_REPLY_SIZE - got, 0);
+        if (n <= 0)
+            return -1;
+        got += n;
+    }
+
+    return 0;
+}
+
+int main(int argc, char ** argv)
+{
+    static unsigned char first[PREVIEW_REPLY_SIZE], second[PREVIEW_REPLY_SIZE];
+    struct sockaddr_in addr;
+    socklen_t addrlen = sizeof(addr);
+    char port[16];
+    int server, sock, status;
+    pid_t engine;
+
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s <hwengine> <data dir>\n", argv[0]);
+        return 2;
+    }
+
+    /* a hanging engine fails the test instead of blocking it */
+    alarm(120);
+
+    server = socket(AF_INET, SOCK_STREAM, 0);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (server < 0
+        || bind(server, (struct sockaddr *)&addr, sizeof(addr)) != 0
+        || listen(server, 1) != 0
+        || getsockname(server, (struct sockaddr *)&addr, &addrlen) != 0)
+    {
+        perror("listen");
+        return 1;
+    }
+    snprintf(port, sizeof(port), "%d", ntohs(addr.sin_port));
+
+    engine = fork();
+    if (engine == 0)
+    {
+        execl(argv[1], argv[1], "--internal", "--port", port, "--prefix", argv[2],
+              "--landpreview", "--preview-worker", (char *)NULL);
+        perror("exec");
+        _exit(1);
+    }
+
+    sock = accept(server, NULL, NULL);
+    if (sock < 0)
+    {
+        perror("accept");
+        return 1;
+    }
+
+    if (sendRequest(sock) != 0 || readReply(sock, first) != 0)
+    {
+        fprintf(stderr, "FAIL: no reply to the first preview request\n");
+        return 1;
+    }
+
+    if (sendRequest(sock) != 0 || readReply(sock, second) != 0)
+    {
+        fprintf(stderr, "FAIL: no reply to the second preview request\n");
+        return 1;
+    }
+
+    if (memcmp(first, second, PREVIEW_REPLY_SIZE) != 0)
+    {
+        fprintf(stderr, "FAIL: previews of the same map differ\n");
+        return 1;
+    }
+
+    /* the worker quits once the frontend goes away, as lost connection */
+    close(sock);
+    close(server);
+    if (waitpid(engine, &status, 0) != engine || WIFSIGNALED(status))
+    {
+        fprintf(stderr, "FAIL: engine crashed\n");
+        return 1;
+    }
+
+    printf("Got two identical previews from one worker\n");
+    return 0;
+}
@@ -0,0 +1,12 @@
+# -------------------------------------------------
+# Micro-benchmark for the frontend IPC receive buffer
+# -------------------------------------------------
+TARGET = ipcBufferBench
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+QT -= gui
+INCLUDEPATH += ../../QTfrontend/net
+SOURCES += main.cpp \
+    ../../QTfrontend/net/ipcbuffer.cpp
+HEADERS += ../../QTfrontend/net/ipcbuffer.h
@@ -0,0 +1,110 @@
+/*
+ * Feeds a synthetic engine message stream through IPCReadBuffer and through
+ * the old left()/remove() framing, and prints the time spent by each.
+ *
+ * usage: ipcBufferBench [megabytes] [chunk size]
+ */
+
+#include <QCoreApplication>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QTextStream>
+
+#include "ipcbuffer.h"
+
+static QByteArray makeStream(int bytes)
+{
+    QByteArray stream;
+    stream.reserve(bytes + 256);
+
+    quint32 seed = 1;
+    while (stream.size() < bytes)
+    {
+        // mix of short progress messages and longer engine messages
+        seed = seed * 1103515245 + 12345;
+        quint8 len = (seed >> 16) % 4 == 0 ? 3 : 1 + (seed >> 16) % 120;
+        stream.append(char(len));
+        stream.append('p');
+        stream.append(QByteArray(len - 1, 'x'));
+    }
+
+    return stream;
+}
+
+static qint64 runOffsetBuffer(const QByteArray & stream, int chunk, int & messages)
+{
+    QElapsedTimer timer;
+    IPCReadBuffer buffer;
+    QByteArray msg;
+    quint64 checksum = 0;
+
+    messages = 0;
+    timer.start();
+    for (int pos = 0; pos < stream.size(); pos += chunk)
+    {
+        buffer.append(QByteArray::fromRawData(stream.constData() + pos, qMin(chunk, stream.size() - pos)));
+        while (buffer.takeMessage(msg))
+        {
+            checksum += quint8(msg.at(1));
+            ++messages;
+        }
+    }
+
+    return checksum ? timer.elapsed() : -1;
+}
+
+static qint64 runLegacyBuffer(const QByteArray & stream, int chunk, int & messages)
+{
+    QElapsedTimer timer;
+    QByteArray readbuffer;
+    quint64 checksum = 0;
+
+    messages = 0;
+    timer.start();
+    for (int pos = 0; pos < stream.size(); pos += chunk)
+    {
+        readbuffer.append(stream.constData() + pos, qMin(chunk, stream.size() - pos));
+
+        quint8 msglen;
+        quint32 bufsize;
+        while (!readbuffer.isEmpty() && ((bufsize = readbuffer.size()) > 0) &&
+                ((msglen = readbuffer.data()[0]) < bufsize))
+        {
+            QByteArray msg = readbuffer.left(msglen + 1);
+            readbuffer.remove(0, msglen + 1);
+            checksum += quint8(msg.at(1));
+            ++messages;
+        }
+    }
+
+    return checksum ? timer.elapsed() : -1;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QStringList args = app.arguments();
+    QTextStream out(stdout);
+
+    int megabytes = args.size() > 1 ? args[1].toInt() : 50;
+    int chunk = args.size() > 2 ? args[2].toInt() : 65536;
+    if (megabytes <= 0 || chunk <= 0)
+    {
+        out << "usage: ipcBufferBench [megabytes] [chunk size]\n";
+        return 1;
+    }
+
+    QByteArray stream = makeStream(megabytes * 1024 * 1024);
+    out << "stream: " << stream.size() << " bytes, read chunk " << chunk << " bytes\n";
+
+    int messages;
+    qint64 ms = runOffsetBuffer(stream, chunk, messages);
+    out << "IPCReadBuffer:  " << messages << " messages in " << ms << " ms\n";
+    out.flush();
+
+    ms = runLegacyBuffer(stream, chunk, messages);
+    out << "left()/remove(): " << messages << " messages in " << ms << " ms\n";
+
+    return 0;
+}